@@ -0,0 +1,74 @@
+#ifndef ROGUE_AUTO_SAVER_H
+#define ROGUE_AUTO_SAVER_H
+
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <rogue/GameConfig.h>
+#include <rogue/SaveGame.h>
+#include <string>
+#include <thread>
+
+namespace rogue {
+
+/// Writes save games on a background thread. The game thread only captures
+/// the state to save, serializing and writing it happens on the worker. Save
+/// games are replaced atomically, see `writeSaveGameAtomically`. Only the
+/// latest pending save is kept, older ones would be overwritten anyway.
+class AutoSaver {
+public:
+  using WriteFn = std::function<void(const SaveGameInfo &SGI)>;
+
+public:
+  AutoSaver(SaveGameInfo SGI, const AutoSaveConfig &Cfg);
+  AutoSaver(const AutoSaver &) = delete;
+  AutoSaver &operator=(const AutoSaver &) = delete;
+
+  /// Finishes writing the pending save game
+  ~AutoSaver();
+
+  const SaveGameInfo &getSaveGameInfo() const { return SGI; }
+  const AutoSaveConfig &getConfig() const { return Cfg; }
+
+  /// Counts a game tick, a save is due once the configured number of ticks
+  /// passed since the last save
+  void tick();
+
+  /// Marks a save as due if configured to save on level changes
+  void levelChanged();
+
+  /// Returns true if a save is due
+  bool isDue() const { return Due; }
+
+  /// Schedules \p Write for writing the save game, replaces a pending save
+  /// that was not started yet
+  void submit(WriteFn Write);
+
+  /// Blocks until all submitted save games are written
+  void wait();
+
+  /// Returns the error of the last failed save, if any, and clears it
+  std::optional<std::string> takeError();
+
+private:
+  void run();
+
+private:
+  SaveGameInfo SGI;
+  AutoSaveConfig Cfg;
+  unsigned TicksSinceSave = 0;
+  bool Due = false;
+
+  std::mutex Mutex;
+  std::condition_variable CV;
+  WriteFn Pending = nullptr;
+  bool Busy = false;
+  bool Stop = false;
+  std::optional<std::string> Error;
+  std::thread Worker;
+};
+
+} // namespace rogue
+
+#endif // #ifndef ROGUE_AUTO_SAVER_H
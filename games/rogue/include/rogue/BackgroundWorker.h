@@ -0,0 +1,64 @@
+#ifndef ROGUE_BACKGROUND_WORKER_H
+#define ROGUE_BACKGROUND_WORKER_H
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+namespace rogue {
+
+/// Runs jobs one after another on a worker thread, the worker is started on
+/// the first job. Used for work the game thread must not wait for, like
+/// preparing worlds or destroying ones that still generate levels.
+class BackgroundWorker {
+public:
+  using JobFn = std::function<void()>;
+
+public:
+  BackgroundWorker() = default;
+  BackgroundWorker(const BackgroundWorker &) = delete;
+  BackgroundWorker &operator=(const BackgroundWorker &) = delete;
+
+  /// Waits for the running job, pending jobs are dropped
+  ~BackgroundWorker();
+
+  /// Schedules \p Job to run after all previously scheduled jobs
+  void post(JobFn Job);
+
+  /// Schedules \p Fn, its result or error is available through the returned
+  /// future
+  template <typename ResultType>
+  std::future<ResultType> submit(std::function<ResultType()> Fn) {
+    auto Task =
+        std::make_shared<std::packaged_task<ResultType()>>(std::move(Fn));
+    auto Future = Task->get_future();
+    post([Task]() { (*Task)(); });
+    return Future;
+  }
+
+  /// Destroys \p Obj on the worker once all previously scheduled jobs are
+  /// done, e.g. a future of a submitted job that is no longer needed
+  template <typename T> void dispose(T Obj) {
+    post([Holder = std::make_shared<T>(std::move(Obj))]() mutable {
+      Holder.reset();
+    });
+  }
+
+private:
+  void run();
+
+private:
+  std::mutex Mutex;
+  std::condition_variable CV;
+  std::deque<JobFn> Jobs;
+  bool Stop = false;
+  std::thread Worker;
+};
+
+} // namespace rogue
+
+#endif // #ifndef ROGUE_BACKGROUND_WORKER_H
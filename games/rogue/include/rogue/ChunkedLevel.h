@@ -0,0 +1,162 @@
+#ifndef ROGUE_CHUNKED_LEVEL_H
+#define ROGUE_CHUNKED_LEVEL_H
+
+#include <map>
+#include <memory>
+#include <optional>
+#include <rogue/Tile.h>
+#include <string>
+#include <ymir/Map.hpp>
+#include <ymir/Types.hpp>
+
+namespace rogue {
+struct GameContext;
+class Level;
+} // namespace rogue
+
+namespace rogue::serialize {
+class LevelBaseline;
+} // namespace rogue::serialize
+
+namespace rogue {
+
+/// Generates the chunks of a `ChunkedLevel`. Generation has to be
+/// deterministic as evicted chunks are regenerated when visited again.
+class ChunkGenerator {
+public:
+  virtual ~ChunkGenerator() = default;
+
+  /// Generates the chunk covering \p ChunkRect in world coordinates, the
+  /// returned level has the size of the chunk
+  virtual std::shared_ptr<Level>
+  generateChunk(ymir::Rect2d<int> ChunkRect) const = 0;
+};
+
+/// Generates overworld terrain from layered simplex noise
+class NoiseChunkGenerator : public ChunkGenerator {
+public:
+  struct Config {
+    int Seed = 0;
+    float Scale = 128.0f;
+    int Octaves = 6;
+    float Persistence = 0.5f;
+    float Lacunarity = 2.0f;
+  };
+
+public:
+  NoiseChunkGenerator(const GameContext &Ctx, const Config &Cfg);
+
+  /// Returns the height of the terrain at the world position in [-1, 1]
+  float getHeight(ymir::Point2d<int> Pos) const;
+
+  std::shared_ptr<Level>
+  generateChunk(ymir::Rect2d<int> ChunkRect) const final;
+
+private:
+  const GameContext &Ctx;
+  Config Cfg;
+};
+
+/// Open world level that is split into equally sized chunks. Chunks around a
+/// focus position, usually the player, are generated on demand and chunks far
+/// away are evicted into compact snapshots, so memory and the work per update
+/// stay bounded independent of the size of the world. Each chunk is a `Level`
+/// of its own, entities are bucketed into the registry of their chunk.
+class ChunkedLevel {
+public:
+  struct Config {
+    /// Size of a chunk in tiles
+    ymir::Size2d<int> ChunkSize = {64, 64};
+
+    /// Chunks within this distance of the focus chunk are loaded, in chunks
+    int LoadRadius = 1;
+
+    /// Chunks beyond this distance of the focus chunk are evicted, in chunks
+    int EvictRadius = 2;
+
+    /// Maximum number of chunks generated and evicted by a single update, the
+    /// chunk containing the focus position is always loaded
+    std::size_t MaxChunksPerUpdate = 2;
+
+    /// Maximum number of evicted chunks whose changes are kept, the changes of
+    /// the chunks farthest from the focus are dropped beyond that and those
+    /// chunks are generated anew when visited again
+    std::size_t MaxEvictedChunks = 1024;
+  };
+
+  struct MemoryStats {
+    std::size_t NumResident = 0;
+    std::size_t NumEvicted = 0;
+    std::size_t ResidentBytes = 0;
+    std::size_t EvictedBytes = 0;
+  };
+
+public:
+  /// \throws std::out_of_range if the configuration is invalid
+  ChunkedLevel(const ChunkGenerator &Gen, const Config &Cfg);
+  ~ChunkedLevel();
+
+  const Config &getConfig() const { return Cfg; }
+
+  /// Returns the coordinate of the chunk containing the world position
+  ymir::Point2d<int> getChunkCoord(ymir::Point2d<int> Pos) const;
+
+  /// Returns the area covered by the chunk in world coordinates
+  ymir::Rect2d<int> getChunkRect(ymir::Point2d<int> ChunkCoord) const;
+
+  /// Loads the chunks around \p FocusPos and evicts far away chunks
+  /// \return True if all chunks within the load radius are resident
+  bool update(ymir::Point2d<int> FocusPos);
+
+  /// Returns the chunk if it is resident, nullptr otherwise
+  Level *getChunk(ymir::Point2d<int> ChunkCoord);
+  const Level *getChunk(ymir::Point2d<int> ChunkCoord) const;
+
+  /// Returns the chunk containing the world position, loads it if required
+  Level &getChunkAt(ymir::Point2d<int> Pos);
+
+  /// Creates the player at the world position
+  void createPlayer(ymir::Point2d<int> Pos);
+
+  /// Moves the player to the world position, the player is transferred to
+  /// the chunk containing it
+  /// \throws std::runtime_error if there is no player
+  void movePlayer(ymir::Point2d<int> Pos);
+
+  /// Returns the world position of the player, if any
+  std::optional<ymir::Point2d<int>> getPlayerPos() const;
+
+  /// Renders the resident chunks within \p VisibleRect
+  ymir::Map<Tile> render(ymir::Rect2d<int> VisibleRect) const;
+
+  /// Returns the memory accounting of resident and evicted chunks
+  MemoryStats getMemoryStats() const;
+
+private:
+  struct ResidentChunk {
+    std::shared_ptr<Level> Lvl;
+    std::shared_ptr<const serialize::LevelBaseline> Baseline;
+  };
+
+  Level &loadChunk(ymir::Point2d<int> ChunkCoord);
+  void evictChunk(ymir::Point2d<int> ChunkCoord);
+  void dropEvictedChunks(ymir::Point2d<int> FocusChunk);
+
+  int getChunkDistance(ymir::Point2d<int> A, ymir::Point2d<int> B) const;
+
+private:
+  const ChunkGenerator &Gen;
+  Config Cfg;
+  std::map<ymir::Point2d<int>, ResidentChunk> Resident;
+
+  /// Snapshots of evicted chunks that changed since they were generated,
+  /// unchanged chunks are simply regenerated. Bounded by the maximum number of
+  /// evicted chunks.
+  std::map<ymir::Point2d<int>, std::string> Evicted;
+
+  std::optional<ymir::Point2d<int>> PlayerChunk;
+};
+
+} // namespace rogue
+
+#endif // #ifndef ROGUE_CHUNKED_LEVEL_H
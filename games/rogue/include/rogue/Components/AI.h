@@ -51,7 +51,11 @@ struct EffectExecutorComp {
 
   std::vector<Info> Effects;
   std::size_t NextEffect = 0;
-  unsigned DelayLeft = 0;
+
+  /// Ticks to wait before executing the first effect, the delays after each
+  /// effect are drawn from its delay distribution. This is configuration,
+  /// the pending delay is only known to the attack AI system.
+  unsigned FirstDelay = 0;
 };
 
 enum class NeedKind {
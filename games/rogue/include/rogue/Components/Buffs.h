@@ -267,9 +267,10 @@ public:
 
   static void applyTo(const BuffType &Buff, const entt::entity &SrcEt,
                       const entt::entity &DstEt, entt::registry &Reg) {
-    auto ExistingBuff = Reg.try_get<BuffType>(DstEt);
-    if (ExistingBuff) {
-      ExistingBuff->add(Buff);
+    // Existing buffs are patched to notify systems observing the buff
+    if (Reg.all_of<BuffType>(DstEt)) {
+      Reg.patch<BuffType>(DstEt,
+                          [&Buff](auto &Existing) { Existing.add(Buff); });
     } else {
       Reg.emplace<BuffType>(DstEt, Buff);
     }
@@ -294,6 +295,8 @@ public:
     if (ExistingBuff) {
       if (ExistingBuff->remove(Buff)) {
         Reg.erase<BuffType>(DstEt);
+      } else {
+        Reg.patch<BuffType>(DstEt);
       }
     }
     if constexpr (IsCombat) {
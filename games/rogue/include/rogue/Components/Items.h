@@ -17,6 +17,10 @@ struct InventoryComp {
   Inventory Inv;
 };
 
+/// Marks entities created by `createDropEntity`, they are fully described by
+/// their position and inventory
+struct DropComp {};
+
 struct LootInteractComp {
   bool IsLooted = false;
   bool IsPersistent = true;
@@ -16,6 +16,11 @@ struct LevelEndComp {
   int NextLevelId = -1;
 };
 
+/// Marks an entity through which a sub-world can be entered
+struct WorldEntryComp {
+  std::string LevelName;
+};
+
 struct DoorComp {
   static bool unlockDoor(entt::registry &Reg, const entt::entity &DoorEt,
                          const entt::entity &ActEt);
@@ -89,8 +89,13 @@ struct ValueRegenCompBase {
   StatValue Value = std::numeric_limits<StatValue>::max();
   StatValue MaxValue = 100;
 
+  /// Ticks between regenerations, zero regenerates only once
   unsigned TickPeriod = 4;
-  unsigned TicksLeft = 1;
+
+  /// Ticks until the first regeneration once the component is added, the
+  /// following ones are scheduled every tick period by the regen system.
+  /// This is configuration, the pending delay is only known to the system.
+  unsigned FirstTickDelay = 1;
   StatValue RegenAmount = 0.05;
 
   bool hasAmount(StatValue Value);
@@ -3,6 +3,7 @@
 
 #include <optional>
 #include <rogue/CraftingDatabase.h>
+#include <rogue/CraftingRecipeIndex.h>
 #include <rogue/Item.h>
 #include <vector>
 
@@ -12,45 +13,6 @@ class ItemDatabase;
 
 namespace rogue {
 
-/// Crafting recipes are stored in a tree-like structure. Each node stores a
-/// mapping of item Id that is required to craft the results defined in
-/// subsequent nodes.
-///
-/// For example:
-///
-///   {Root}
-///    |
-///    +-- Wood -> {Node 1}
-///    |           |
-///    |           +-- Iron  -> {Node 2}
-///    |           |            +-{Results: Iron Axe}
-///    |           |
-///    |           +-- Stone -> {Node 3}
-///    |                         +-{Results: Stone axe}
-///    +-- Iron -> {Node 4}      |
-///                |             +- Rune Stone -> {Node 5}
-///                |                              +-{Results: Rune Axe}
-///                |
-///                +-- Stone -> {Node 6}
-///                              +-{Results: Flint and Steel}
-struct CraftingNode {
-  struct CraftingResult {
-    CraftingRecipeId RecipeId;
-    std::vector<ItemProtoId> Items;
-  };
-
-  /// Each node may define a result, which is a list of items that are crafted
-  /// when the node is reached
-  std::optional<CraftingResult> Result;
-
-  /// Children of the nodes, key is the item Id required to continue to child
-  /// node.
-  std::map<ItemProtoId, CraftingNode> Children;
-
-  const std::optional<CraftingResult> &
-  search(const std::vector<Item> &Items) const;
-};
-
 class CraftingHandler {
 public:
   CraftingHandler() = default;
@@ -60,9 +22,16 @@ public:
   const ItemDatabase *getItemDb() const;
   const ItemDatabase &getItemDbOrFail() const;
 
-  const std::optional<CraftingNode::CraftingResult> &
+  /// Returns the recipe requiring exactly the items in the given order, or
+  /// nullptr if the items are not a recipe
+  const CraftingResult *
   getCraftingRecipeResultOrNone(const std::vector<Item> &Items) const;
 
+  /// Returns the ids of all recipes that can be crafted from the given item
+  /// counts independent of the order of the items, sorted by id
+  std::vector<CraftingRecipeId>
+  getCraftableRecipes(const CraftingRecipeIndex::ItemCounts &Counts) const;
+
   std::optional<std::vector<Item>>
   tryCraft(const std::vector<Item> &Items) const;
 
@@ -72,7 +41,7 @@ public:
 
 private:
   const ItemDatabase *ItemDb = nullptr;
-  CraftingNode Tree;
+  CraftingRecipeIndex Recipes;
 };
 
 } // namespace rogue
@@ -0,0 +1,111 @@
+#ifndef ROGUE_CRAFTING_RECIPE_INDEX_H
+#define ROGUE_CRAFTING_RECIPE_INDEX_H
+
+#include <cstddef>
+#include <cstdint>
+#include <rogue/Types.h>
+#include <unordered_map>
+#include <vector>
+
+namespace rogue {
+class CraftingRecipe;
+}
+
+namespace rogue {
+
+struct CraftingResult {
+  CraftingRecipeId RecipeId;
+  std::vector<ItemProtoId> Items;
+};
+
+/// Index of crafting recipes by their required items. Recipes are stored in
+/// two prefix trees, one keyed by the required items in recipe order and one
+/// keyed by the required items sorted by id. The latter treats the required
+/// items as a multiset, so recipes can be looked up independent of the order
+/// of the items.
+///
+/// For example:
+///
+///   {Root}
+///    |
+///    +-- Wood -> {Node 1}
+///    |           |
+///    |           +-- Iron  -> {Node 2}
+///    |           |            +-{Results: Iron Axe}
+///    |           |
+///    |           +-- Stone -> {Node 3}
+///    |                         +-{Results: Stone axe}
+///    +-- Iron -> {Node 4}      |
+///                |             +- Rune Stone -> {Node 5}
+///                |                              +-{Results: Rune Axe}
+///                |
+///                +-- Stone -> {Node 6}
+///                              +-{Results: Flint and Steel}
+///
+/// Nodes are stored in flat arrays, the children of a node are linked as
+/// siblings ordered by item id.
+class CraftingRecipeIndex {
+public:
+  /// Summed count per item id, e.g. of all items in an inventory
+  using ItemCounts = std::unordered_map<int, unsigned>;
+
+public:
+  /// \throws std::runtime_error if the recipe is empty or a recipe requiring
+  /// the same items in the same order was already added
+  void addRecipe(CraftingRecipeId RecipeId, const CraftingRecipe &Recipe);
+
+  /// Returns the recipe requiring exactly the items in the given order, or
+  /// nullptr if there is none. The result is valid until a recipe is added.
+  const CraftingResult *findRecipe(const std::vector<ItemProtoId> &Items) const;
+
+  /// Returns the ids of all recipes requiring exactly the given items in any
+  /// order, sorted by id
+  std::vector<CraftingRecipeId>
+  findRecipesAnyOrder(std::vector<ItemProtoId> Items) const;
+
+  /// Returns the ids of all recipes that can be crafted from the given item
+  /// counts, sorted by id. Only branches of the index requiring available
+  /// items are visited.
+  std::vector<CraftingRecipeId>
+  getCraftableRecipes(const ItemCounts &Counts) const;
+
+  std::size_t size() const { return Results.size(); }
+  bool empty() const { return Results.empty(); }
+
+private:
+  static constexpr std::uint32_t None = ~std::uint32_t(0);
+
+  struct Node {
+    ItemProtoId ItemId;
+    std::uint32_t FirstChild = None;
+    std::uint32_t NextSibling = None;
+
+    /// Result index for the ordered tree, head of the linked recipes for the
+    /// sorted tree
+    std::uint32_t Recipe = None;
+  };
+
+  /// Recipes requiring the same items in a different order end at the same
+  /// node of the sorted tree
+  struct RecipeLink {
+    std::uint32_t Result;
+    std::uint32_t Next;
+  };
+
+  static std::uint32_t findNode(const std::vector<Node> &Nodes,
+                                const std::vector<ItemProtoId> &Items);
+  static std::uint32_t getOrAddNode(std::vector<Node> &Nodes,
+                                    const std::vector<ItemProtoId> &Items);
+  std::vector<CraftingRecipeId> getLinkedRecipes(std::uint32_t Link) const;
+
+private:
+  /// The first node is the root of the tree
+  std::vector<Node> OrderedNodes = {Node{}};
+  std::vector<Node> SortedNodes = {Node{}};
+  std::vector<RecipeLink> SortedLinks;
+  std::vector<CraftingResult> Results;
+};
+
+} // namespace rogue
+
+#endif // #ifndef ROGUE_CRAFTING_RECIPE_INDEX_H
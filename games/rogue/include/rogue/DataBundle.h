@@ -0,0 +1,112 @@
+#ifndef ROGUE_DATA_BUNDLE_H
+#define ROGUE_DATA_BUNDLE_H
+
+#include <cstdint>
+#include <filesystem>
+#include <map>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+
+namespace rogue {
+
+/// Precompiled bundle of validated game data files. The bundle is created
+/// offline by the data compiler and stores the compacted contents of all JSON
+/// files required by the game keyed by their path relative to the bundle root.
+/// If a bundle is active, `loadJSON` serves files from the bundle instead of
+/// reading them from disk and skips the schema validation, which was done by
+/// the data compiler. The size and last write time of each source file and its
+/// schema are recorded, a file that changed on disk since the bundle was
+/// compiled is loaded and validated from disk instead.
+///
+/// File layout (host byte order):
+///   header:  magic u32, version u32, number of entries u32, reserved u32
+///   entries: name length u32, name, data offset u64, data size u64,
+///            file size u64, file write time i64,
+///            schema name length u32, schema name,
+///            schema size u64, schema write time i64
+///   data:    concatenated file contents, offsets are relative to its start
+class DataBundle {
+public:
+  static constexpr std::uint32_t Magic = 0x42474f52; // "ROGB"
+  static constexpr std::uint32_t Version = 2;
+
+  /// Name of the bundle file placed next to the game configuration
+  static constexpr const char *DefaultFileName = "game_data.bundle";
+
+  /// Size and last write time of a file
+  struct FileStamp {
+    std::uint64_t Size = 0;
+    std::int64_t WriteTime = 0;
+
+    bool operator==(const FileStamp &Other) const {
+      return Size == Other.Size && WriteTime == Other.WriteTime;
+    }
+    bool operator!=(const FileStamp &Other) const { return !(*this == Other); }
+  };
+
+  /// Returns the stamp of the file or nothing if the file does not exist
+  static std::optional<FileStamp>
+  getFileStamp(const std::filesystem::path &File);
+
+  /// Reads the bundle from the given file, the directory containing the file
+  /// is used as root for resolving paths
+  static DataBundle read(const std::filesystem::path &BundleFile);
+
+  /// Sets the bundle used by `loadJSON`, nullptr disables the lookup
+  static void setActive(std::shared_ptr<const DataBundle> Bundle);
+  static std::shared_ptr<const DataBundle> getActive();
+
+public:
+  explicit DataBundle(const std::filesystem::path &RootDir);
+
+  const std::filesystem::path &getRootDir() const { return RootDir; }
+  std::size_t size() const { return Entries.size(); }
+
+  /// Adds the data for the given file that was validated against the schema
+  /// if given, replaces existing data for the file. The stamps of the file
+  /// and the schema are taken from disk.
+  /// \throws std::runtime_error if the file or schema does not exist
+  void add(const std::filesystem::path &File, std::string_view Data,
+           const std::filesystem::path *SchemaPath = nullptr);
+
+  /// Returns the data of the file or nothing if not contained in the bundle,
+  /// the returned view is valid for the lifetime of the bundle
+  std::optional<std::string_view>
+  getOrNull(const std::filesystem::path &File) const;
+
+  /// Returns the data of the file only if the file and the schema, if given,
+  /// are unchanged on disk since they were added and the data was validated
+  /// against the same schema. Returns nothing otherwise in which case the file
+  /// needs to be loaded from disk.
+  std::optional<std::string_view>
+  getIfCurrent(const std::filesystem::path &File,
+               const std::filesystem::path *SchemaPath) const;
+
+  /// Writes the bundle to the given file
+  void write(const std::filesystem::path &BundleFile) const;
+
+private:
+  struct Entry {
+    std::uint64_t Offset = 0;
+    std::uint64_t Size = 0;
+    FileStamp Source;
+
+    /// Key of the schema the data was validated against, empty if none
+    std::string SchemaKey;
+    FileStamp Schema;
+  };
+
+  /// Returns the key of the file relative to the root directory
+  std::string getKey(const std::filesystem::path &File) const;
+
+private:
+  std::filesystem::path RootDir;
+  std::map<std::string, Entry, std::less<>> Entries;
+  std::string Data;
+};
+
+} // namespace rogue
+
+#endif // #ifndef ROGUE_DATA_BUNDLE_H
@@ -1,11 +1,14 @@
 #ifndef ROGUE_EFFECT_INFO_H
 #define ROGUE_EFFECT_INFO_H
 
+#include <array>
+#include <cstdint>
 #include <entt/entt.hpp>
 #include <iosfwd>
 #include <memory>
 #include <rogue/ItemType.h>
 #include <rogue/Types.h>
+#include <vector>
 
 namespace rogue {
 class ItemEffect;
@@ -72,6 +75,46 @@ struct EffectInfo {
 
 std::ostream &operator<<(std::ostream &OS, const EffectInfo &Info);
 
+/// Index over a list of effects for constant time capability queries. Each
+/// effect is represented by one bit in the masks, hence the number of effects
+/// is limited.
+class EffectIndex {
+public:
+  using MaskType = std::uint64_t;
+  static constexpr std::size_t MaxEffects = 64;
+
+public:
+  EffectIndex() = default;
+
+  /// \throws std::out_of_range if there are more than `MaxEffects` effects
+  explicit EffectIndex(const std::vector<EffectInfo> &Effects);
+
+  /// Returns the combined capability flags of all effects
+  CapabilityFlags getCapabilityFlags() const { return AllFlags; }
+
+  /// Returns the mask of effects that have all of \p Flags set, bit N is set
+  /// for the N-th effect
+  MaskType getEffectMask(CapabilityFlags Flags) const;
+
+  /// Returns true if an effect has all of \p Flags set
+  /// \param AllowNull If false null effects are ignored
+  /// \param AllowRemove If false remove effects are ignored
+  bool hasEffect(CapabilityFlags Flags, bool AllowNull = false,
+                 bool AllowRemove = false) const;
+
+private:
+  /// Number of distinct capability flags
+  static constexpr std::size_t NumFlags = 8;
+
+  CapabilityFlags AllFlags = CapabilityFlags::None;
+  MaskType AllEffects = 0;
+  MaskType NullEffects = 0;
+  MaskType RemoveEffects = 0;
+
+  /// Mask of effects per capability flag
+  std::array<MaskType, NumFlags> FlagEffects = {};
+};
+
 } // namespace rogue
 
 #endif // #ifndef ROGUE_EFFECT_INFO_H
\ No newline at end of file
@@ -23,6 +23,14 @@ public:
   void assemble(entt::registry &Reg, entt::entity Entity) const override {
     Reg.emplace<T>(Entity);
   }
+  void reserve(entt::registry &Reg, std::size_t Count) const override {
+    auto &Storage = Reg.storage<T>();
+    Storage.reserve(Storage.size() + Count);
+  }
+  void assembleBatch(entt::registry &Reg, const entt::entity *Entities,
+                     std::size_t Count) const override {
+    Reg.insert<T>(Entities, Entities + Count);
+  }
   bool isPostProcess() const override { return IsPostProcess; }
 };
 
@@ -8,6 +8,7 @@
 #include <optional>
 #include <string>
 #include <vector>
+#include <ymir/Types.hpp>
 
 namespace rogue {
 class ItemDatabase;
@@ -26,6 +27,14 @@ public:
   virtual ~EntityAssembler() = default;
   virtual bool isPostProcess() const { return false; }
   virtual void assemble(entt::registry &Reg, entt::entity Entity) const = 0;
+
+  /// Reserves storage for \p Count additional entities, called before
+  /// assembling a batch of entities
+  virtual void reserve(entt::registry &Reg, std::size_t Count) const;
+
+  /// Assembles a batch of entities, defaults to assembling each entity
+  virtual void assembleBatch(entt::registry &Reg, const entt::entity *Entities,
+                             std::size_t Count) const;
 };
 
 struct EntityTemplateInfo {
@@ -77,6 +86,16 @@ struct EntityTemplateInfo {
   }
 };
 
+/// Entity template compiled for creating entities, holds the assemblers in the
+/// order in which they need to run
+struct EntityPrototype {
+  std::string DisplayName;
+  std::string Description;
+  std::vector<std::shared_ptr<EntityAssembler>> Assemblers;
+
+  static EntityPrototype compile(const EntityTemplateInfo &Info);
+};
+
 class EntityAssemblerCache {
 public:
   void add(const std::string &Name,
@@ -113,12 +132,19 @@ public:
   EntityTemplateInfo &getEntityTemplate(EntityTemplateId Id);
   const EntityTemplateInfo &getEntityTemplate(EntityTemplateId Id) const;
 
+  /// Returns the prototype compiled when the template was added, changes to
+  /// the assemblers of the template afterwards are not reflected
+  const EntityPrototype &getPrototype(EntityTemplateId Id) const;
+
 private:
   /// Map entity name to it's Id
   std::map<std::string, EntityTemplateId> EntityTemplateIdsByName;
 
   /// Map entity template by it's Id
   std::vector<EntityTemplateInfo> EntityTemplateInfos;
+
+  /// Compiled entity templates by Id
+  std::vector<EntityPrototype> Prototypes;
 };
 
 class EntityFactory {
@@ -128,6 +154,17 @@ public:
   entt::registry &getRegistry();
   entt::entity createEntity(EntityTemplateId Id) const;
 
+  /// Creates \p Count entities of the same template, storage for the
+  /// components is reserved once and components are assembled per batch
+  std::vector<entt::entity> createEntities(EntityTemplateId Id,
+                                           std::size_t Count) const;
+
+  /// Creates an entity of the template for each position, the position is set
+  /// for entities that have a position component
+  std::vector<entt::entity>
+  createEntities(EntityTemplateId Id,
+                 const std::vector<ymir::Point2d<int>> &Positions) const;
+
 private:
   entt::registry &Reg;
   const EntityDatabase &EntityDb;
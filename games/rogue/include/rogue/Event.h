@@ -16,9 +16,16 @@ namespace rogue {
 // Base class for all events
 struct BaseEvent {
   // virtual ~BaseEvent() = default;
+
+  /// If true the event is always dispatched when published, otherwise it may
+  /// be deferred until the end of the tick if the event hub has queuing
+  /// enabled. Events referencing state that may not outlive the publishing
+  /// call (e.g. entities about to be destroyed) need to be immediate.
+  static constexpr bool Immediate = false;
 };
 
 template <typename DerivedT> struct BaseMessageEvent : public BaseEvent {
+  static constexpr bool Immediate = true;
   std::stringstream Message;
 
   template <typename Type> DerivedT &operator<<(const Type &T) {
@@ -34,6 +41,8 @@ struct PlayerInfoMessageEvent
     : public BaseMessageEvent<PlayerInfoMessageEvent> {};
 
 struct EntityAttackEvent : public BaseEvent {
+  static constexpr bool Immediate = true;
+
   entt::entity Attacker = entt::null;
   entt::entity Target = entt::null;
   entt::registry *Registry = nullptr;
@@ -45,6 +54,8 @@ struct EntityAttackEvent : public BaseEvent {
 };
 
 struct EntityDiedEvent : public BaseEvent {
+  static constexpr bool Immediate = true;
+
   entt::entity Entity = entt::null;
   entt::registry *Registry = nullptr;
   bool isPlayerAffected() const;
@@ -57,6 +68,8 @@ inline bool operator==(const EntityDiedEvent &Lhs, const EntityDiedEvent &Rhs) {
 struct EffectDelayEvent : public BaseEvent {};
 
 struct BuffAppliedEvent : public BaseEvent {
+  static constexpr bool Immediate = true;
+
   entt::entity SrcEt = entt::null;
   entt::entity TargetEt = entt::null;
   entt::registry *Registry = nullptr;
@@ -67,6 +80,8 @@ struct BuffAppliedEvent : public BaseEvent {
 };
 
 struct BuffApplyEffectEvent : public BaseEvent {
+  static constexpr bool Immediate = true;
+
   entt::entity Entity = entt::null;
   entt::registry *Registry = nullptr;
   bool IsReduce = false;
@@ -84,6 +99,8 @@ struct RestoreHealthEvent : public BaseEvent {
 };
 
 struct BuffExpiredEvent : public BaseEvent {
+  static constexpr bool Immediate = true;
+
   entt::entity Entity = entt::null;
   entt::registry *Registry = nullptr;
   const BuffBase *Buff = nullptr;
@@ -97,6 +114,8 @@ struct SpawnEntityEvent : public BaseEvent {
 };
 
 struct SwitchLevelEvent : public BaseEvent {
+  static constexpr bool Immediate = true;
+
   int Level = 0;
   bool ToEntry = false;
   entt::entity TriggerEt = entt::null;
@@ -104,12 +123,16 @@ struct SwitchLevelEvent : public BaseEvent {
 };
 
 struct SwitchGameWorldEvent : public BaseEvent {
+  static constexpr bool Immediate = true;
+
   std::string LevelName;
   entt::entity TriggerEt = entt::null;
   entt::entity SwitchEt = entt::null;
 };
 
 struct LootEvent : public BaseEvent {
+  static constexpr bool Immediate = true;
+
   std::string LootName;
   entt::entity Entity = entt::null;
   entt::entity LootedEntity = entt::null;
@@ -119,6 +142,8 @@ struct LootEvent : public BaseEvent {
 };
 
 struct CraftEvent : public BaseEvent {
+  static constexpr bool Immediate = true;
+
   entt::entity Entity = entt::null;
   entt::registry *Registry = nullptr;
 
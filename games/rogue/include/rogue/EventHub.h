@@ -3,7 +3,9 @@
 
 #include <functional>
 #include <map>
+#include <memory>
 #include <typeindex>
+#include <vector>
 
 namespace rogue {
 struct BaseEvent;
@@ -11,18 +13,73 @@ struct BaseEvent;
 
 namespace rogue {
 
+/// Contiguous, read-only range of events of a single type
+template <typename EventType> class EventBatch {
+public:
+  EventBatch(const EventType *First, std::size_t Count)
+      : First(First), Count(Count) {}
+
+  const EventType *begin() const { return First; }
+  const EventType *end() const { return First + Count; }
+  std::size_t size() const { return Count; }
+  bool empty() const { return Count == 0; }
+  const EventType &operator[](std::size_t Idx) const { return First[Idx]; }
+
+private:
+  const EventType *First = nullptr;
+  std::size_t Count = 0;
+};
+
 class EventHub {
 public:
-  using HandlerType = std::function<void(const BaseEvent &)>;
+  /// Handlers are invoked with a contiguous batch of events of one type
+  using HandlerType = std::function<void(const void *Events, std::size_t)>;
   using HandlerMap = std::map<void *, HandlerType>;
 
+  /// While alive, deferrable events published to a hub with queuing enabled
+  /// are collected and dispatched in bulk once the outermost scope ends.
+  class QueueScope {
+  public:
+    explicit QueueScope(EventHub *Hub) : Hub(Hub) {
+      if (Hub) {
+        Hub->QueueDepth++;
+      }
+    }
+    QueueScope(const QueueScope &) = delete;
+    QueueScope &operator=(const QueueScope &) = delete;
+    ~QueueScope() {
+      if (Hub && --Hub->QueueDepth == 0) {
+        Hub->flush();
+      }
+    }
+
+  private:
+    EventHub *Hub = nullptr;
+  };
+
 public:
   template <class SubscriberType, typename EventType>
   void subscribe(SubscriberType &Subscriber,
                  void (SubscriberType::*CallbackFunc)(const EventType &)) {
     Subscribers[typeid(EventType)][&Subscriber] =
-        [&Subscriber, CallbackFunc](const BaseEvent &E) {
-          (Subscriber.*CallbackFunc)(static_cast<const EventType &>(E));
+        [&Subscriber, CallbackFunc](const void *Events, std::size_t Count) {
+          const auto *Evs = static_cast<const EventType *>(Events);
+          for (std::size_t Idx = 0; Idx < Count; ++Idx) {
+            (Subscriber.*CallbackFunc)(Evs[Idx]);
+          }
+        };
+  }
+
+  /// Subscribes a handler that receives all events of a type queued during a
+  /// tick at once, in synchronous mode batches hold a single event
+  template <class SubscriberType, typename EventType>
+  void subscribeBatch(SubscriberType &Subscriber,
+                      void (SubscriberType::*CallbackFunc)(
+                          const EventBatch<EventType> &)) {
+    Subscribers[typeid(EventType)][&Subscriber] =
+        [&Subscriber, CallbackFunc](const void *Events, std::size_t Count) {
+          (Subscriber.*CallbackFunc)(EventBatch<EventType>(
+              static_cast<const EventType *>(Events), Count));
         };
   }
 
@@ -33,17 +90,91 @@ public:
   }
 
   template <typename EventType> void publish(const EventType &E) {
-    auto It = Subscribers.find(typeid(EventType));
+    if constexpr (!EventType::Immediate) {
+      if (QueueEnabled && QueueDepth > 0) {
+        getQueue<EventType>().push(E, QueueOrder);
+        return;
+      }
+    }
+    dispatch(typeid(EventType), &E, 1);
+  }
+
+  /// Enables deferring events published inside a QueueScope, disabled by
+  /// default in which case all events are dispatched synchronously
+  void setQueueEnabled(bool Enabled) {
+    if (!Enabled) {
+      flush();
+    }
+    QueueEnabled = Enabled;
+  }
+  bool isQueueEnabled() const { return QueueEnabled; }
+
+  /// Dispatches all queued events grouped by type, in the order in which the
+  /// first event of each type was published
+  void flush() {
+    // Handlers may publish further events, those are dispatched directly as
+    // we are not inside a queue scope anymore
+    auto Order = std::move(QueueOrder);
+    QueueOrder.clear();
+    for (auto *Queue : Order) {
+      Queue->dispatch(*this);
+    }
+  }
+
+private:
+  class EventQueueBase {
+  public:
+    virtual ~EventQueueBase() = default;
+    virtual void dispatch(EventHub &Hub) = 0;
+  };
+
+  template <typename EventType> class EventQueue final : public EventQueueBase {
+  public:
+    void push(const EventType &E, std::vector<EventQueueBase *> &Order) {
+      if (Events.empty()) {
+        Order.push_back(this);
+      }
+      Events.push_back(E);
+    }
+
+    void dispatch(EventHub &Hub) final {
+      // Keep capacity of both buffers so steady state does not allocate
+      std::swap(Events, InFlight);
+      Hub.dispatch(typeid(EventType), InFlight.data(), InFlight.size());
+      InFlight.clear();
+    }
+
+  private:
+    std::vector<EventType> Events;
+    std::vector<EventType> InFlight;
+  };
+
+  template <typename EventType> EventQueue<EventType> &getQueue() {
+    auto &Queue = Queues[typeid(EventType)];
+    if (!Queue) {
+      Queue = std::make_unique<EventQueue<EventType>>();
+    }
+    return static_cast<EventQueue<EventType> &>(*Queue);
+  }
+
+  void dispatch(std::type_index EvTypeId, const void *Events,
+                std::size_t Count) {
+    auto It = Subscribers.find(EvTypeId);
     if (It == Subscribers.end()) {
       return;
     }
     for (auto const &[Inst, Handler] : It->second) {
-      Handler(E);
+      Handler(Events, Count);
     }
   }
 
 private:
   std::map<std::type_index, HandlerMap> Subscribers;
+
+  bool QueueEnabled = false;
+  unsigned QueueDepth = 0;
+  std::map<std::type_index, std::unique_ptr<EventQueueBase>> Queues;
+  std::vector<EventQueueBase *> QueueOrder;
 };
 
 class EventHubConnector {
@@ -68,6 +199,16 @@ public:
     Hub->subscribe(Subscriber, CallbackFunc);
   }
 
+  template <class SubscriberType, typename EventType>
+  void subscribeBatch(SubscriberType &Subscriber,
+                      void (SubscriberType::*CallbackFunc)(
+                          const EventBatch<EventType> &)) {
+    if (!Hub) {
+      return;
+    }
+    Hub->subscribeBatch(Subscriber, CallbackFunc);
+  }
+
   template <typename EventType> void publish(const EventType &E) {
     if (!Hub) {
       return;
@@ -81,4 +222,4 @@ protected:
 
 } // namespace rogue
 
-#endif // #ifndef ROGUE_EVENT_HUB_H
\ No newline at end of file
+#endif // #ifndef ROGUE_EVENT_HUB_H
@@ -1,8 +1,10 @@
 #ifndef ROGUE_GAME_H
 #define ROGUE_GAME_H
 
+#include <chrono>
 #include <cxxg/Game.h>
 #include <memory>
+#include <rogue/AutoSaver.h>
 #include <rogue/Context.h>
 #include <rogue/CraftingHandler.h>
 #include <rogue/EntityDatabase.h>
@@ -35,6 +37,10 @@ namespace rogue {
 class GameOverException {};
 
 class Game : public cxxg::Game {
+public:
+  /// Minimum time a tick is shown if there are animations to display
+  static constexpr std::chrono::microseconds AnimationTickTime{150000};
+
 public:
   Game(cxxg::Screen &Scr, const GameConfig &Cfg);
   virtual ~Game() = default;
@@ -60,6 +66,9 @@ public:
   void storeSaveGame(const SaveGameInfo &SGI);
 
 private:
+  /// Captures the game for the autosave if due, it is written in background
+  void handleAutoSave();
+
   entt::registry &getLvlReg();
 
   entt::entity getPlayerOrNull() const;
@@ -94,12 +103,16 @@ private:
 
   std::shared_ptr<LevelGenerator> LvlGen;
   std::unique_ptr<GameWorld> World;
+  AutoSaver AutoSave;
 
   RenderEventCollector REC;
   ui::Controller UICtrl;
   long unsigned GameTicks = 0;
 
   unsigned WorldSwitchCounter = 0;
+
+  /// Seed the current world was generated with
+  unsigned WorldSeed = 0;
 };
 
 } // namespace rogue
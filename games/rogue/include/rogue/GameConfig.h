@@ -12,6 +12,14 @@ struct PlayerInitialItemConfig {
   unsigned Count = 1;
 };
 
+struct AutoSaveConfig {
+  /// Save every N game ticks, 0 disables saving on ticks
+  unsigned TickInterval = 0;
+
+  /// Save when switching levels or worlds
+  bool OnLevelChange = false;
+};
+
 struct GameConfig {
   unsigned Seed = 0;
   std::filesystem::path ItemDbConfig;
@@ -21,6 +29,7 @@ struct GameConfig {
   std::string InitialGameWorld;
   std::filesystem::path InitialLevelConfig;
   std::vector<PlayerInitialItemConfig> InitialItems;
+  AutoSaveConfig AutoSave;
 
   static GameConfig load(const std::filesystem::path &ConfigFile);
 };
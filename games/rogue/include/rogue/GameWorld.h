@@ -2,25 +2,45 @@
 #define ROGUE_GAME_WORLD_H
 
 #include <entt/entt.hpp>
+#include <cstdint>
 #include <filesystem>
+#include <functional>
+#include <future>
 #include <memory>
+#include <optional>
+#include <rogue/BackgroundWorker.h>
 #include <rogue/EventHub.h>
+#include <rogue/LevelDatabase.h>
+#include <rogue/LevelPrefetcher.h>
 #include <ymir/Types.hpp>
 
 namespace rogue {
 class Level;
 struct Interaction;
 class LevelGenerator;
-class LevelDatabase;
 struct SaveGameInfo;
+class SaveGameReader;
 } // namespace rogue
 
+namespace rogue::serialize {
+class LevelBaseline;
+} // namespace rogue::serialize
+
 namespace rogue {
 
 class GameWorld : public EventHubConnector {
 public:
-  static std::unique_ptr<GameWorld>
-  create(LevelDatabase &LevelDb, LevelGenerator &LvlGen, std::string_view Type);
+  /// Writes a captured save game, does not reference the world and may be
+  /// called on any thread
+  using SaveGameWriteFn = std::function<void(const SaveGameInfo &SGI)>;
+
+public:
+  /// Creates the world of the given type
+  /// \param Seed The seed \p LvlGen was created with
+  static std::unique_ptr<GameWorld> create(LevelDatabase &LevelDb,
+                                           LevelGenerator &LvlGen,
+                                           std::string_view Type,
+                                           unsigned Seed);
 
 public:
   virtual ~GameWorld() = default;
@@ -33,8 +53,32 @@ public:
   virtual void switchWorld(unsigned Seed, const std::string &LevelName,
                            entt::entity SwitchEt) = 0;
 
+  /// Speculatively prepares levels the player is likely to switch to next in
+  /// the background
+  /// \param NextWorldSeed The seed that will be passed to the next call of
+  /// switchWorld
+  virtual void prefetch(unsigned NextWorldSeed) { (void)NextWorldSeed; }
+
   virtual void loadSaveGame(const SaveGameInfo &SGI) = 0;
-  virtual void storeSaveGame(const SaveGameInfo &SGI) = 0;
+
+  /// Returns the seed the save game was created with if stored by the world,
+  /// the save game can only be loaded by a world created with that seed
+  virtual std::optional<unsigned>
+  readSaveGameSeed(const SaveGameInfo &SGI) const {
+    (void)SGI;
+    return std::nullopt;
+  }
+
+  /// Captures the state of the world required for a save game, this is cheap
+  /// compared to serializing and writing it with the returned function
+  /// \throws std::runtime_error if the world can not be saved
+  virtual SaveGameWriteFn snapshotSaveGame() = 0;
+
+  /// Returns false if the world can not be saved in its current state
+  virtual bool canSaveGame() const { return true; }
+
+  /// Writes the save game, an existing save game is replaced atomically
+  void storeSaveGame(const SaveGameInfo &SGI);
 
   /// Return the index of the currently active level
   virtual std::size_t getCurrentLevelIdx() const = 0;
@@ -50,8 +94,38 @@ class MultiLevelDungeon : public GameWorld {
 public:
   static constexpr const char *Type = "multi_level_dungeon";
 
+  /// Policy for hibernating inactive levels into compact snapshots, that are
+  /// applied to the regenerated level when returning to it. Levels with state
+  /// that snapshots do not restore are kept resident, see
+  /// `LevelSnapshot::canRestore`.
+  struct HibernationConfig {
+    /// Hibernation is disabled by default, all levels are kept resident
+    bool Enabled = false;
+
+    /// Levels within this distance of the current level are kept resident
+    std::size_t KeepDistance = 2;
+
+    /// Levels beyond the keep distance are hibernated, least recently used
+    /// first, while the estimated memory of resident levels exceeds this
+    std::size_t MaxResidentBytes = 32 * 1024 * 1024;
+  };
+
+  struct MemoryStats {
+    std::size_t NumResident = 0;
+    std::size_t NumHibernated = 0;
+    std::size_t ResidentBytes = 0;
+    std::size_t HibernatedBytes = 0;
+  };
+
 public:
-  explicit MultiLevelDungeon(LevelGenerator &LvlGen);
+  /// \param Seed The seed \p LvlGen was created with, stored in save games
+  explicit MultiLevelDungeon(LevelGenerator &LvlGen, unsigned Seed = 0);
+
+  void setHibernationConfig(const HibernationConfig &Cfg);
+  const HibernationConfig &getHibernationConfig() const { return HibCfg; }
+
+  /// Returns the memory accounting of resident and hibernated levels
+  MemoryStats getMemoryStats() const;
 
   /// Switches to the level with the selected index \p LevelIdx
   /// \param LevelIdx The level index to switch to
@@ -62,8 +136,23 @@ public:
   void switchWorld(unsigned Seed, const std::string &LevelName,
                    entt::entity SwitchEt) override;
 
+  /// Generates the level following the current one in the background, does
+  /// nothing past the last level of a `CompositeMultiLevelGenerator`.
+  /// Hibernated neighbours of the current level are regenerated in the
+  /// background as well, so that waking them only applies the snapshot.
+  void prefetch(unsigned NextWorldSeed) override;
+
+  /// Restores the current level and the player, all other levels are kept
+  /// hibernated until they are visited. The save game is kept open, the
+  /// snapshot of a level is only read once the level is woken.
   void loadSaveGame(const SaveGameInfo &SGI) override;
-  void storeSaveGame(const SaveGameInfo &SGI) override;
+  std::optional<unsigned>
+  readSaveGameSeed(const SaveGameInfo &SGI) const override;
+
+  /// Captures all levels, they are stored as separate chunks of the save game.
+  /// Snapshots not yet read from a loaded save game are read first, the
+  /// loaded save game is closed afterwards.
+  SaveGameWriteFn snapshotSaveGame() override;
 
   /// Return the index of the currently active level
   std::size_t getCurrentLevelIdx() const override;
@@ -74,10 +163,38 @@ public:
   Level &getCurrentLevelOrFail() override;
   const Level &getCurrentLevelOrFail() const override;
 
+private:
+  struct LevelEntry {
+    /// The level if resident, nullptr if hibernated
+    std::shared_ptr<Level> Lvl;
+    std::string Snapshot;
+
+    /// The snapshot is still stored in the loaded save game
+    bool InSaveGame = false;
+
+    /// State of the generated level, snapshots only store changes to it
+    std::shared_ptr<const serialize::LevelBaseline> Baseline;
+    std::uint64_t LastUsed = 0;
+  };
+
+  void hibernateLevels();
+  void hibernateLevel(LevelEntry &Entry);
+  void wakeLevel(std::size_t LevelIdx);
+  void readSnapshot(std::size_t LevelIdx);
+
 private:
   LevelGenerator &LevelGen;
+  unsigned Seed = 0;
+  HibernationConfig HibCfg;
   std::size_t CurrentLevelIdx = 0;
-  std::vector<std::shared_ptr<Level>> Levels;
+  std::vector<LevelEntry> Levels;
+  std::uint64_t UseCounter = 0;
+
+  /// Save game the levels were loaded from while it holds unread snapshots
+  std::shared_ptr<SaveGameReader> LoadedSaveGame;
+
+  /// Declared last to stop generation before anything else is destroyed
+  LevelPrefetcher Prefetcher;
 };
 
 /// Single map level that allows to switch between multi-level dungeons
@@ -85,6 +202,10 @@ class DungeonSweeper : public GameWorld {
 public:
   static constexpr const char *Type = "dungeon_sweeper";
 
+  /// Maximum distance of the player to a world entry for prefetching the
+  /// world behind it
+  static constexpr int PrefetchDistance = 8;
+
 public:
   explicit DungeonSweeper(LevelDatabase &LevelDb, LevelGenerator &LvlGen);
 
@@ -100,8 +221,16 @@ public:
   void switchWorld(unsigned Seed, const std::string &LevelName,
                    entt::entity SwitchEt) override;
 
+  /// Prepares the sub-world behind the closest world entry in reach of the
+  /// player in the background, drops a prepared sub-world once the player
+  /// walks away from it
+  void prefetch(unsigned NextWorldSeed) override;
+
   void loadSaveGame(const SaveGameInfo &SGI) override;
-  void storeSaveGame(const SaveGameInfo &SGI) override;
+  SaveGameWriteFn snapshotSaveGame() override;
+
+  /// Saving is only possible outside of sub-worlds
+  bool canSaveGame() const override;
 
   // FIXME
   /// Return the index of the currently active level
@@ -114,18 +243,53 @@ public:
   const Level &getCurrentLevelOrFail() const override;
 
 protected:
-  void switchWorld(unsigned Seed, std::string_view Type,
-                   std::filesystem::path Config, entt::entity SwitchEt);
+  struct SubWorld {
+    unsigned Seed = 0;
+    std::string LevelName;
+    entt::entity SwitchEt = entt::null;
+    std::size_t MaxLevel = 1;
+    std::shared_ptr<LevelGenerator> LvlGen = nullptr;
+    /// Declared after the generator so that the world is destroyed first
+    std::unique_ptr<GameWorld> World = nullptr;
+  };
+
+  /// Sub-world that is being prepared on the background worker
+  struct PendingSubWorld {
+    unsigned Seed = 0;
+    std::string LevelName;
+    entt::entity SwitchEt = entt::null;
+    std::future<std::unique_ptr<SubWorld>> Future;
+  };
+
+  using CreateSubWorldFn = std::function<std::unique_ptr<SubWorld>()>;
+
+  /// Returns a function that loads the generator and creates the sub-world,
+  /// it does not reference the level and may be called on any thread
+  CreateSubWorldFn getCreateSubWorldFn(unsigned Seed,
+                                       const std::string &LevelName,
+                                       const LevelContainer::LevelInfo &LI,
+                                       entt::entity SwitchEt) const;
+  void enterSubWorld(std::unique_ptr<SubWorld> SW);
+  void leaveSubWorld();
+
+  /// Drops the prepared sub-world, it is destroyed on the background worker
+  /// as it may still be generating levels
+  void discardPrefetchedSubWorld();
 
 private:
   LevelDatabase &LevelDb;
   LevelGenerator &LevelGen;
   std::shared_ptr<Level> Lvl;
+  std::optional<PendingSubWorld> PrefetchedSubWorld;
   std::shared_ptr<LevelGenerator> CurrSubLvlGen = nullptr;
   std::unique_ptr<GameWorld> CurrSubWorld = nullptr;
   std::size_t CurrMaxLevel = 0;
   entt::entity CurrSwitchEntity = entt::null;
   int SwitchedWorldCount = 0;
+
+  /// Declared last to finish background jobs before anything else is
+  /// destroyed
+  BackgroundWorker Worker;
 };
 
 } // namespace rogue
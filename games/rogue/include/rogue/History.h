@@ -7,8 +7,11 @@
 #include <string>
 #include <vector>
 
-namespace rogue {
+namespace cxxg {
 class Game;
+} // namespace cxxg
+
+namespace rogue {
 class History;
 struct DebugMessageEvent;
 struct EntityAttackEvent;
@@ -45,27 +48,57 @@ class History {
   friend class HistoryMessageAssembler;
 
 public:
+  static constexpr std::size_t DefaultMaxMessages = 1000;
+
+  /// Compact representation of a message, text with trailing blanks removed
+  /// and the colors encoded as runs
   struct Message {
-    // FIXME refactor to decouple from cxxg
-    cxxg::Row Row;
+    struct ColorRun {
+      /// Index of the first character using the color
+      std::size_t Start = 0;
+      cxxg::types::TermColor Color;
+    };
+
+    static Message create(const cxxg::Row &Rw);
+
+    /// Materializes the message into a row with the given width
+    cxxg::Row getRow(std::size_t Width) const;
+
+    bool isSameAs(const Message &Other) const;
+
+    std::string Text;
+    std::vector<ColorRun> Colors;
+    std::size_t Hash = 0;
 
     /// Number of times this message has been repeated
     unsigned Count = 1;
   };
 
 public:
-  explicit History(Game &G);
+  /// Creates the history, messages are also shown as notifications of the game
+  explicit History(cxxg::Game &G,
+                   std::size_t MaxMessages = DefaultMaxMessages);
   HistoryMessageAssembler info();
   HistoryMessageAssembler warn();
 
-  const std::vector<Message> &getMessages() const { return Messages; }
+  /// Returns number of messages in the history, bounded by the maximum number
+  /// of messages, older messages are dropped
+  std::size_t getNumMessages() const { return Messages.size(); }
+
+  /// Returns message at the given index, zero being the oldest message
+  const Message &getMessage(std::size_t Idx) const;
 
 private:
   void addMessage(const cxxg::Row &Msg);
 
 private:
-  Game &G;
+  cxxg::Game &G;
+  std::size_t MaxMessages;
+
+  /// Ring buffer of messages, grows until the maximum number of messages is
+  /// reached
   std::vector<Message> Messages;
+  std::size_t FirstMessageIdx = 0;
 };
 
 class EventHistoryWriter : public EventHubConnector {
@@ -1,14 +1,24 @@
 #ifndef ROGUE_INVENTORY_H
 #define ROGUE_INVENTORY_H
 
+#include <cstdint>
 #include <entt/entt.hpp>
 #include <optional>
 #include <rogue/Item.h>
+#include <unordered_map>
 #include <vector>
 
 namespace rogue {
 
+/// Ordered list of item stacks. Stacks are indexed by item kind and id, so
+/// adding items, counting items and looking up stacks does not have to scan
+/// the whole inventory.
 class Inventory {
+public:
+  /// Identifies a stack for as long as it is part of the inventory, unlike
+  /// the index it is not invalidated by adding or removing other stacks
+  using SlotHandle = std::uint64_t;
+
 public:
   /// Applies the item to the entity if possible
   /// @param It The item to apply
@@ -26,18 +36,41 @@ public:
   Inventory(unsigned MaxStackSize) : MaxStackSize(MaxStackSize) {}
 
   const Item &getItem(std::size_t ItemIdx) const { return Items.at(ItemIdx); }
-  void setItems(std::vector<Item> Items) { this->Items = std::move(Items); }
+  void setItems(std::vector<Item> Items);
   const std::vector<Item> &getItems() const { return Items; }
 
   unsigned getMaxStackSize() const { return MaxStackSize; }
 
+  /// Returns the handle of the stack at the index
+  /// \throws std::out_of_range if the index is invalid
+  SlotHandle getSlotHandle(std::size_t ItemIdx) const;
+
+  /// Returns the current index of the stack, if it is still in the inventory
+  std::optional<std::size_t> getItemIndex(SlotHandle Handle) const;
+
   void addItem(Item It);
   Item takeItem(std::size_t ItemIdx);
   Item takeItem(std::size_t ItemIdx, unsigned Count);
 
+  /// Adds all items, equivalent to adding them one by one
+  void addItems(std::vector<Item> NewItems);
+
+  /// Takes a single item for each id, ids may be repeated. Either all items
+  /// are taken or none if the inventory does not contain enough of them.
+  std::optional<std::vector<Item>>
+  takeItemsById(const std::vector<ItemProtoId> &Ids);
+
   /// Returns true if the inventory contains an item with the given id and count
   bool hasItem(int Id, unsigned Count = 1) const;
 
+  /// Returns the summed stack size of all items with the given id
+  unsigned getItemCount(int Id) const;
+
+  /// Returns the summed stack size per item id
+  const std::unordered_map<int, unsigned> &getItemCounts() const {
+    return CountById;
+  }
+
   std::optional<std::size_t> getItemIndexForId(int Id) const;
 
   std::optional<Item> applyItemTo(std::size_t ItemIdx, CapabilityFlags Flags,
@@ -48,11 +81,59 @@ public:
   bool empty() const;
   void clear();
 
+  /// Returns a counter that changes whenever items are added or taken, used
+  /// to tell if views of the inventory are outdated
+  std::uint64_t getRevision() const { return Revision; }
+
+private:
+  /// Identifies stacks that can be merged, see `Item::isSameKind`
+  struct KindKey {
+    const ItemPrototype *Proto = nullptr;
+    const ItemPrototype *Spec = nullptr;
+
+    bool operator==(const KindKey &Other) const {
+      return Proto == Other.Proto && Spec == Other.Spec;
+    }
+  };
+
+  struct KindKeyHash {
+    std::size_t operator()(const KindKey &Key) const {
+      const auto H = std::hash<const ItemPrototype *>();
+      return H(Key.Proto) ^ (H(Key.Spec) * 31);
+    }
+  };
+
+  static KindKey getKindKey(const Item &It);
+
+  void appendSlot(Item It);
+  void removeFromIndex(SlotHandle Handle, const Item &It);
+  Item eraseSlot(std::size_t ItemIdx);
+
+  /// Removes all stacks with a stack size of zero in a single pass
+  void eraseEmptySlots();
+
+  void rebuildIndex();
+
 private:
   std::vector<Item> Items;
 
+  /// Handles of the stacks in `Items`, handles are increasing so the index of
+  /// a handle can be found by binary search
+  std::vector<SlotHandle> Handles;
+  SlotHandle NextHandle = 0;
+
+  /// Handles of the stacks per kind and id in inventory order
+  std::unordered_map<KindKey, std::vector<SlotHandle>, KindKeyHash>
+      SlotsByKind;
+  std::unordered_map<int, std::vector<SlotHandle>> SlotsById;
+
+  /// Summed stack sizes per item id
+  std::unordered_map<int, unsigned> CountById;
+
   /// A max stack size of zero indicates no limit
   unsigned MaxStackSize = 0;
+
+  std::uint64_t Revision = 0;
 };
 
 std::ostream &operator<<(std::ostream &OS, const Inventory &Inv);
@@ -5,6 +5,8 @@
 #include <entt/entt.hpp>
 #include <rogue/EventHub.h>
 #include <rogue/ItemType.h>
+#include <rogue/Types.h>
+#include <vector>
 
 namespace rogue {
 class Item;
@@ -71,6 +73,10 @@ public:
   /// Checks if the inventory has all items to craft the recipe
   bool canCraft(const CraftingRecipe &Recipe) const;
 
+  /// Returns the ids of all recipes the inventory has the items for, sorted
+  /// by id
+  std::vector<CraftingRecipeId> getCraftableRecipes() const;
+
   /// Tries to craft the recipe from the inventory
   bool tryCraft(const CraftingRecipe &Recipe);
 
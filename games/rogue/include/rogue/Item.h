@@ -25,18 +25,38 @@ public:
 
   ItemProtoId getId() const;
   const std::string &getName() const;
-  std::string getQualifierName() const;
-  std::string getDescription() const;
+  /// Returns the name prefixed by a qualifier derived from the effects, it is
+  /// computed once on construction and interned
+  const std::string &getQualifierName() const { return *QualifierName; }
+  const std::string &getDescription() const;
   ItemType getType() const;
   int getMaxStackSize() const;
   const std::optional<ItemType> &getEnhanceFilterType() const;
 
-  std::vector<EffectInfo> getAllEffects() const;
+  /// Returns the effects of prototype and specialization, they are merged
+  /// once on construction and shared by all copies of the item
+  const std::vector<EffectInfo> &getAllEffects() const { return *AllEffects; }
 
+  /// Returns true if an effect of the item has all of \p Flags set
   bool hasEffect(CapabilityFlags Flags, bool AllowNull = false,
-                 bool AllowRemove = false) const;
-
-  CapabilityFlags getCapabilityFlags() const;
+                 bool AllowRemove = false) const {
+    return Index.hasEffect(Flags, AllowNull, AllowRemove);
+  }
+
+  CapabilityFlags getCapabilityFlags() const {
+    return Index.getCapabilityFlags();
+  }
+
+  /// Calls \p Fn in order for each effect that has all of \p Flags set
+  template <typename FnT>
+  void forEachEffect(CapabilityFlags Flags, FnT Fn) const {
+    auto Mask = Index.getEffectMask(Flags);
+    for (std::size_t Idx = 0; Mask != 0; ++Idx, Mask >>= 1) {
+      if (Mask & 1) {
+        Fn((*AllEffects)[Idx]);
+      }
+    }
+  }
 
   /// Returns true if other Item has same prototype and specialization
   bool isSameKind(const Item &Other) const;
@@ -55,6 +75,9 @@ public:
 
   bool doesSpecOverride() const { return SpecOverrides; }
 
+private:
+  std::string computeQualifierName() const;
+
 public:
   int StackSize = 1;
 
@@ -62,6 +85,19 @@ private:
   const ItemPrototype *Proto = nullptr;
   std::shared_ptr<const ItemPrototype> Specialization = nullptr;
   bool SpecOverrides = false;
+
+  /// Merged effects if both prototype and specialization have effects
+  std::shared_ptr<const std::vector<EffectInfo>> MergedEffects;
+
+  /// Effects of the prototype, the specialization or the merged ones
+  const std::vector<EffectInfo> *AllEffects = nullptr;
+
+  /// Capabilities of the effects, computed on construction as the
+  /// specialization of an item does not change
+  EffectIndex Index;
+
+  /// Interned qualifier name, shared by all items with the same name
+  const std::string *QualifierName = nullptr;
 };
 
 } // namespace rogue
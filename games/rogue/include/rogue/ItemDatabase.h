@@ -6,6 +6,7 @@
 #include <rogue/Item.h>
 #include <rogue/ItemPrototype.h>
 #include <rogue/ItemSpecialization.h>
+#include <rogue/LootDropCalculator.h>
 #include <rogue/LootTable.h>
 
 namespace rogue {
@@ -28,6 +29,13 @@ public:
                     const ItemSpecializations *ItemSpec = nullptr,
                     const std::shared_ptr<LootTable> &Enhancements = nullptr);
 
+  /// Creates the item rolling specializations and enhancements with the
+  /// given engine
+  Item createItem(ItemProtoId ItemId, int StackSize, RandomEngine &Rng,
+                  bool AllowEnchanting = true) const;
+
+  /// Creates the item rolling with an engine seeded from std::rand, only use
+  /// on the game thread
   Item createItem(ItemProtoId ItemId, int StackSize = 1,
                   bool AllowEnchanting = true) const;
 
@@ -38,6 +46,12 @@ public:
   const std::map<std::string, std::shared_ptr<LootTable>> &
   getLootTables() const;
 
+  /// Returns the exact drop rates of the loot table without sampling, rates
+  /// are memoized per table until a loot table is added. Tables must not be
+  /// changed once their rates were computed, only use on the game thread.
+  /// \throws std::out_of_range if the loot table does not exist
+  const LootDropRates &getLootDropRates(const std::string &Name) const;
+
   const std::shared_ptr<ItemEffect> &getItemEffect(const std::string &Name) const;
 
 private:
@@ -54,6 +68,9 @@ private:
 
   /// Map of item effect name to item effect
   std::map<std::string, std::shared_ptr<ItemEffect>> Effects;
+
+  /// Memoized drop rates of the loot tables and the tables they contain
+  mutable LootDropCalculator LootDropCalc;
 };
 
 } // namespace rogue
@@ -5,6 +5,7 @@
 #include <rogue/Components/Stats.h>
 #include <rogue/EffectInfo.h>
 #include <rogue/ItemType.h>
+#include <rogue/Random.h>
 #include <vector>
 
 namespace rogue {
@@ -17,14 +18,14 @@ namespace rogue {
 class ItemSpecialization {
 public:
   virtual ~ItemSpecialization() = default;
-  virtual std::shared_ptr<ItemEffect> createEffect() const = 0;
+  virtual std::shared_ptr<ItemEffect> createEffect(RandomEngine &Rng) const = 0;
 };
 
 class StatsBuffSpecialization : public ItemSpecialization {
 public:
   StatPoint MinPoints = 0;
   StatPoint MaxPoints = 0;
-  std::shared_ptr<ItemEffect> createEffect() const override;
+  std::shared_ptr<ItemEffect> createEffect(RandomEngine &Rng) const override;
 };
 
 class ItemSpecializations {
@@ -37,7 +38,8 @@ public:
 public:
   void addSpecialization(EffectAttributes Attributes,
                          std::shared_ptr<ItemSpecialization> Spec);
-  std::shared_ptr<ItemPrototype> actualize(const ItemPrototype &Proto) const;
+  std::shared_ptr<ItemPrototype> actualize(const ItemPrototype &Proto,
+                                           RandomEngine &Rng) const;
 
 private:
   std::vector<SpecializationInfo> Generators;
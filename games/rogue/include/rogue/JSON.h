@@ -2,13 +2,53 @@
 #define ROGUE_JSON_H
 
 #include <filesystem>
+#include <functional>
 #include <rapidjson/document.h>
+#include <string_view>
+#include <vector>
 
 namespace rogue {
 
 using JSONDocument = rapidjson::Document;
 
-std::pair<std::string, JSONDocument>
+/// Null terminated JSON text, documents are parsed in-situ and reference the
+/// strings stored in the buffer, hence the buffer needs to outlive them
+using JSONBuffer = std::vector<char>;
+
+enum class JSONValidationMode {
+  /// Validate every loaded file against its schema
+  Always,
+  /// Skip validation of file contents that already passed validation against
+  /// the same schema, identified by a hash of the contents
+  SkipValidated
+};
+
+/// Sets the validation mode, defaults to `SkipValidated`
+void setJSONValidationMode(JSONValidationMode Mode);
+
+/// Removes all compiled schemas and records of validated file contents
+void clearJSONSchemaCache();
+
+/// Returns how many documents were validated against a schema, documents that
+/// skipped validation are not counted
+std::size_t getJSONValidationCount();
+
+/// Called for every JSON file loaded from disk after it has been validated
+/// against the schema, the schema path is null if the file was not validated
+using JSONLoadObserver = std::function<void(
+    const std::filesystem::path &, std::string_view,
+    const std::filesystem::path *)>;
+
+/// Sets the observer for loaded JSON files, an empty function removes it
+void setJSONLoadObserver(JSONLoadObserver Observer);
+
+/// Loads the JSON file and validates it against the schema if given, compiled
+/// schemas are cached for the lifetime of the process or until the schema
+/// file changes. If an active data bundle contains the file and neither the
+/// file nor the schema changed on disk since the bundle was compiled, the
+/// bundled data is used instead and validation is skipped as the data compiler
+/// already validated it against the same schema.
+std::pair<JSONBuffer, JSONDocument>
 loadJSON(const std::filesystem::path &JsonPath,
          const std::filesystem::path *SchemaPath);
 
@@ -43,6 +43,7 @@ public:
 
   // FIXME decouple player from level
   void createPlayer();
+  void createPlayer(ymir::Point2d<int> AtPos);
   bool hasPlayer() const;
   void movePlayer(Level &From, ymir::Point2d<int> AtPos);
   void removePlayer();
@@ -76,8 +77,12 @@ public:
   getDijkstraMap(Tile Target, std::size_t Layer) const;
 
   void revealMap();
+  ymir::Map<bool, int> &getPlayerSeenMap();
   const ymir::Map<bool, int> &getPlayerSeenMap() const;
 
+  /// Returns an estimate of the memory used by the level in bytes
+  std::size_t getMemoryUsage() const;
+
   const entt::entity &getEntityAt(ymir::Point2d<int> AtPos) const;
   void updateEntityPosition(const entt::entity &Entity, PositionComp &PosComp,
                             ymir::Point2d<int> NextPos);
@@ -79,6 +79,10 @@ public:
   void addLevelTable(const std::string &LevelName,
                      std::shared_ptr<LevelTable> LC);
 
+  /// Returns all level tables by name
+  const std::map<std::string, std::shared_ptr<LevelTable>> &
+  getLevelTables() const;
+
 private:
   std::map<std::string, std::shared_ptr<LevelTable>> LevelsByName;
 };
@@ -11,6 +11,7 @@
 
 namespace rogue {
 struct GameContext;
+struct EntityTemplateId;
 } // namespace rogue
 
 namespace rogue {
@@ -22,23 +23,35 @@ struct LevelEntityConfig {
 /// Base class for all level generators
 class LevelGenerator {
 public:
+  /// \param Seed Seed for the random engines of the generated levels, see
+  /// `initRandomEngine`
   explicit LevelGenerator(const GameContext &Ctx,
-                          const std::filesystem::path &DataDir);
+                          const std::filesystem::path &DataDir,
+                          unsigned Seed = 0);
 
   const GameContext &getCtx() const { return Ctx; }
   const std::filesystem::path &getDataDir() const { return DataDir; }
+  unsigned getSeed() const { return Seed; }
 
   virtual ~LevelGenerator() = default;
   virtual std::shared_ptr<Level> generateLevel(int LevelId) const = 0;
 
 protected:
+  /// Adds a random engine derived from the seed and the level id to the
+  /// context of the level, entities spawned into the level roll their loot
+  /// with it. Needs to be called before spawning entities.
+  void initRandomEngine(Level &L) const;
+
   void spawnEntities(const LevelEntityConfig &Cfg, Level &L) const;
   void spawnEntity(char Char, const LevelEntityConfig &Cfg, Level &L,
                    ymir::Point2d<int> Pos) const;
+  EntityTemplateId getEntityTemplateId(char Char, const LevelEntityConfig &Cfg,
+                                       ymir::Point2d<int> Pos) const;
 
 protected:
   const GameContext &Ctx;
   std::filesystem::path DataDir;
+  unsigned Seed = 0;
 };
 
 /// Level generator that generates an empty level with the given size
@@ -50,7 +63,8 @@ public:
 
 public:
   EmptyLevelGenerator(const GameContext &Ctx,
-                          const std::filesystem::path &DataDir, const Config &Cfg);
+                      const std::filesystem::path &DataDir,
+                      const Config &Cfg, unsigned Seed = 0);
   std::shared_ptr<Level> generateLevel(int LevelId) const final;
 
 private:
@@ -74,7 +88,8 @@ public:
 
 public:
   DesignedMapLevelGenerator(const GameContext &Ctx,
-                          const std::filesystem::path &DataDir, const Config &Cfg);
+                            const std::filesystem::path &DataDir,
+                            const Config &Cfg, unsigned Seed = 0);
 
   std::shared_ptr<Level> generateLevel(int LevelId) const final;
 
@@ -95,7 +110,8 @@ public:
 
 public:
   TiledMapLevelGenerator(const GameContext &Ctx,
-                          const std::filesystem::path &DataDir, const Config &Cfg);
+                         const std::filesystem::path &DataDir,
+                         const Config &Cfg, unsigned Seed = 0);
 
   std::shared_ptr<Level> generateLevel(int LevelId) const final;
 
@@ -159,6 +175,19 @@ public:
 
   std::shared_ptr<Level> generateLevel(int LevelId) const final;
 
+  /// Generates the levels with index in [\p BeginIdx, \p EndIdx) concurrently.
+  /// Each level is generated independently with its own random engine, the
+  /// result is the same as generating the levels one after another.
+  /// \param NumThreads Number of threads to use, 0 uses one per hardware thread
+  /// \throws The first exception thrown while generating a level
+  std::vector<std::shared_ptr<Level>>
+  generateRange(std::size_t BeginIdx, std::size_t EndIdx,
+                unsigned NumThreads = 0) const;
+
+  /// Generates all levels up to `getMaxLevelIdx` concurrently
+  std::vector<std::shared_ptr<Level>>
+  generateAll(unsigned NumThreads = 0) const;
+
   std::size_t getMaxLevelIdx() const;
 
 private:
@@ -0,0 +1,73 @@
+#ifndef ROGUE_LEVEL_PREFETCHER_H
+#define ROGUE_LEVEL_PREFETCHER_H
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <future>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+namespace rogue {
+class Level;
+} // namespace rogue
+
+namespace rogue {
+
+/// Generates levels speculatively on a worker thread so that switching to
+/// them does not stall the game. Levels are handed over through futures, the
+/// worker is started on the first prefetch.
+class LevelPrefetcher {
+public:
+  using GenerateFn = std::function<std::shared_ptr<Level>()>;
+
+public:
+  LevelPrefetcher() = default;
+  LevelPrefetcher(const LevelPrefetcher &) = delete;
+  LevelPrefetcher &operator=(const LevelPrefetcher &) = delete;
+
+  /// Waits for the level currently being generated, pending levels are dropped
+  ~LevelPrefetcher();
+
+  /// Schedules generation of the level with index \p LevelIdx, does nothing
+  /// if the level is already scheduled. Anything referenced by \p Generate
+  /// needs to outlive the prefetcher.
+  void prefetch(std::size_t LevelIdx, GenerateFn Generate);
+
+  /// Returns true if the level is scheduled and not yet taken
+  bool isScheduled(std::size_t LevelIdx) const;
+
+  /// Returns the prefetched level or nullptr if it was not scheduled. Waits
+  /// if the level is being generated, a level that was not started yet is
+  /// generated on the calling thread. Errors of the generation are rethrown.
+  std::shared_ptr<Level> take(std::size_t LevelIdx);
+
+  /// Drops all scheduled levels, a level that is currently being generated is
+  /// discarded once finished
+  void cancel();
+
+private:
+  using Task = std::packaged_task<std::shared_ptr<Level>()>;
+
+  struct Job {
+    std::size_t LevelIdx = 0;
+    Task Generate;
+  };
+
+  void run();
+
+private:
+  mutable std::mutex Mutex;
+  std::condition_variable CV;
+  std::deque<Job> Jobs;
+  std::map<std::size_t, std::future<std::shared_ptr<Level>>> Futures;
+  bool Stop = false;
+  std::thread Worker;
+};
+
+} // namespace rogue
+
+#endif // #ifndef ROGUE_LEVEL_PREFETCHER_H
@@ -0,0 +1,50 @@
+#ifndef ROGUE_LOOT_DROP_CALCULATOR_H
+#define ROGUE_LOOT_DROP_CALCULATOR_H
+
+#include <cstddef>
+#include <map>
+#include <rogue/LootTable.h>
+#include <rogue/Types.h>
+#include <vector>
+
+namespace rogue {
+
+struct LootDrop {
+  /// Probability that the item drops at least once when generating the loot
+  double Probability = 0.0;
+
+  /// Expected summed count of the item when generating the loot
+  double ExpectedCount = 0.0;
+};
+
+/// Drop rates of all items that can be part of the loot of a container
+using LootDropRates = std::map<ItemProtoId, LootDrop>;
+
+/// Computes the exact drop rates of loot containers without sampling. Rates
+/// are memoized per container, so tables shared by multiple tables are only
+/// evaluated once. Loot tables must not be changed while the calculator is
+/// in use.
+class LootDropCalculator {
+public:
+  /// Maximum number of slot combinations evaluated for a table that picks
+  /// slots without returning them
+  static constexpr std::size_t MaxCombinations = 1 << 20;
+
+public:
+  /// \throws std::runtime_error if loot tables contain themselves or a table
+  /// has too many slot combinations
+  const LootDropRates &getDropRates(const LootContainer &LC);
+
+private:
+  LootDropRates computeTableRates(const LootTable &LT);
+
+private:
+  std::map<const LootContainer *, LootDropRates> Cache;
+
+  /// Tables currently being evaluated
+  std::vector<const LootContainer *> Path;
+};
+
+} // namespace rogue
+
+#endif // #ifndef ROGUE_LOOT_DROP_CALCULATOR_H
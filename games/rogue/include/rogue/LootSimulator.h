@@ -0,0 +1,121 @@
+#ifndef ROGUE_LOOT_SIMULATOR_H
+#define ROGUE_LOOT_SIMULATOR_H
+
+#include <cstdint>
+#include <map>
+#include <random>
+#include <rogue/LootTable.h>
+#include <rogue/Types.h>
+#include <vector>
+
+namespace rogue {
+
+/// Samples an index with probability proportional to its weight in constant
+/// time, see Vose's alias method
+class AliasTable {
+public:
+  AliasTable() = default;
+
+  /// Creates the table, slots with a weight of zero are never sampled
+  /// \throws std::out_of_range if a weight is negative
+  explicit AliasTable(const std::vector<int> &Weights);
+
+  /// Returns true if there is nothing to sample, i.e. all weights are zero
+  bool empty() const { return Probs.empty(); }
+
+  template <typename RngT> std::size_t sample(RngT &Rng) const {
+    std::uniform_int_distribution<std::size_t> IdxDist(0, Probs.size() - 1);
+    std::uniform_real_distribution<double> ProbDist(0.0, 1.0);
+    const auto Idx = IdxDist(Rng);
+    return ProbDist(Rng) < Probs[Idx] ? Idx : Aliases[Idx];
+  }
+
+private:
+  std::vector<double> Probs;
+  std::vector<std::size_t> Aliases;
+};
+
+/// Simulates the rewards of a loot container for balancing. The container
+/// tree is flattened once into alias tables, rolls are then independent of
+/// the global random state and can run on multiple threads.
+class LootSimulator {
+public:
+  /// Number of rolls sampled with the same random engine, batches are
+  /// seeded by their index so results do not depend on the thread count
+  static constexpr std::uint64_t BatchSize = 1 << 16;
+
+  struct ItemStats {
+    ItemProtoId ItId = ItemProtoId(-1);
+    /// Summed count over all rolls
+    std::uint64_t Count = 0;
+    /// Number of rolls that dropped the item at least once
+    std::uint64_t Occurrences = 0;
+  };
+
+  struct Result {
+    std::uint64_t Rolls = 0;
+    /// Summed count of all items over all rolls
+    std::uint64_t Total = 0;
+    /// Stats of all items that dropped, sorted by descending count
+    std::vector<ItemStats> Items;
+  };
+
+public:
+  /// \throws std::runtime_error if loot tables contain themselves
+  explicit LootSimulator(const LootContainer &Root);
+
+  /// Generates the loot of a single roll
+  void fillLoot(std::vector<LootContainer::LootReward> &Loot,
+                std::mt19937 &Rng) const;
+
+  /// Rolls the loot \p Rolls times on \p NumThreads worker threads, the
+  /// hardware concurrency is used if zero
+  Result run(std::uint64_t Rolls, unsigned Seed, unsigned NumThreads = 0) const;
+
+private:
+  static constexpr int NoNode = -1;
+
+  struct Node {
+    /// Dense index of the item in `ItemIds`, `NoNode` for tables
+    int ItemIdx = NoNode;
+    unsigned MinCount = 0;
+    unsigned MaxCount = 0;
+
+    unsigned NumRolls = 0;
+    bool PickAndReturn = false;
+    std::vector<int> Guaranteed;
+    std::vector<int> Children;
+    std::vector<int> Weights;
+    int TotalWeight = 0;
+    AliasTable Alias;
+  };
+
+  struct Histogram;
+
+  int addNode(const LootContainer &LC,
+              std::vector<const LootContainer *> &Path);
+  int getItemIdx(ItemProtoId ItId);
+
+  /// Rolls the node and calls \p Visit with the item index and count of
+  /// every reward
+  template <typename VisitFn>
+  void rollNode(int NodeIdx, std::mt19937 &Rng, VisitFn &Visit) const;
+
+  void runBatch(std::uint64_t BatchIdx, std::uint64_t NumRolls, unsigned Seed,
+                Histogram &Hist) const;
+
+private:
+  std::vector<Node> Nodes;
+  int RootIdx = NoNode;
+
+  /// Ids of all items that can drop, nodes refer to them by index
+  std::vector<ItemProtoId> ItemIds;
+  std::map<int, int> ItemIdxById;
+
+  /// Nodes already created for containers shared by multiple tables
+  std::map<const LootContainer *, int> Visited;
+};
+
+} // namespace rogue
+
+#endif // #ifndef ROGUE_LOOT_SIMULATOR_H
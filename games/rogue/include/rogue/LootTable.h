@@ -2,8 +2,9 @@
 #define ROGUE_LOOT_TABLE_H
 
 #include <memory>
-#include <vector>
+#include <rogue/Random.h>
 #include <rogue/Types.h>
+#include <vector>
 
 namespace rogue {
 
@@ -16,7 +17,12 @@ public:
 
 public:
   virtual ~LootContainer() = default;
-  virtual void fillLoot(std::vector<LootReward> &Loot) const = 0;
+  virtual void fillLoot(std::vector<LootReward> &Loot,
+                        RandomEngine &Rng) const = 0;
+  std::vector<LootReward> generateLoot(RandomEngine &Rng) const;
+
+  /// Rolls with an engine seeded from std::rand, only use on the game thread
+  void fillLoot(std::vector<LootReward> &Loot) const;
   std::vector<LootReward> generateLoot() const;
 };
 
@@ -31,8 +37,11 @@ public:
   LootItem(ItemProtoId ItId, unsigned MinCount, unsigned MaxCount);
 
   ItemProtoId getItemId() const;
+  unsigned getMinCount() const { return MinCount; }
+  unsigned getMaxCount() const { return MaxCount; }
 
-  void fillLoot(std::vector<LootReward> &Loot) const final;
+  using LootContainer::fillLoot;
+  void fillLoot(std::vector<LootReward> &Loot, RandomEngine &Rng) const final;
 
 private:
   ItemProtoId ItId;
@@ -53,7 +62,8 @@ public:
 public:
   static std::size_t getSlotForRoll(int Roll,
                                     const std::vector<LootSlot> &Slots);
-  static std::size_t rollForSlot(const std::vector<LootSlot> &Slots);
+  static std::size_t rollForSlot(const std::vector<LootSlot> &Slots,
+                                 RandomEngine &Rng);
 
 public:
   LootTable();
@@ -63,14 +73,19 @@ public:
              bool PickAndReturn = false);
 
   inline unsigned getRolls() const { return NumRolls; }
+  bool isPickAndReturn() const { return PickAndReturn; }
   const std::vector<LootSlot> &getSlots() const;
   const std::vector<LootSlot> &getGuaranteedSlots() const;
 
-  void fillGuaranteedLoot(std::vector<LootReward> &Loot) const;
-  void fillLoot(std::vector<LootReward> &Loot) const final;
+  void fillGuaranteedLoot(std::vector<LootReward> &Loot,
+                          RandomEngine &Rng) const;
+  using LootContainer::fillLoot;
+  void fillLoot(std::vector<LootReward> &Loot, RandomEngine &Rng) const final;
 
-  void fillLootNoReturns(std::vector<LootReward> &Loot) const;
-  void fillLootWithReturns(std::vector<LootReward> &Loot) const;
+  void fillLootNoReturns(std::vector<LootReward> &Loot,
+                         RandomEngine &Rng) const;
+  void fillLootWithReturns(std::vector<LootReward> &Loot,
+                           RandomEngine &Rng) const;
 
 private:
   unsigned NumRolls = 1;
@@ -27,8 +27,8 @@
 #include <math.h>
 
 // 2D simplex skew factors
-#define F2 0.3660254037844386f  // 0.5 * (sqrt(3.0) - 1.0)
-#define G2 0.21132486540518713f // (3.0 - sqrt(3.0)) / 6.0
+constexpr float F2 = 0.3660254037844386f;  // 0.5 * (sqrt(3.0) - 1.0)
+constexpr float G2 = 0.21132486540518713f; // (3.0 - sqrt(3.0)) / 6.0
 
 const float GRAD3[][3] = {{1, 1, 0},  {-1, 1, 0},  {1, -1, 0}, {-1, -1, 0},
                           {1, 0, 1},  {-1, 0, 1},  {1, 0, -1}, {-1, 0, -1},
@@ -139,15 +139,18 @@ inline float noise2(float x, float y, int octaves = 1, float persistence = 0.5f,
   return total / max;
 }
 
-#define dot3(v1, v2) ((v1)[0] * (v2)[0] + (v1)[1] * (v2)[1] + (v1)[2] * (v2)[2])
+inline float dot3(const float *v1, const float *v2) {
+  return v1[0] * v2[0] + v1[1] * v2[1] + v1[2] * v2[2];
+}
 
-#define ASSIGN(a, v0, v1, v2)                                                  \
-  (a)[0] = v0;                                                                 \
-  (a)[1] = v1;                                                                 \
-  (a)[2] = v2;
+inline void assign3(int *a, int v0, int v1, int v2) {
+  a[0] = v0;
+  a[1] = v1;
+  a[2] = v2;
+}
 
-#define F3 (1.0f / 3.0f)
-#define G3 (1.0f / 6.0f)
+constexpr float F3 = 1.0f / 3.0f;
+constexpr float G3 = 1.0f / 6.0f;
 
 inline float _noise3(float x, float y, float z) {
   int c, o1[3], o2[3], g[4], I, J, K;
@@ -166,25 +169,25 @@ inline float _noise3(float x, float y, float z) {
 
   if (pos[0][0] >= pos[0][1]) {
     if (pos[0][1] >= pos[0][2]) {
-      ASSIGN(o1, 1, 0, 0);
-      ASSIGN(o2, 1, 1, 0);
+      assign3(o1, 1, 0, 0);
+      assign3(o2, 1, 1, 0);
     } else if (pos[0][0] >= pos[0][2]) {
-      ASSIGN(o1, 1, 0, 0);
-      ASSIGN(o2, 1, 0, 1);
+      assign3(o1, 1, 0, 0);
+      assign3(o2, 1, 0, 1);
     } else {
-      ASSIGN(o1, 0, 0, 1);
-      ASSIGN(o2, 1, 0, 1);
+      assign3(o1, 0, 0, 1);
+      assign3(o2, 1, 0, 1);
     }
   } else {
     if (pos[0][1] < pos[0][2]) {
-      ASSIGN(o1, 0, 0, 1);
-      ASSIGN(o2, 0, 1, 1);
+      assign3(o1, 0, 0, 1);
+      assign3(o2, 0, 1, 1);
     } else if (pos[0][0] < pos[0][2]) {
-      ASSIGN(o1, 0, 1, 0);
-      ASSIGN(o2, 0, 1, 1);
+      assign3(o1, 0, 1, 0);
+      assign3(o2, 0, 1, 1);
     } else {
-      ASSIGN(o1, 0, 1, 0);
-      ASSIGN(o2, 1, 1, 0);
+      assign3(o1, 0, 1, 0);
+      assign3(o2, 1, 1, 0);
     }
   }
 
@@ -0,0 +1,126 @@
+#ifndef ROGUE_PROFILER_H
+#define ROGUE_PROFILER_H
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <iosfwd>
+#include <map>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace rogue {
+
+/// Lightweight profiler for the stages of the main loop. Each stage keeps the
+/// durations of its most recent runs in a ring buffer from which percentiles
+/// are computed, additionally a bounded trace of all runs is kept that can be
+/// dumped in the Chrome trace event format. Disabled by default in which case
+/// timers do not record anything.
+class Profiler {
+public:
+  using Clock = std::chrono::steady_clock;
+
+  /// Number of samples kept per stage
+  static constexpr std::size_t MaxSamples = 256;
+
+  /// Number of trace events kept for dumping a trace
+  static constexpr std::size_t MaxTraceEvents = 1 << 16;
+
+  /// Files written on exit if profiling is enabled
+  static constexpr const char *DefaultCSVFile = "rogue_profile.csv";
+  static constexpr const char *DefaultTraceFile = "rogue_trace.json";
+
+  /// Statistics of a stage in microseconds over the recorded samples
+  struct Stats {
+    std::size_t NumSamples = 0;
+    std::uint64_t TotalCount = 0;
+    double Last = 0;
+    double Min = 0;
+    double Max = 0;
+    double Mean = 0;
+    double P50 = 0;
+    double P95 = 0;
+    double P99 = 0;
+  };
+
+  /// Records the time from construction to destruction for the given stage,
+  /// the stage name needs to outlive the timer
+  class ScopedTimer {
+  public:
+    explicit ScopedTimer(std::string_view Name,
+                         Profiler &Prof = Profiler::get());
+    ScopedTimer(const ScopedTimer &) = delete;
+    ScopedTimer &operator=(const ScopedTimer &) = delete;
+    ~ScopedTimer();
+
+  private:
+    Profiler *Prof = nullptr;
+    std::string_view Name;
+    Clock::time_point Start;
+  };
+
+public:
+  /// Returns the global profiler instance
+  static Profiler &get();
+
+  Profiler();
+
+  void setEnabled(bool Enabled);
+  bool isEnabled() const { return Enabled; }
+
+  /// Records a run of the stage with the given name
+  void record(std::string_view Name, Clock::time_point Start,
+              Clock::time_point End);
+
+  /// Returns statistics for the stage, throws if the stage is unknown
+  Stats getStats(std::string_view Name) const;
+
+  /// Returns the statistics of all stages ordered by name
+  std::vector<std::pair<std::string, Stats>> getAllStats() const;
+
+  /// Removes all recorded samples and trace events
+  void clear();
+
+  /// Dumps statistics of all stages as CSV
+  void dumpCSV(std::ostream &Out) const;
+
+  /// Dumps the recorded trace in the Chrome trace event format, can be
+  /// loaded with chrome://tracing or Perfetto
+  void dumpChromeTrace(std::ostream &Out) const;
+
+  /// Writes the CSV statistics and the Chrome trace to the given files
+  void dump(const std::filesystem::path &CSVFile,
+            const std::filesystem::path &TraceFile) const;
+
+private:
+  struct Stage {
+    std::vector<std::uint32_t> Samples;
+    std::size_t NextIdx = 0;
+    std::uint64_t TotalCount = 0;
+    std::uint32_t Last = 0;
+  };
+
+  struct TraceEvent {
+    const std::string *Name = nullptr;
+    std::uint64_t StartUs = 0;
+    std::uint32_t DurationUs = 0;
+  };
+
+  static Stats computeStats(const Stage &S);
+
+private:
+  std::atomic<bool> Enabled = false;
+  Clock::time_point Epoch;
+
+  mutable std::mutex Mutex;
+  std::map<std::string, Stage, std::less<>> Stages;
+  std::vector<TraceEvent> Trace;
+  std::size_t NextTraceIdx = 0;
+};
+
+} // namespace rogue
+
+#endif // #ifndef ROGUE_PROFILER_H
@@ -0,0 +1,29 @@
+#ifndef ROGUE_RANDOM_H
+#define ROGUE_RANDOM_H
+
+#include <cstdlib>
+#include <random>
+
+namespace rogue {
+
+/// Engine for rolls that need to be reproducible from a seed, e.g. loot rolled
+/// while generating a level. Each level has its own engine in the context of
+/// its registry, so levels can be generated on any thread.
+using RandomEngine = std::mt19937;
+
+/// Returns an engine seeded from std::rand, only to be used on the game thread
+/// for rolls that are not tied to a level
+inline RandomEngine makeGameRandomEngine() {
+  return RandomEngine(static_cast<RandomEngine::result_type>(std::rand()));
+}
+
+/// Returns the engine for the level with the given id, it only depends on the
+/// seed and the level id and not on the order levels are generated in
+inline RandomEngine makeLevelRandomEngine(unsigned Seed, int LevelId) {
+  std::seed_seq SeedSeq{Seed, static_cast<unsigned>(LevelId)};
+  return RandomEngine(SeedSeq);
+}
+
+} // namespace rogue
+
+#endif // #ifndef ROGUE_RANDOM_H
@@ -21,8 +21,8 @@ class RenderEventCollector : public EventHubConnector {
 public:
   void setEventHub(EventHub *EH) override;
   void onEntityAttackEvent(const EntityAttackEvent &E);
-  void onDetectTargetEvent(const DetectTargetEvent &E);
-  void onLostTargetEvent(const LostTargetEvent &E);
+  void onDetectTargetEvents(const EventBatch<DetectTargetEvent> &Events);
+  void onLostTargetEvents(const EventBatch<LostTargetEvent> &Events);
   void onEffectDelayEvent(const EffectDelayEvent &E);
   void onBuffAppliedEvent(const BuffAppliedEvent &E);
   void onBuffExpiredEvent(const BuffExpiredEvent &E);
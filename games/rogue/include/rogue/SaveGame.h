@@ -2,6 +2,7 @@
 #define ROGUE_SAVE_GAME_H
 
 #include <filesystem>
+#include <functional>
 #include <string>
 
 namespace rogue {
@@ -26,6 +27,9 @@ public:
   /// \param JSON True if the save game is a JSON file
   static SaveGameInfo fromSlot(unsigned SlotIdx, bool JSON);
 
+  /// Returns the save game info used for automatic saves
+  static SaveGameInfo getAutoSave();
+
   /// Path to the save game
   std::filesystem::path Path;
 
@@ -43,6 +47,16 @@ public:
   std::string getDateStr() const;
 };
 
+/// Writes the save game to a temporary file next to it, syncs it to disk and
+/// renames it over the save game. A crash while writing never leaves a
+/// partially written save game behind.
+/// \param Write Function writing the save game described by its argument
+/// \throws std::runtime_error if writing or syncing failed, the previous
+/// save game is kept in that case
+void writeSaveGameAtomically(
+    const SaveGameInfo &SGI,
+    const std::function<void(const SaveGameInfo &)> &Write);
+
 } // namespace rogue
 
 #endif // #ifndef ROGUE_SAVE_GAME_H
\ No newline at end of file
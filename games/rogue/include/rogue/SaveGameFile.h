@@ -0,0 +1,90 @@
+#ifndef ROGUE_SAVE_GAME_FILE_H
+#define ROGUE_SAVE_GAME_FILE_H
+
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace rogue {
+
+/// Kind of a chunk in a save game file
+enum class SaveGameChunk : std::uint32_t {
+  /// Marks the end of the file, written by `SaveGameWriter::finish`
+  End = 0,
+  /// Global state of the world, e.g. the player and the current level
+  World = 1,
+  /// State of a single level, the chunk index is the level index
+  Level = 2,
+};
+
+/// Writes a save game as a stream of chunks. Every chunk is written as soon
+/// as it is added, so the full save game is never held in memory at once.
+///
+/// File layout (host byte order):
+///   header: magic u32, version u32
+///   chunks: kind u32, index u32, data size u64, data
+///   end:    chunk of kind `End` with index 0 and no data
+class SaveGameWriter {
+public:
+  static constexpr std::uint32_t Magic = 0x53474f52; // "ROGS"
+  static constexpr std::uint32_t Version = 3;
+
+public:
+  /// Creates the save game file, an existing file is overwritten
+  /// \throws std::runtime_error if the file can not be created
+  explicit SaveGameWriter(const std::filesystem::path &Path);
+
+  /// Appends the chunk to the file
+  /// \throws std::runtime_error if writing failed or the writer is finished
+  void addChunk(SaveGameChunk Kind, std::uint32_t Index,
+                std::string_view Data);
+
+  /// Writes the end marker and flushes the file, a save game that was not
+  /// finished is rejected by the reader
+  void finish();
+
+private:
+  std::filesystem::path Path;
+  std::ofstream Out;
+  bool Finished = false;
+};
+
+/// Reads save games written by `SaveGameWriter`. Only the chunk headers are
+/// read when opening the file, chunk data is read on demand.
+class SaveGameReader {
+public:
+  /// Opens the save game and reads the chunk table
+  /// \throws std::runtime_error if the file is not a complete save game
+  explicit SaveGameReader(const std::filesystem::path &Path);
+
+  bool hasChunk(SaveGameChunk Kind, std::uint32_t Index) const;
+
+  /// Returns the indices of all chunks of the given kind in ascending order
+  std::vector<std::uint32_t> getChunkIndices(SaveGameChunk Kind) const;
+
+  /// Reads the data of the chunk
+  /// \throws std::out_of_range if the chunk does not exist
+  std::string readChunk(SaveGameChunk Kind, std::uint32_t Index);
+
+private:
+  struct ChunkLocation {
+    std::uint64_t Offset = 0;
+    std::uint64_t Size = 0;
+  };
+
+  using ChunkKey = std::pair<SaveGameChunk, std::uint32_t>;
+
+private:
+  std::filesystem::path Path;
+  std::ifstream In;
+  std::map<ChunkKey, ChunkLocation> Chunks;
+};
+
+} // namespace rogue
+
+#endif // #ifndef ROGUE_SAVE_GAME_FILE_H
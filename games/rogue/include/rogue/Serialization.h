@@ -1,12 +1,19 @@
 #ifndef ROGUE_SERIALIZATION_H
 #define ROGUE_SERIALIZATION_H
 
+#include <cstdint>
 #include <filesystem>
+#include <optional>
 #include <rogue/Components/Helpers.h>
 #include <rogue/Components/Items.h>
 #include <rogue/Components/Level.h>
 #include <rogue/Components/Player.h>
+#include <rogue/Components/Stats.h>
 #include <rogue/SaveGame.h>
+#include <rogue/Types.h>
+#include <string>
+#include <utility>
+#include <vector>
 
 namespace rogue {
 class Level;
@@ -48,6 +55,37 @@ struct EquipmentInfo {
   template <class Archive> void serialize(Archive &Ar) { Ar(Slots); }
 };
 
+/// State of the AI components of an entity, components the entity does not
+/// have are left untouched when applying
+struct AIInfo {
+  static AIInfo createFrom(const entt::registry &Reg, entt::entity Et);
+  void applyTo(entt::registry &Reg, entt::entity Et) const;
+  bool operator==(const AIInfo &Other) const;
+  bool operator!=(const AIInfo &Other) const { return !(*this == Other); }
+
+  bool HasWander = false;
+  unsigned WanderState = 0;
+  unsigned WanderStateDelayLeft = 0;
+
+  bool HasSearch = false;
+  unsigned SearchState = 0;
+  std::optional<std::pair<int, int>> LastTargetPos;
+  unsigned SearchDurationLeft = 0;
+
+  template <class Archive> void serialize(Archive &Ar) {
+    Ar(HasWander, WanderState, WanderStateDelayLeft, HasSearch, SearchState,
+       LastTargetPos, SearchDurationLeft);
+  }
+};
+
+/// Items dropped on the level, recreated with `createDropEntity`
+struct DropInfo {
+  std::pair<int, int> Pos = {0, 0};
+  InventoryInfo Inventory;
+
+  template <class Archive> void serialize(Archive &Ar) { Ar(Pos, Inventory); }
+};
+
 struct PlayerInfo {
   std::set<CraftingRecipeId> KnownRecipes;
 
@@ -79,6 +117,131 @@ private:
   std::map<std::size_t, PlayerInfo> PlayerInfos;
 };
 
+/// State of a freshly generated level that level snapshots are relative to.
+/// Loot is rolled from the random engine of the level, so inventories and
+/// equipment are part of the baseline like any other state.
+class LevelBaseline {
+public:
+  /// Creates the baseline, must be called before the level is updated
+  static LevelBaseline create(const Level &Lvl);
+
+  /// Returns the checksum of the map and the entities of the level, for a
+  /// freshly generated level this only depends on seed and configuration
+  static std::uint64_t computeChecksum(const Level &Lvl);
+
+public:
+  std::uint64_t getChecksum() const { return Checksum; }
+
+private:
+  friend class LevelSnapshot;
+
+  std::uint64_t Checksum = 0;
+  std::map<std::uint32_t, std::pair<int, int>> Positions;
+  std::map<std::uint32_t, StatValue> Health;
+  std::map<std::uint32_t, StatValue> Mana;
+  std::map<std::uint32_t, DoorComp> Doors;
+  std::map<std::uint32_t, bool> Looted;
+  std::map<std::uint32_t, AIInfo> AIInfos;
+
+  /// Serialized equipment and inventories, items are compared by their
+  /// serialized form as specializations are not shared between regenerated
+  /// levels
+  std::map<std::uint32_t, std::string> Equipment;
+  std::map<std::uint32_t, std::string> Inventories;
+};
+
+/// Compact state of a level that is applied on top of the regenerated level.
+/// Only what changed relative to the `LevelBaseline` is stored. Entities are
+/// identified by their entity identifier, which is stable as long as the
+/// level generation is deterministic, this is verified by a checksum when
+/// applying. Of the entities created after generation only drops are
+/// recreated, see `canRestore`. The player is not part of the snapshot, see
+/// `PlayerSnapshot`.
+class LevelSnapshot {
+public:
+  static LevelSnapshot create(const Level &Lvl, const LevelBaseline &Baseline);
+  static LevelSnapshot fromBytes(const std::string &Bytes);
+
+  /// Returns true if a snapshot restores all state of the level, false if
+  /// entities other than drops were created after generation or if any
+  /// entity besides the player has buffs
+  static bool canRestore(const Level &Lvl, const LevelBaseline &Baseline);
+
+public:
+  /// Applies the snapshot to the freshly regenerated level
+  /// \throws std::runtime_error if the level does not match the baseline
+  void apply(Level &Lvl) const;
+  std::string toBytes() const;
+
+  /// Returns true if applying the snapshot does not change the level
+  bool empty() const;
+
+  template <class Archive> void serialize(Archive &Ar) {
+    Ar(Checksum, Removed, Positions, Health, Mana, Doors, Looted, AIInfos,
+       EquipmentInfos, InventoryInfos, Drops, SeenRuns);
+  }
+
+private:
+  std::uint64_t Checksum = 0;
+
+  /// Generated entities that do not exist anymore
+  std::vector<std::uint32_t> Removed;
+
+  /// Changed values of generated entities
+  std::map<std::uint32_t, std::pair<int, int>> Positions;
+  std::map<std::uint32_t, StatValue> Health;
+  std::map<std::uint32_t, StatValue> Mana;
+  std::map<std::uint32_t, DoorComp> Doors;
+  std::map<std::uint32_t, bool> Looted;
+  std::map<std::uint32_t, AIInfo> AIInfos;
+  std::map<std::uint32_t, EquipmentInfo> EquipmentInfos;
+  std::map<std::uint32_t, InventoryInfo> InventoryInfos;
+
+  /// Drops created after generation
+  std::vector<DropInfo> Drops;
+
+  /// Tiles seen by the player, run lengths of alternating unseen and seen
+  /// tiles starting with unseen ones
+  std::vector<std::uint32_t> SeenRuns;
+};
+
+/// State of the player entity, the player is recreated from it when loading
+struct PlayerSnapshot {
+  static PlayerSnapshot create(const Level &Lvl);
+
+  /// Creates the player in the level and restores its state
+  void apply(Level &Lvl) const;
+
+  std::pair<int, int> Pos = {0, 0};
+  StatPoints Stats;
+  StatValue Health = 0;
+  StatValue Mana = 0;
+  EquipmentInfo Equipment;
+  InventoryInfo Inventory;
+  PlayerInfo Info;
+
+  template <class Archive> void serialize(Archive &Ar) {
+    Ar(Pos, Stats, Health, Mana, Equipment, Inventory, Info);
+  }
+};
+
+/// Global state of a world with multiple levels, stored next to one
+/// `LevelSnapshot` per level
+struct WorldSnapshot {
+  static WorldSnapshot fromBytes(const std::string &Bytes);
+  std::string toBytes() const;
+
+  /// Seed the levels are regenerated from
+  std::uint32_t Seed = 0;
+  std::uint32_t CurrentLevelIdx = 0;
+  std::uint32_t NumLevels = 0;
+  std::optional<PlayerSnapshot> Player;
+
+  template <class Archive> void serialize(Archive &Ar) {
+    Ar(Seed, CurrentLevelIdx, NumLevels, Player);
+  }
+};
+
 } // namespace rogue::serialize
 
 #endif // #ifndef ROGUE_SERIALIZATION_H
\ No newline at end of file
@@ -9,6 +9,7 @@ namespace rogue {
 class AgilitySystem : public System {
 public:
   using System::System;
+  std::string_view getName() const override { return "AgilitySystem"; }
   void update(UpdateType Type) override;
 };
 
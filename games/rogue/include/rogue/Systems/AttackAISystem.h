@@ -2,6 +2,7 @@
 #define ROGUE_SYSTEMS_ATTACK_AI_SYSTEM_H
 
 #include <rogue/Systems/System.h>
+#include <rogue/TimerWheel.h>
 
 namespace rogue {
 class Level;
@@ -12,10 +13,21 @@ namespace rogue {
 class AttackAISystem : public System {
 public:
   explicit AttackAISystem(Level &L);
+  ~AttackAISystem() override;
+
+  std::string_view getName() const override { return "AttackAISystem"; }
   void update(UpdateType Type) override;
 
+private:
+  void onExecutorConstruct(entt::registry &, entt::entity Entity);
+  void onExecutorDestroy(entt::registry &, entt::entity Entity);
+  void updateEffectExecutors();
+
 private:
   Level &L;
+
+  /// Wakes up effect executors once the delay to the next effect elapsed
+  TimerWheel ExecutorTimers;
 };
 
 } // namespace rogue
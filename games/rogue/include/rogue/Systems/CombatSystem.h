@@ -13,6 +13,7 @@ public:
 
 public:
   using System::System;
+  std::string_view getName() const override { return "CombatSystem"; }
   void update(UpdateType Type) override;
 };
 
@@ -8,6 +8,7 @@ namespace rogue {
 class DeathSystem : public System {
 public:
   using System::System;
+  std::string_view getName() const override { return "DeathSystem"; }
   void update(UpdateType Type) override;
 };
 
@@ -8,6 +8,7 @@ namespace rogue {
 class LOSSystem : public System {
 public:
   using System::System;
+  std::string_view getName() const override { return "LOSSystem"; }
   void update(UpdateType Type) override;
 };
 
@@ -12,6 +12,7 @@ namespace rogue {
 class MovementSystem : public System {
 public:
   explicit MovementSystem(Level &L);
+  std::string_view getName() const override { return "MovementSystem"; }
   void update(UpdateType Type) override;
 
 private:
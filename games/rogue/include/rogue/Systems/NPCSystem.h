@@ -25,6 +25,7 @@ public:
 
 public:
   explicit NPCSystem(Level &L);
+  std::string_view getName() const override { return "NPCSystem"; }
   void update(UpdateType Type) override;
 
 private:
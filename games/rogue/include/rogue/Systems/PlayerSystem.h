@@ -10,6 +10,7 @@ class Level;
 class PlayerSystem : public System {
 public:
   explicit PlayerSystem(Level &L);
+  std::string_view getName() const override { return "PlayerSystem"; }
   void update(UpdateType Type) override;
 
 private:
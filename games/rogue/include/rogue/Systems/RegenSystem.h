@@ -2,15 +2,36 @@
 #define ROGUE_SYSTEMS_REGEN_SYSTEM_H
 
 #include <rogue/Systems/System.h>
+#include <rogue/TimerWheel.h>
 
 namespace rogue {
 
+/// Regenerates health and mana periodically. Entities are scheduled on a
+/// timer wheel when their regeneration component is added, so only entities
+/// due to regenerate are updated on a tick.
 class RegenSystem : public System {
 public:
-  using System::System;
+  explicit RegenSystem(entt::registry &Reg);
+  ~RegenSystem() override;
+
+  std::string_view getName() const override { return "RegenSystem"; }
   void update(UpdateType Type) override;
+
+private:
+  template <typename RegenComp> TimerWheel &getTimers();
+  template <typename RegenComp> void connectTimers();
+  template <typename RegenComp> void disconnectTimers();
+  template <typename RegenComp>
+  void onRegenCompConstruct(entt::registry &, entt::entity Entity);
+  template <typename RegenComp>
+  void onRegenCompDestroy(entt::registry &, entt::entity Entity);
+  template <typename RegenComp> void runRegenUpdate();
+
+private:
+  TimerWheel HealthTimers;
+  TimerWheel ManaTimers;
 };
 
 } // namespace rogue
 
-#endif // #ifndef ROGUE_SYSTEMS_REGEN_SYSTEM_H
\ No newline at end of file
+#endif // #ifndef ROGUE_SYSTEMS_REGEN_SYSTEM_H
@@ -18,6 +18,7 @@ namespace rogue {
 class SearchAISystem : public System {
 public:
   explicit SearchAISystem(Level &L);
+  std::string_view getName() const override { return "SearchAISystem"; }
   void update(UpdateType Type) override;
 
 private:
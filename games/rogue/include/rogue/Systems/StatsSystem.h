@@ -1,16 +1,39 @@
 #ifndef ROGUE_SYSTEMS_STATS_SYSTEM_H
 #define ROGUE_SYSTEMS_STATS_SYSTEM_H
 
+#include <entt/entt.hpp>
 #include <rogue/Systems/System.h>
+#include <vector>
 
 namespace rogue {
 
+/// Computes the effective stats of entities and the health, mana and agility
+/// derived from them. Stats are only recomputed for entities whose stats,
+/// stats buffs or derived components were added, removed or patched since
+/// the last update, in place changes have to be published through
+/// entt::registry::patch.
 class StatsSystem : public System {
 public:
-  using System::System;
+  explicit StatsSystem(entt::registry &Reg);
+  ~StatsSystem() override;
+
+  std::string_view getName() const override { return "StatsSystem"; }
   void update(UpdateType Type) override;
+
+private:
+  template <typename... CompTypes> void connectComps();
+  template <typename... CompTypes> void disconnectComps();
+  void onStatsChanged(entt::registry &, entt::entity Entity);
+  void updateEntity(entt::entity Entity);
+
+private:
+  /// Entities whose stats have to be recomputed, may contain duplicates
+  std::vector<entt::entity> Dirty;
+
+  /// Set while recomputing to ignore changes made by the system itself
+  bool IsUpdating = false;
 };
 
 } // namespace rogue
 
-#endif // #ifndef ROGUE_SYSTEMS_STATS_SYSTEM_H
\ No newline at end of file
+#endif // #ifndef ROGUE_SYSTEMS_STATS_SYSTEM_H
@@ -3,6 +3,7 @@
 
 #include <entt/entt.hpp>
 #include <rogue/EventHub.h>
+#include <string_view>
 
 namespace rogue {
 
@@ -14,6 +15,9 @@ public:
   explicit System(entt::registry &Reg) : Reg(Reg) {}
   virtual ~System() = default;
 
+  /// Name of the system, used for profiling
+  virtual std::string_view getName() const = 0;
+
   /// Run system to update the registry
   virtual void update(UpdateType Type) = 0;
 
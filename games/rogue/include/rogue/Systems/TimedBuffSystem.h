@@ -0,0 +1,42 @@
+#ifndef ROGUE_SYSTEMS_TIMED_BUFF_SYSTEM_H
+#define ROGUE_SYSTEMS_TIMED_BUFF_SYSTEM_H
+
+#include <entt/entt.hpp>
+#include <rogue/Systems/System.h>
+#include <vector>
+
+namespace rogue {
+
+/// Ticks all timed buffs in one place and removes expired ones. Periodic
+/// effects of buffs, e.g. poison, are applied here as well while static
+/// effects, e.g. stats or line of sight, are applied by the owning systems
+/// for the buffs that are still active. Has to run before those systems.
+///
+/// Expiry is not scheduled on a TimerWheel on purpose. The remaining ticks of
+/// a buff are shown in the UI and saved with the buff, adding to a buff
+/// changes them in place, and periodic buffs have to be visited on every tick
+/// anyway. A wheel would thus neither save visits nor replace the countdowns.
+class TimedBuffSystem : public System {
+public:
+  using System::System;
+  std::string_view getName() const override { return "TimedBuffSystem"; }
+  void update(UpdateType Type) override;
+
+private:
+  template <typename BuffType, typename OnActiveFn>
+  void tickBuffs(bool EraseExpired, OnActiveFn OnActive);
+
+  template <typename BuffType> void tickBuffs(bool EraseExpired = true);
+
+  template <typename BuffType, typename ValueCompType>
+  void tickValueGenBuffs(bool Reduce);
+
+private:
+  /// Entities with expired buffs of the currently ticked type, kept to avoid
+  /// reallocating on every tick
+  std::vector<entt::entity> Expired;
+};
+
+} // namespace rogue
+
+#endif // #ifndef ROGUE_SYSTEMS_TIMED_BUFF_SYSTEM_H
@@ -18,6 +18,7 @@ namespace rogue {
 class WanderAISystem : public System {
 public:
   explicit WanderAISystem(Level &L);
+  std::string_view getName() const override { return "WanderAISystem"; }
   void update(UpdateType Type) override;
 
 private:
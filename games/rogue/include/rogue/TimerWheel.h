@@ -0,0 +1,78 @@
+#ifndef ROGUE_TIMER_WHEEL_H
+#define ROGUE_TIMER_WHEEL_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <entt/entt.hpp>
+#include <unordered_map>
+#include <vector>
+
+namespace rogue {
+
+/// Hierarchical timing wheel waking up entities after a delay in ticks.
+/// Scheduling and cancelling a timer are O(1) and advancing by a tick only
+/// touches the timers that fire or move to an inner wheel, instead of every
+/// entity counting down its own delay. An entity has at most one pending
+/// timer per wheel, scheduling it again replaces the previous timer.
+class TimerWheel {
+public:
+  using TickType = std::uint64_t;
+
+  static constexpr unsigned SlotBits = 6;
+  static constexpr std::size_t NumSlots = std::size_t(1) << SlotBits;
+  static constexpr std::size_t NumWheels = 4;
+
+public:
+  /// Wakes up the entity after the given amount of ticks, a delay of zero
+  /// wakes up the entity on the next tick
+  void schedule(entt::entity Entity, TickType Delay);
+
+  /// Cancels the pending timer of the entity if any
+  void cancel(entt::entity Entity);
+
+  bool isScheduled(entt::entity Entity) const;
+
+  /// Returns the ticks left until the entity is woken up, zero if no timer
+  /// is pending for the entity
+  TickType getTicksLeft(entt::entity Entity) const;
+
+  /// Returns the number of pending timers
+  std::size_t size() const { return Deadlines.size(); }
+
+  /// Returns the number of ticks advanced so far
+  TickType getTick() const { return Now; }
+
+  void clear();
+
+  /// Advances by one tick and returns the entities whose timer fired, the
+  /// returned entities are valid until the wheel is advanced again
+  const std::vector<entt::entity> &advance();
+
+private:
+  struct Timer {
+    entt::entity Entity;
+    TickType Deadline;
+  };
+
+  bool isPending(const Timer &T) const;
+  void insert(const Timer &T);
+  void reinsert(std::vector<Timer> &Timers);
+
+private:
+  TickType Now = 0;
+  std::array<std::array<std::vector<Timer>, NumSlots>, NumWheels> Wheels;
+
+  /// Timers beyond the range of the outermost wheel
+  std::vector<Timer> Overflow;
+
+  /// Deadlines of the pending timers, timers stored in the wheels with a
+  /// different deadline have been cancelled or replaced
+  std::unordered_map<entt::entity, TickType> Deadlines;
+
+  std::vector<entt::entity> Fired;
+};
+
+} // namespace rogue
+
+#endif // #ifndef ROGUE_TIMER_WHEEL_H
@@ -1,6 +1,7 @@
 #ifndef ROGUE_UI_CRAFTING_H
 #define ROGUE_UI_CRAFTING_H
 
+#include <cstdint>
 #include <entt/entt.hpp>
 #include <rogue/UI/Decorator.h>
 
@@ -25,10 +26,26 @@ public:
                      const CraftingHandler &Crafter);
   bool handleInput(int Char) override;
   void draw(cxxg::Screen &Scr) const final;
+  bool isDirty() const final;
+  bool isCacheable() const final { return true; }
 
   std::string getInteractMsg() const final;
 
 private:
+  /// State the list of recipes is built from, recipes are only ever learned
+  /// and the inventory decides which of them can be crafted
+  struct ModelState {
+    std::size_t NumKnownRecipes = 0;
+    std::uint64_t InventoryRevision = 0;
+
+    bool operator==(const ModelState &Other) const {
+      return NumKnownRecipes == Other.NumKnownRecipes &&
+             InventoryRevision == Other.InventoryRevision;
+    }
+  };
+
+private:
+  ModelState getModelState() const;
   const CraftingRecipe &getSelectedRecipe() const;
   void handleCreateTooltip();
   void handleCraft();
@@ -41,6 +58,7 @@ private:
   const CraftingDatabase &CraftingDb;
   const CraftingHandler &Crafter;
   std::shared_ptr<ListSelect> List;
+  mutable ModelState ShownState;
 };
 
 } // namespace rogue::ui
@@ -19,6 +19,8 @@ public:
   bool handleInput(int Char) override;
   std::string getInteractMsg() const override;
   void draw(cxxg::Screen &Scr) const override;
+  bool isDirty() const override;
+  void clearDirty() override;
 
 protected:
   std::shared_ptr<Widget> Comp;
@@ -65,6 +67,7 @@ public:
 
   bool handleInput(int Char) final;
   void draw(cxxg::Screen &Scr) const final;
+  bool isCacheable() const final;
 };
 
 } // namespace rogue::ui
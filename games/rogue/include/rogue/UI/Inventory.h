@@ -1,6 +1,7 @@
 #ifndef ROGUE_UI_INVENTORY_H
 #define ROGUE_UI_INVENTORY_H
 
+#include <cstdint>
 #include <entt/entt.hpp>
 #include <rogue/InventoryHandler.h>
 #include <rogue/ItemType.h>
@@ -32,6 +33,8 @@ public:
                           Level &Lvl, const std::string &Header);
   bool handleInput(int Char) override;
   void draw(cxxg::Screen &Scr) const final;
+  bool isDirty() const final;
+  bool isCacheable() const final { return true; }
 
   Inventory &getInventory();
   const Inventory &getInventory() const;
@@ -46,6 +49,9 @@ protected:
   Level &Lvl;
   std::shared_ptr<ListSelect> List;
   InventoryHandler InvHandler;
+
+  /// Revision of the inventory the list was last updated from
+  mutable std::uint64_t ShownRevision = 0;
 };
 
 class InventoryController : public InventoryControllerBase {
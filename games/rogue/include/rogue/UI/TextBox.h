@@ -12,6 +12,7 @@ public:
           const std::string &Text, cxxg::types::Size Padding = {2, 1});
 
   void setText(const std::string &Text);
+  void setSize(cxxg::types::Size Size) override;
 
   bool handleInput(int Char) final;
 
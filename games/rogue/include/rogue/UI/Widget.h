@@ -22,8 +22,20 @@ public:
   virtual std::string getInteractMsg() const = 0;
   virtual void draw(cxxg::Screen &Scr) const = 0;
 
+  /// Marks the widget as changed, windows that are not dirty may be redrawn
+  /// from the cached cells of their last draw
+  void markDirty() { Dirty = true; }
+  virtual bool isDirty() const { return Dirty; }
+  virtual void clearDirty() { Dirty = false; }
+
+  /// Returns true if the window may be redrawn from cached cells. Requires
+  /// that drawing paints every cell of the window's rectangle and that the
+  /// widget reports itself dirty whenever the model it shows changes.
+  virtual bool isCacheable() const { return false; }
+
 protected:
   cxxg::types::Position Pos;
+  bool Dirty = true;
 };
 
 class BaseRect : public Widget {
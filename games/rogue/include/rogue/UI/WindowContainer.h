@@ -1,6 +1,8 @@
 #ifndef ROGUE_UI_WINDOW_CONTAINER_H
 #define ROGUE_UI_WINDOW_CONTAINER_H
 
+#include <cxxg/Row.h>
+#include <map>
 #include <memory>
 #include <optional>
 #include <rogue/UI/Decorator.h>
@@ -32,6 +34,9 @@ public:
   std::string getInteractMsg() const override;
   void draw(cxxg::Screen &Scr) const override;
 
+  /// Marks all windows as dirty, forcing them to be redrawn on next draw
+  void invalidate();
+
   bool hasActiveWindow() const;
 
   template <typename T> T *getWindowOfType() const {
@@ -80,12 +85,25 @@ protected:
   bool enterMoveActiveWindow();
   void switchMoveActiveWindow(bool IsMoving);
 
+  /// Draws the window or restores it from the cache if it is not dirty and
+  /// did not change its rectangle since it was last drawn
+  void drawWindow(cxxg::Screen &Scr, Widget &Wdw) const;
+
+private:
+  /// Cached screen cells of a window from its last draw
+  struct WindowCache {
+    cxxg::types::Position Pos{};
+    cxxg::types::Size Size{};
+    std::vector<cxxg::Row> Rows;
+  };
+
 private:
   cxxg::types::Size Size;
   std::size_t FocusIdx = 0;
   std::size_t PrevFocusIdx = 0;
   std::shared_ptr<MoveDecorator> MoveDeco = nullptr;
   std::vector<std::shared_ptr<Widget>> Windows;
+  mutable std::map<const Widget *, WindowCache> Caches;
 };
 
 } // namespace rogue::ui
@@ -1,11 +1,17 @@
 #ifndef ROGUE_UI_WORD_WRAP_H
 #define ROGUE_UI_WORD_WRAP_H
 
+#include <memory>
 #include <string>
+#include <string_view>
 #include <vector>
 
 namespace rogue::ui {
 
+/// Wraps text into lines of a given width, layouts are shared through a cache
+/// keyed by the text and the line width so re-wrapping the same text (e.g.
+/// re-opening a tooltip) is free. The cache is not thread-safe and must only
+/// be used from the UI.
 class WordWrap {
 public:
   struct Interval {
@@ -14,23 +20,42 @@ public:
   };
   using LineIntervals = std::vector<Interval>;
 
+  /// Maximum number of distinct texts kept in the cache
+  static constexpr std::size_t MaxCachedTexts = 256;
+
 public:
   WordWrap(const std::string &Text, std::size_t LineWidth);
 
+  /// Re-wraps the text to the new line width, only paragraphs that do not fit
+  /// into a single line are wrapped again
+  void setLineWidth(std::size_t LineWidth);
+
   inline auto getLineWidth() const { return LineWidth; }
-  inline auto getNumLines() const { return LineIntvs.size(); }
+  inline auto getNumLines() const { return LineIntvs->size(); }
 
   inline auto getLine(std::size_t Line) const {
-    auto It = LineIntvs.at(Line);
-    return std::string_view(StrBuffer).substr(It.Start, It.End);
+    auto It = LineIntvs->at(Line);
+    return std::string_view(Layout->StrBuffer).substr(It.Start, It.End);
   }
 
+  static void clearCache();
+  static std::size_t getNumCachedTexts();
+
+public:
+  /// Text prepared for wrapping, independent of the line width
+  struct TextLayout {
+    std::string Text;
+    std::string StrBuffer;
+    /// Intervals of the text separated by new lines
+    LineIntervals Paragraphs;
+  };
+
 private:
   std::size_t LineWidth = 0;
-  LineIntervals LineIntvs;
-  std::string StrBuffer;
+  std::shared_ptr<const TextLayout> Layout;
+  std::shared_ptr<const LineIntervals> LineIntvs;
 };
 
 } // namespace rogue::ui
 
-#endif // #ifndef ROGUE_UI_WORD_WRAP_H
\ No newline at end of file
+#endif // #ifndef ROGUE_UI_WORD_WRAP_H
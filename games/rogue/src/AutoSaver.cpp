@@ -0,0 +1,89 @@
+#include <rogue/AutoSaver.h>
+
+namespace rogue {
+
+AutoSaver::AutoSaver(SaveGameInfo SGI, const AutoSaveConfig &Cfg)
+    : SGI(std::move(SGI)), Cfg(Cfg) {}
+
+AutoSaver::~AutoSaver() {
+  {
+    std::lock_guard<std::mutex> Lock(Mutex);
+    Stop = true;
+  }
+  CV.notify_all();
+  if (Worker.joinable()) {
+    Worker.join();
+  }
+}
+
+void AutoSaver::tick() {
+  if (Cfg.TickInterval != 0 && ++TicksSinceSave >= Cfg.TickInterval) {
+    Due = true;
+  }
+}
+
+void AutoSaver::levelChanged() {
+  if (Cfg.OnLevelChange) {
+    Due = true;
+  }
+}
+
+void AutoSaver::submit(WriteFn Write) {
+  Due = false;
+  TicksSinceSave = 0;
+  {
+    std::lock_guard<std::mutex> Lock(Mutex);
+    Pending = std::move(Write);
+    if (!Worker.joinable()) {
+      Worker = std::thread([this]() { run(); });
+    }
+  }
+  CV.notify_all();
+}
+
+void AutoSaver::wait() {
+  std::unique_lock<std::mutex> Lock(Mutex);
+  CV.wait(Lock, [this]() { return !Pending && !Busy; });
+}
+
+std::optional<std::string> AutoSaver::takeError() {
+  std::lock_guard<std::mutex> Lock(Mutex);
+  auto LastError = std::move(Error);
+  Error = std::nullopt;
+  return LastError;
+}
+
+void AutoSaver::run() {
+  while (true) {
+    WriteFn Write;
+    {
+      std::unique_lock<std::mutex> Lock(Mutex);
+      CV.wait(Lock, [this]() { return Stop || Pending; });
+      // Pending saves are finished before stopping
+      if (!Pending) {
+        return;
+      }
+      Write = std::move(Pending);
+      Pending = nullptr;
+      Busy = true;
+    }
+
+    std::optional<std::string> WriteError;
+    try {
+      writeSaveGameAtomically(SGI, Write);
+    } catch (const std::exception &E) {
+      WriteError = E.what();
+    }
+
+    {
+      std::lock_guard<std::mutex> Lock(Mutex);
+      Busy = false;
+      if (WriteError) {
+        Error = std::move(WriteError);
+      }
+    }
+    CV.notify_all();
+  }
+}
+
+} // namespace rogue
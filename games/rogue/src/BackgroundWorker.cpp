@@ -0,0 +1,46 @@
+#include <rogue/BackgroundWorker.h>
+
+namespace rogue {
+
+BackgroundWorker::~BackgroundWorker() {
+  std::deque<JobFn> Dropped;
+  {
+    std::lock_guard<std::mutex> Lock(Mutex);
+    Stop = true;
+    Dropped = std::move(Jobs);
+  }
+  CV.notify_all();
+  if (Worker.joinable()) {
+    Worker.join();
+  }
+}
+
+void BackgroundWorker::post(JobFn Job) {
+  {
+    std::lock_guard<std::mutex> Lock(Mutex);
+    Jobs.push_back(std::move(Job));
+    if (!Worker.joinable()) {
+      Worker = std::thread([this]() { run(); });
+    }
+  }
+  CV.notify_one();
+}
+
+void BackgroundWorker::run() {
+  while (true) {
+    JobFn Job;
+    {
+      std::unique_lock<std::mutex> Lock(Mutex);
+      CV.wait(Lock, [this]() { return Stop || !Jobs.empty(); });
+      if (Stop) {
+        return;
+      }
+      Job = std::move(Jobs.front());
+      Jobs.pop_front();
+    }
+    // The job and anything it holds is destroyed on the worker as well
+    Job();
+  }
+}
+
+} // namespace rogue
@@ -0,0 +1,273 @@
+#include <algorithm>
+#include <cstdlib>
+#include <rogue/ChunkedLevel.h>
+#include <rogue/Components/Transform.h>
+#include <rogue/Context.h>
+#include <rogue/Level.h>
+#include <rogue/PerlinNoise.h>
+#include <rogue/Serialization.h>
+#include <stdexcept>
+#include <vector>
+
+namespace rogue {
+
+namespace {
+
+const Tile DirtTile{{' ', cxxg::types::RgbColor{0, 0, 0, true, 100, 80, 50}}};
+const Tile SandTile{{' ', cxxg::types::RgbColor{0, 0, 0, true, 180, 180, 90}}};
+const Tile GreenGrassTile{
+    {' ', cxxg::types::RgbColor{0, 0, 0, true, 110, 160, 60}}};
+const Tile BrownGrassTile{
+    {' ', cxxg::types::RgbColor{0, 0, 0, true, 76, 110, 30}}};
+const Tile RockTile{{' ', cxxg::types::RgbColor{0, 0, 0, true, 140, 140, 140}}};
+const Tile WaterTile{
+    {'~', cxxg::types::RgbColor{40, 132, 191, true, 30, 110, 150}}};
+
+const Tile &getGroundTile(float Height) {
+  if (Height < 0.05) {
+    return SandTile;
+  }
+  if (Height < 0.3) {
+    return GreenGrassTile;
+  }
+  if (Height < 0.5) {
+    return BrownGrassTile;
+  }
+  if (Height < 0.65) {
+    return DirtTile;
+  }
+  return RockTile;
+}
+
+/// Division rounding towards negative infinity
+int floorDiv(int Value, int Divisor) {
+  const int Quotient = Value / Divisor;
+  return (Value % Divisor != 0 && Value < 0) ? Quotient - 1 : Quotient;
+}
+
+} // namespace
+
+NoiseChunkGenerator::NoiseChunkGenerator(const GameContext &Ctx,
+                                         const Config &Cfg)
+    : Ctx(Ctx), Cfg(Cfg) {}
+
+float NoiseChunkGenerator::getHeight(ymir::Point2d<int> Pos) const {
+  return noise3(float(Pos.X) / Cfg.Scale, float(Pos.Y) / Cfg.Scale,
+                float(Cfg.Seed), Cfg.Octaves, Cfg.Persistence,
+                Cfg.Lacunarity);
+}
+
+std::shared_ptr<Level>
+NoiseChunkGenerator::generateChunk(ymir::Rect2d<int> ChunkRect) const {
+  auto NewChunk = std::make_shared<Level>(0, ChunkRect.Size);
+
+  auto &Objects = NewChunk->Map.get(Level::LayerObjectsIdx);
+  NewChunk->Map.get(Level::LayerGroundIdx)
+      .forEach([this, &Objects, ChunkRect](auto Pos, auto &T) {
+        const auto Height = getHeight(Pos + ChunkRect.Pos);
+        T = getGroundTile(Height);
+        if (Height < 0) {
+          Objects.setTile(Pos, WaterTile);
+        }
+      });
+
+  NewChunk->Reg.ctx().emplace<GameContext>(Ctx);
+  NewChunk->Reg.ctx().emplace<Level *>(NewChunk.get());
+
+  return NewChunk;
+}
+
+ChunkedLevel::ChunkedLevel(const ChunkGenerator &Gen, const Config &Cfg)
+    : Gen(Gen), Cfg(Cfg) {
+  if (Cfg.ChunkSize.W <= 0 || Cfg.ChunkSize.H <= 0) {
+    throw std::out_of_range("ChunkedLevel: Invalid chunk size");
+  }
+  if (Cfg.LoadRadius < 0 || Cfg.EvictRadius < Cfg.LoadRadius) {
+    throw std::out_of_range("ChunkedLevel: Evict radius must not be less "
+                            "than the load radius");
+  }
+  if (Cfg.MaxChunksPerUpdate == 0) {
+    throw std::out_of_range("ChunkedLevel: Chunks per update must not be 0");
+  }
+}
+
+ChunkedLevel::~ChunkedLevel() = default;
+
+ymir::Point2d<int> ChunkedLevel::getChunkCoord(ymir::Point2d<int> Pos) const {
+  return {floorDiv(Pos.X, Cfg.ChunkSize.W), floorDiv(Pos.Y, Cfg.ChunkSize.H)};
+}
+
+ymir::Rect2d<int>
+ChunkedLevel::getChunkRect(ymir::Point2d<int> ChunkCoord) const {
+  return {{ChunkCoord.X * Cfg.ChunkSize.W, ChunkCoord.Y * Cfg.ChunkSize.H},
+          Cfg.ChunkSize};
+}
+
+bool ChunkedLevel::update(ymir::Point2d<int> FocusPos) {
+  const auto FocusChunk = getChunkCoord(FocusPos);
+  loadChunk(FocusChunk);
+
+  // Load missing chunks closest to the focus first, the remaining ones are
+  // loaded by the next updates
+  std::vector<ymir::Point2d<int>> Missing;
+  for (int Y = -Cfg.LoadRadius; Y <= Cfg.LoadRadius; ++Y) {
+    for (int X = -Cfg.LoadRadius; X <= Cfg.LoadRadius; ++X) {
+      const ymir::Point2d<int> Coord{FocusChunk.X + X, FocusChunk.Y + Y};
+      if (!Resident.count(Coord)) {
+        Missing.push_back(Coord);
+      }
+    }
+  }
+  std::stable_sort(Missing.begin(), Missing.end(),
+                   [this, FocusChunk](const auto &A, const auto &B) {
+                     return getChunkDistance(A, FocusChunk) <
+                            getChunkDistance(B, FocusChunk);
+                   });
+  const auto NumLoad = std::min(Missing.size(), Cfg.MaxChunksPerUpdate);
+  for (std::size_t Idx = 0; Idx < NumLoad; ++Idx) {
+    loadChunk(Missing[Idx]);
+  }
+
+  // The chunk with the player is kept even if the focus is somewhere else,
+  // so are chunks with state that a snapshot does not restore
+  std::vector<ymir::Point2d<int>> Far;
+  for (const auto &[Coord, Chunk] : Resident) {
+    if (getChunkDistance(Coord, FocusChunk) > Cfg.EvictRadius &&
+        Coord != PlayerChunk &&
+        serialize::LevelSnapshot::canRestore(*Chunk.Lvl, *Chunk.Baseline)) {
+      Far.push_back(Coord);
+    }
+  }
+  const auto NumEvict = std::min(Far.size(), Cfg.MaxChunksPerUpdate);
+  for (std::size_t Idx = 0; Idx < NumEvict; ++Idx) {
+    evictChunk(Far[Idx]);
+  }
+  dropEvictedChunks(FocusChunk);
+
+  return NumLoad == Missing.size();
+}
+
+Level *ChunkedLevel::getChunk(ymir::Point2d<int> ChunkCoord) {
+  auto It = Resident.find(ChunkCoord);
+  return It != Resident.end() ? It->second.Lvl.get() : nullptr;
+}
+
+const Level *ChunkedLevel::getChunk(ymir::Point2d<int> ChunkCoord) const {
+  auto It = Resident.find(ChunkCoord);
+  return It != Resident.end() ? It->second.Lvl.get() : nullptr;
+}
+
+Level &ChunkedLevel::getChunkAt(ymir::Point2d<int> Pos) {
+  return loadChunk(getChunkCoord(Pos));
+}
+
+void ChunkedLevel::createPlayer(ymir::Point2d<int> Pos) {
+  const auto Coord = getChunkCoord(Pos);
+  loadChunk(Coord).createPlayer(Pos - getChunkRect(Coord).Pos);
+  PlayerChunk = Coord;
+}
+
+void ChunkedLevel::movePlayer(ymir::Point2d<int> Pos) {
+  if (!PlayerChunk) {
+    throw std::runtime_error("ChunkedLevel: No player");
+  }
+  const auto Coord = getChunkCoord(Pos);
+  const auto ChunkPos = Pos - getChunkRect(Coord).Pos;
+
+  auto &From = *Resident.at(*PlayerChunk).Lvl;
+  if (Coord == *PlayerChunk) {
+    auto &PC = From.Reg.get<PositionComp>(From.getPlayer());
+    From.updateEntityPosition(From.getPlayer(), PC, ChunkPos);
+    return;
+  }
+  loadChunk(Coord).movePlayer(From, ChunkPos);
+  PlayerChunk = Coord;
+}
+
+std::optional<ymir::Point2d<int>> ChunkedLevel::getPlayerPos() const {
+  if (!PlayerChunk) {
+    return std::nullopt;
+  }
+  const auto &Lvl = *Resident.at(*PlayerChunk).Lvl;
+  return Lvl.Reg.get<PositionComp>(Lvl.getPlayer()).Pos +
+         getChunkRect(*PlayerChunk).Pos;
+}
+
+ymir::Map<Tile> ChunkedLevel::render(ymir::Rect2d<int> VisibleRect) const {
+  ymir::Map<Tile> RenderedMap(VisibleRect.Size);
+  for (const auto &[Coord, Chunk] : Resident) {
+    const auto ChunkRect = getChunkRect(Coord);
+    auto ChunkVisibleRect = VisibleRect & ChunkRect;
+    if (ChunkVisibleRect.Size == ymir::Size2d<int>{0, 0}) {
+      continue;
+    }
+    ChunkVisibleRect.Pos -= ChunkRect.Pos;
+
+    const auto ChunkOffset = ChunkRect.Pos - VisibleRect.Pos;
+    Chunk.Lvl->Map.render().forEach(
+        [ChunkOffset, &RenderedMap](auto Pos, auto T) {
+          RenderedMap.setTile(Pos + ChunkOffset, T);
+        },
+        ChunkVisibleRect);
+  }
+  return RenderedMap;
+}
+
+ChunkedLevel::MemoryStats ChunkedLevel::getMemoryStats() const {
+  MemoryStats Stats;
+  Stats.NumResident = Resident.size();
+  for (const auto &[Coord, Chunk] : Resident) {
+    Stats.ResidentBytes += Chunk.Lvl->getMemoryUsage();
+  }
+  Stats.NumEvicted = Evicted.size();
+  for (const auto &[Coord, Snapshot] : Evicted) {
+    Stats.EvictedBytes += Snapshot.size();
+  }
+  return Stats;
+}
+
+Level &ChunkedLevel::loadChunk(ymir::Point2d<int> ChunkCoord) {
+  if (auto It = Resident.find(ChunkCoord); It != Resident.end()) {
+    return *It->second.Lvl;
+  }
+
+  ResidentChunk Chunk;
+  Chunk.Lvl = Gen.generateChunk(getChunkRect(ChunkCoord));
+  Chunk.Baseline = std::make_shared<serialize::LevelBaseline>(
+      serialize::LevelBaseline::create(*Chunk.Lvl));
+  if (auto It = Evicted.find(ChunkCoord); It != Evicted.end()) {
+    serialize::LevelSnapshot::fromBytes(It->second).apply(*Chunk.Lvl);
+    Evicted.erase(It);
+  }
+  return *Resident.emplace(ChunkCoord, std::move(Chunk)).first->second.Lvl;
+}
+
+void ChunkedLevel::evictChunk(ymir::Point2d<int> ChunkCoord) {
+  auto It = Resident.find(ChunkCoord);
+  const auto Snapshot =
+      serialize::LevelSnapshot::create(*It->second.Lvl, *It->second.Baseline);
+  if (!Snapshot.empty()) {
+    Evicted[ChunkCoord] = Snapshot.toBytes();
+  }
+  Resident.erase(It);
+}
+
+void ChunkedLevel::dropEvictedChunks(ymir::Point2d<int> FocusChunk) {
+  // Changes far away from the focus are the least likely to be visited again
+  while (Evicted.size() > Cfg.MaxEvictedChunks) {
+    auto Farthest = std::max_element(
+        Evicted.begin(), Evicted.end(),
+        [this, FocusChunk](const auto &A, const auto &B) {
+          return getChunkDistance(A.first, FocusChunk) <
+                 getChunkDistance(B.first, FocusChunk);
+        });
+    Evicted.erase(Farthest);
+  }
+}
+
+int ChunkedLevel::getChunkDistance(ymir::Point2d<int> A,
+                                   ymir::Point2d<int> B) const {
+  return std::max(std::abs(A.X - B.X), std::abs(A.Y - B.Y));
+}
+
+} // namespace rogue
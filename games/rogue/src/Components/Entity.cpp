@@ -36,6 +36,7 @@ void createDropEntity(entt::registry &Reg, ymir::Point2d<int> Pos,
                          }});
 
   Reg.emplace<VisibleComp>(Entity);
+  Reg.emplace<DropComp>(Entity);
 }
 
 entt::entity createTempDamage(entt::registry &Reg, const DamageComp &DC,
@@ -4,45 +4,12 @@
 
 namespace rogue {
 
-static const std::optional<CraftingNode::CraftingResult> EmptyResult;
-
-const std::optional<CraftingNode::CraftingResult> &
-CraftingNode::search(const std::vector<Item> &Items) const {
-  if (Items.empty()) {
-    return EmptyResult;
-  }
-
-  const CraftingNode *Node = this;
-  for (auto &It : Items) {
-    auto ItNode = Node->Children.find(It.getId());
-    if (ItNode == Node->Children.end()) {
-      return EmptyResult;
-    }
-    Node = &ItNode->second;
-  }
-
-  return Node->Result;
-}
-
 CraftingHandler::CraftingHandler(const ItemDatabase &ItemDb)
     : ItemDb(&ItemDb) {}
 
 void CraftingHandler::addRecipe(CraftingRecipeId RecipeId,
                                 const CraftingRecipe &Recipe) {
-  if (Recipe.getResultItems().empty() || Recipe.getRequiredItems().empty()) {
-    throw std::runtime_error("CraftingHandler::addRecipe: Empty recipe");
-  }
-
-  CraftingNode *Node = &Tree;
-  for (auto &Id : Recipe.getRequiredItems()) {
-    Node = &Node->Children[Id];
-  }
-
-  if (Node->Result) {
-    throw std::runtime_error("CraftingHandler::addRecipe: Duplicate recipe");
-  }
-  Node->Result =
-      CraftingNode::CraftingResult{RecipeId, Recipe.getResultItems()};
+  Recipes.addRecipe(RecipeId, Recipe);
 }
 
 const ItemDatabase *CraftingHandler::getItemDb() const { return ItemDb; }
@@ -54,11 +21,10 @@ const ItemDatabase &CraftingHandler::getItemDbOrFail() const {
   return *ItemDb;
 }
 
-const std::optional<CraftingNode::CraftingResult> &
-CraftingHandler::getCraftingRecipeResultOrNone(
+const CraftingResult *CraftingHandler::getCraftingRecipeResultOrNone(
     const std::vector<Item> &Items) const {
   if (Items.size() < 2) {
-    return EmptyResult;
+    return nullptr;
   }
   auto &First = Items.at(0);
   auto &Second = Items.at(1);
@@ -67,10 +33,20 @@ CraftingHandler::getCraftingRecipeResultOrNone(
   // otherwise it's a modification of an item or invalid combination
   if (!(First.getType() & (ItemType::Crafting | ItemType::CraftingBase)) ||
       !(Second.getType() & ItemType::Crafting)) {
-    return EmptyResult;
+    return nullptr;
+  }
+
+  std::vector<ItemProtoId> ItemIds;
+  ItemIds.reserve(Items.size());
+  for (const auto &It : Items) {
+    ItemIds.push_back(It.getId());
   }
+  return Recipes.findRecipe(ItemIds);
+}
 
-  return Tree.search(Items);
+std::vector<CraftingRecipeId> CraftingHandler::getCraftableRecipes(
+    const CraftingRecipeIndex::ItemCounts &Counts) const {
+  return Recipes.getCraftableRecipes(Counts);
 }
 
 std::optional<std::vector<Item>>
@@ -110,7 +86,7 @@ CraftingHandler::tryCraft(const std::vector<Item> &Items) const {
 
 std::optional<std::vector<Item>>
 CraftingHandler::tryCraftAsRecipe(const std::vector<Item> &Items) const {
-  auto Result = getCraftingRecipeResultOrNone(Items);
+  const auto *Result = getCraftingRecipeResultOrNone(Items);
   if (!Result) {
     return std::nullopt;
   }
@@ -0,0 +1,147 @@
+#include <algorithm>
+#include <rogue/CraftingDatabase.h>
+#include <rogue/CraftingRecipeIndex.h>
+#include <stdexcept>
+
+namespace rogue {
+
+void CraftingRecipeIndex::addRecipe(CraftingRecipeId RecipeId,
+                                    const CraftingRecipe &Recipe) {
+  if (Recipe.getResultItems().empty() || Recipe.getRequiredItems().empty()) {
+    throw std::runtime_error("CraftingRecipeIndex::addRecipe: Empty recipe");
+  }
+  if (findRecipe(Recipe.getRequiredItems())) {
+    throw std::runtime_error(
+        "CraftingRecipeIndex::addRecipe: Duplicate recipe");
+  }
+
+  const auto ResultIdx = static_cast<std::uint32_t>(Results.size());
+  Results.push_back({RecipeId, Recipe.getResultItems()});
+  OrderedNodes.at(getOrAddNode(OrderedNodes, Recipe.getRequiredItems()))
+      .Recipe = ResultIdx;
+
+  auto SortedItems = Recipe.getRequiredItems();
+  std::sort(SortedItems.begin(), SortedItems.end());
+  auto &SortedNode = SortedNodes.at(getOrAddNode(SortedNodes, SortedItems));
+  SortedLinks.push_back({ResultIdx, SortedNode.Recipe});
+  SortedNode.Recipe = static_cast<std::uint32_t>(SortedLinks.size() - 1);
+}
+
+const CraftingResult *
+CraftingRecipeIndex::findRecipe(const std::vector<ItemProtoId> &Items) const {
+  const auto NodeIdx = findNode(OrderedNodes, Items);
+  if (NodeIdx == None || OrderedNodes[NodeIdx].Recipe == None) {
+    return nullptr;
+  }
+  return &Results[OrderedNodes[NodeIdx].Recipe];
+}
+
+std::vector<CraftingRecipeId>
+CraftingRecipeIndex::findRecipesAnyOrder(std::vector<ItemProtoId> Items) const {
+  std::sort(Items.begin(), Items.end());
+  const auto NodeIdx = findNode(SortedNodes, Items);
+  if (NodeIdx == None) {
+    return {};
+  }
+  return getLinkedRecipes(SortedNodes[NodeIdx].Recipe);
+}
+
+std::vector<CraftingRecipeId>
+CraftingRecipeIndex::getCraftableRecipes(const ItemCounts &Counts) const {
+  // Items along a path of the sorted tree are ordered, so the count required
+  // of an item is the length of the run of the item ending at the node
+  struct Visit {
+    std::uint32_t NodeIdx;
+    ItemProtoId RunItemId;
+    unsigned RunLength;
+  };
+
+  std::vector<CraftingRecipeId> Craftable;
+  std::vector<Visit> Visits = {{0, ItemProtoId(), 0}};
+  while (!Visits.empty()) {
+    const auto V = Visits.back();
+    Visits.pop_back();
+
+    const auto &N = SortedNodes[V.NodeIdx];
+    for (auto Link = N.Recipe; Link != None; Link = SortedLinks[Link].Next) {
+      Craftable.push_back(Results[SortedLinks[Link].Result].RecipeId);
+    }
+
+    for (auto Child = N.FirstChild; Child != None;
+         Child = SortedNodes[Child].NextSibling) {
+      const auto ItemId = SortedNodes[Child].ItemId;
+      const auto Required = (ItemId == V.RunItemId ? V.RunLength : 0) + 1;
+      auto It = Counts.find(ItemId);
+      if (It != Counts.end() && It->second >= Required) {
+        Visits.push_back({Child, ItemId, Required});
+      }
+    }
+  }
+
+  std::sort(Craftable.begin(), Craftable.end());
+  return Craftable;
+}
+
+std::uint32_t
+CraftingRecipeIndex::findNode(const std::vector<Node> &Nodes,
+                              const std::vector<ItemProtoId> &Items) {
+  if (Items.empty()) {
+    return None;
+  }
+  std::uint32_t NodeIdx = 0;
+  for (const auto &ItemId : Items) {
+    auto Child = Nodes[NodeIdx].FirstChild;
+    while (Child != None && Nodes[Child].ItemId < ItemId) {
+      Child = Nodes[Child].NextSibling;
+    }
+    if (Child == None || Nodes[Child].ItemId != ItemId) {
+      return None;
+    }
+    NodeIdx = Child;
+  }
+  return NodeIdx;
+}
+
+std::uint32_t
+CraftingRecipeIndex::getOrAddNode(std::vector<Node> &Nodes,
+                                  const std::vector<ItemProtoId> &Items) {
+  std::uint32_t NodeIdx = 0;
+  for (const auto &ItemId : Items) {
+    // Find the insert position keeping the siblings ordered by item id
+    auto Prev = None;
+    auto Child = Nodes[NodeIdx].FirstChild;
+    while (Child != None && Nodes[Child].ItemId < ItemId) {
+      Prev = Child;
+      Child = Nodes[Child].NextSibling;
+    }
+    if (Child != None && Nodes[Child].ItemId == ItemId) {
+      NodeIdx = Child;
+      continue;
+    }
+
+    const auto NewIdx = static_cast<std::uint32_t>(Nodes.size());
+    Node NewNode;
+    NewNode.ItemId = ItemId;
+    NewNode.NextSibling = Child;
+    Nodes.push_back(NewNode);
+    if (Prev == None) {
+      Nodes[NodeIdx].FirstChild = NewIdx;
+    } else {
+      Nodes[Prev].NextSibling = NewIdx;
+    }
+    NodeIdx = NewIdx;
+  }
+  return NodeIdx;
+}
+
+std::vector<CraftingRecipeId>
+CraftingRecipeIndex::getLinkedRecipes(std::uint32_t Link) const {
+  std::vector<CraftingRecipeId> RecipeIds;
+  for (; Link != None; Link = SortedLinks[Link].Next) {
+    RecipeIds.push_back(Results[SortedLinks[Link].Result].RecipeId);
+  }
+  std::sort(RecipeIds.begin(), RecipeIds.end());
+  return RecipeIds;
+}
+
+} // namespace rogue
@@ -0,0 +1,240 @@
+#include <cstring>
+#include <fstream>
+#include <mutex>
+#include <rogue/DataBundle.h>
+#include <stdexcept>
+#include <vector>
+
+namespace rogue {
+
+namespace {
+
+struct BundleHeader {
+  std::uint32_t Magic = 0;
+  std::uint32_t Version = 0;
+  std::uint32_t NumEntries = 0;
+  std::uint32_t Reserved = 0;
+};
+
+template <typename T> void writeValue(std::ostream &Out, const T &Value) {
+  Out.write(reinterpret_cast<const char *>(&Value), sizeof(T));
+}
+
+template <typename T>
+T readValue(const std::string &Buffer, std::size_t &Pos,
+            const std::filesystem::path &File) {
+  if (Buffer.size() - Pos < sizeof(T)) {
+    throw std::runtime_error("DataBundle::read: Truncated bundle: " +
+                             File.string());
+  }
+  T Value;
+  std::memcpy(&Value, Buffer.data() + Pos, sizeof(T));
+  Pos += sizeof(T);
+  return Value;
+}
+
+std::string readString(const std::string &Buffer, std::size_t &Pos,
+                       const std::filesystem::path &File) {
+  const auto Size = readValue<std::uint32_t>(Buffer, Pos, File);
+  if (Buffer.size() - Pos < Size) {
+    throw std::runtime_error("DataBundle::read: Truncated bundle: " +
+                             File.string());
+  }
+  std::string Str(Buffer.data() + Pos, Size);
+  Pos += Size;
+  return Str;
+}
+
+void writeString(std::ostream &Out, const std::string &Str) {
+  writeValue(Out, static_cast<std::uint32_t>(Str.size()));
+  Out.write(Str.data(), Str.size());
+}
+
+std::filesystem::path normalizePath(const std::filesystem::path &Path) {
+  return std::filesystem::absolute(Path).lexically_normal();
+}
+
+std::mutex ActiveBundleMutex;
+std::shared_ptr<const DataBundle> ActiveBundle;
+
+} // namespace
+
+std::optional<DataBundle::FileStamp>
+DataBundle::getFileStamp(const std::filesystem::path &File) {
+  std::error_code EC;
+  const auto Size = std::filesystem::file_size(File, EC);
+  if (EC) {
+    return std::nullopt;
+  }
+  const auto WriteTime = std::filesystem::last_write_time(File, EC);
+  if (EC) {
+    return std::nullopt;
+  }
+  FileStamp Stamp;
+  Stamp.Size = Size;
+  Stamp.WriteTime =
+      static_cast<std::int64_t>(WriteTime.time_since_epoch().count());
+  return Stamp;
+}
+
+DataBundle DataBundle::read(const std::filesystem::path &BundleFile) {
+  std::ifstream In(BundleFile, std::ios::binary | std::ios::ate);
+  if (!In) {
+    throw std::runtime_error("DataBundle::read: Could not open file: " +
+                             BundleFile.string());
+  }
+
+  // Read the whole bundle with a single read, entries are views into it
+  DataBundle Bundle(BundleFile.parent_path());
+  Bundle.Data.resize(static_cast<std::size_t>(In.tellg()));
+  In.seekg(0);
+  In.read(Bundle.Data.data(), Bundle.Data.size());
+  if (!In) {
+    throw std::runtime_error("DataBundle::read: Could not read file: " +
+                             BundleFile.string());
+  }
+
+  std::size_t Pos = 0;
+  const auto Header = readValue<BundleHeader>(Bundle.Data, Pos, BundleFile);
+  if (Header.Magic != Magic) {
+    throw std::runtime_error("DataBundle::read: Not a data bundle: " +
+                             BundleFile.string());
+  }
+  if (Header.Version != Version) {
+    throw std::runtime_error("DataBundle::read: Unsupported version " +
+                             std::to_string(Header.Version) + " of bundle: " +
+                             BundleFile.string());
+  }
+
+  std::vector<std::pair<std::string, Entry>> Entries;
+  Entries.reserve(Header.NumEntries);
+  for (std::uint32_t Idx = 0; Idx < Header.NumEntries; ++Idx) {
+    auto Name = readString(Bundle.Data, Pos, BundleFile);
+    Entry E;
+    E.Offset = readValue<std::uint64_t>(Bundle.Data, Pos, BundleFile);
+    E.Size = readValue<std::uint64_t>(Bundle.Data, Pos, BundleFile);
+    E.Source = readValue<FileStamp>(Bundle.Data, Pos, BundleFile);
+    E.SchemaKey = readString(Bundle.Data, Pos, BundleFile);
+    E.Schema = readValue<FileStamp>(Bundle.Data, Pos, BundleFile);
+    Entries.emplace_back(std::move(Name), E);
+  }
+
+  // Make offsets relative to the start of the buffer
+  const auto DataStart = Pos;
+  for (auto &[Name, E] : Entries) {
+    if (E.Offset > Bundle.Data.size() - DataStart ||
+        E.Size > Bundle.Data.size() - DataStart - E.Offset) {
+      throw std::runtime_error("DataBundle::read: Invalid entry '" + Name +
+                               "' in bundle: " + BundleFile.string());
+    }
+    E.Offset += DataStart;
+    Bundle.Entries.emplace(std::move(Name), E);
+  }
+
+  return Bundle;
+}
+
+void DataBundle::setActive(std::shared_ptr<const DataBundle> Bundle) {
+  std::lock_guard<std::mutex> Lock(ActiveBundleMutex);
+  ActiveBundle = std::move(Bundle);
+}
+
+std::shared_ptr<const DataBundle> DataBundle::getActive() {
+  std::lock_guard<std::mutex> Lock(ActiveBundleMutex);
+  return ActiveBundle;
+}
+
+DataBundle::DataBundle(const std::filesystem::path &RootDir)
+    : RootDir(normalizePath(RootDir)) {}
+
+void DataBundle::add(const std::filesystem::path &File,
+                     std::string_view FileData,
+                     const std::filesystem::path *SchemaPath) {
+  Entry E;
+  auto Source = getFileStamp(File);
+  if (!Source) {
+    throw std::runtime_error("DataBundle::add: Could not stat file: " +
+                             File.string());
+  }
+  E.Source = *Source;
+  if (SchemaPath) {
+    auto Schema = getFileStamp(*SchemaPath);
+    if (!Schema) {
+      throw std::runtime_error("DataBundle::add: Could not stat schema: " +
+                               SchemaPath->string());
+    }
+    E.SchemaKey = getKey(*SchemaPath);
+    E.Schema = *Schema;
+  }
+  E.Offset = Data.size();
+  E.Size = FileData.size();
+  Data.append(FileData);
+  Entries[getKey(File)] = std::move(E);
+}
+
+std::optional<std::string_view>
+DataBundle::getOrNull(const std::filesystem::path &File) const {
+  auto It = Entries.find(getKey(File));
+  if (It == Entries.end()) {
+    return std::nullopt;
+  }
+  return std::string_view(Data).substr(It->second.Offset, It->second.Size);
+}
+
+std::optional<std::string_view>
+DataBundle::getIfCurrent(const std::filesystem::path &File,
+                         const std::filesystem::path *SchemaPath) const {
+  auto It = Entries.find(getKey(File));
+  if (It == Entries.end()) {
+    return std::nullopt;
+  }
+  const auto &E = It->second;
+  if (getFileStamp(File) != E.Source) {
+    return std::nullopt;
+  }
+  if (SchemaPath && (E.SchemaKey != getKey(*SchemaPath) ||
+                     getFileStamp(*SchemaPath) != E.Schema)) {
+    return std::nullopt;
+  }
+  return std::string_view(Data).substr(E.Offset, E.Size);
+}
+
+void DataBundle::write(const std::filesystem::path &BundleFile) const {
+  std::ofstream Out(BundleFile, std::ios::binary);
+  if (!Out) {
+    throw std::runtime_error("DataBundle::write: Could not open file: " +
+                             BundleFile.string());
+  }
+
+  BundleHeader Header;
+  Header.Magic = Magic;
+  Header.Version = Version;
+  Header.NumEntries = static_cast<std::uint32_t>(Entries.size());
+  writeValue(Out, Header);
+
+  // Data of replaced entries is dropped by writing entries back to back
+  std::uint64_t Offset = 0;
+  for (const auto &[Name, E] : Entries) {
+    writeString(Out, Name);
+    writeValue(Out, Offset);
+    writeValue(Out, E.Size);
+    writeValue(Out, E.Source);
+    writeString(Out, E.SchemaKey);
+    writeValue(Out, E.Schema);
+    Offset += E.Size;
+  }
+  for (const auto &[Name, E] : Entries) {
+    Out.write(Data.data() + E.Offset, E.Size);
+  }
+
+  if (!Out) {
+    throw std::runtime_error("DataBundle::write: Could not write file: " +
+                             BundleFile.string());
+  }
+}
+
+std::string DataBundle::getKey(const std::filesystem::path &File) const {
+  return normalizePath(File).lexically_relative(RootDir).generic_string();
+}
+
+} // namespace rogue
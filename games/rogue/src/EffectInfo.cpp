@@ -134,4 +134,56 @@ std::ostream &operator<<(std::ostream &OS, const EffectInfo &Info) {
   return OS;
 }
 
+EffectIndex::EffectIndex(const std::vector<EffectInfo> &Effects) {
+  static_assert(CapabilityFlags::Skill == 1 << (NumFlags - 1),
+                "Number of capability flags changed");
+  if (Effects.size() > MaxEffects) {
+    throw std::out_of_range("EffectIndex: Too many effects: " +
+                            std::to_string(Effects.size()));
+  }
+
+  for (std::size_t Idx = 0; Idx < Effects.size(); ++Idx) {
+    const auto &Info = Effects[Idx];
+    const MaskType Bit = MaskType(1) << Idx;
+    AllFlags = AllFlags | Info.Attributes.Flags;
+    AllEffects |= Bit;
+    if (dynamic_cast<const NullEffect *>(Info.Effect.get())) {
+      NullEffects |= Bit;
+    }
+    if (dynamic_cast<const RemoveEffectBase *>(Info.Effect.get())) {
+      RemoveEffects |= Bit;
+    }
+    for (std::size_t Flag = 0; Flag < NumFlags; ++Flag) {
+      if (Info.Attributes.Flags & (1 << Flag)) {
+        FlagEffects[Flag] |= Bit;
+      }
+    }
+  }
+}
+
+EffectIndex::MaskType EffectIndex::getEffectMask(CapabilityFlags Flags) const {
+  if (int(Flags) >> NumFlags) {
+    return 0;
+  }
+  auto Mask = AllEffects;
+  for (std::size_t Flag = 0; Flag < NumFlags; ++Flag) {
+    if (Flags & (1 << Flag)) {
+      Mask &= FlagEffects[Flag];
+    }
+  }
+  return Mask;
+}
+
+bool EffectIndex::hasEffect(CapabilityFlags Flags, bool AllowNull,
+                            bool AllowRemove) const {
+  auto Mask = getEffectMask(Flags);
+  if (!AllowNull) {
+    Mask &= ~NullEffects;
+  }
+  if (!AllowRemove) {
+    Mask &= ~RemoveEffects;
+  }
+  return Mask != 0;
+}
+
 } // namespace rogue
\ No newline at end of file
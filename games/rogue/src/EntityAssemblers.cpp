@@ -6,6 +6,7 @@
 #include <rogue/InventoryHandler.h>
 #include <rogue/ItemDatabase.h>
 #include <rogue/ItemEffectImpl.h>
+#include <rogue/Random.h>
 
 namespace rogue {
 
@@ -52,13 +53,13 @@ namespace {
 
 Inventory generateLootInventory(const ItemDatabase &ItemDb,
                                 const std::string &LootTable,
-                                unsigned MaxStackSize) {
+                                unsigned MaxStackSize, RandomEngine &Rng) {
   const auto &LtCt = ItemDb.getLootTable(LootTable);
-  auto Loot = LtCt->generateLoot();
+  auto Loot = LtCt->generateLoot(Rng);
 
   Inventory Inv(MaxStackSize);
   for (const auto &Rw : Loot) {
-    auto It = ItemDb.createItem(Rw.ItId, Rw.Count);
+    auto It = ItemDb.createItem(Rw.ItId, Rw.Count, Rng);
     Inv.addItem(It);
   }
   return Inv;
@@ -68,8 +69,16 @@ Inventory generateLootInventory(const ItemDatabase &ItemDb,
 
 void InventoryCompAssembler::assemble(entt::registry &Reg,
                                       entt::entity Entity) const {
-  auto Inv = generateLootInventory(ItemDb, LootTable, MaxStackSize);
-  Reg.emplace<InventoryComp>(Entity, Inv);
+  // Generated levels provide their own engine, so that the loot only depends
+  // on the seed of the level and levels can be generated on any thread
+  if (auto *Rng = Reg.ctx().find<RandomEngine>()) {
+    Reg.emplace<InventoryComp>(
+        Entity, generateLootInventory(ItemDb, LootTable, MaxStackSize, *Rng));
+    return;
+  }
+  auto Rng = makeGameRandomEngine();
+  Reg.emplace<InventoryComp>(
+      Entity, generateLootInventory(ItemDb, LootTable, MaxStackSize, Rng));
 }
 
 bool AutoEquipAssembler::isPostProcess() const { return true; }
@@ -171,6 +180,7 @@ WorldEntryInteractableCompAssembler::WorldEntryInteractableCompAssembler(
 
 void WorldEntryInteractableCompAssembler::assemble(entt::registry &Reg,
                                                    entt::entity Entity) const {
+  Reg.emplace_or_replace<WorldEntryComp>(Entity, LevelName);
   auto &ITC = Reg.get_or_emplace<InteractableComp>(Entity);
   ITC.Actions.push_back(
       {"Enter Dungeon", [this, Entity](auto &EHC, auto SrcEt, auto &) {
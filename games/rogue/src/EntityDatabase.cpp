@@ -57,6 +57,36 @@ EntityTemplateInfo::getOrNull(const std::string &Name) const {
   return It->second.get();
 }
 
+void EntityAssembler::reserve(entt::registry &, std::size_t) const {}
+
+void EntityAssembler::assembleBatch(entt::registry &Reg,
+                                    const entt::entity *Entities,
+                                    std::size_t Count) const {
+  for (std::size_t Idx = 0; Idx < Count; ++Idx) {
+    assemble(Reg, Entities[Idx]);
+  }
+}
+
+EntityPrototype EntityPrototype::compile(const EntityTemplateInfo &Info) {
+  EntityPrototype Proto;
+  Proto.DisplayName = Info.getDisplayName();
+  Proto.Description = Info.getDescription();
+  Proto.Assemblers.reserve(Info.Assemblers.size());
+
+  // Post-process assemblers run after all other assemblers
+  for (const auto &[AsmNm, Assembler] : Info.Assemblers) {
+    if (!Assembler->isPostProcess()) {
+      Proto.Assemblers.push_back(Assembler);
+    }
+  }
+  for (const auto &[AsmNm, Assembler] : Info.Assemblers) {
+    if (Assembler->isPostProcess()) {
+      Proto.Assemblers.push_back(Assembler);
+    }
+  }
+  return Proto;
+}
+
 void EntityAssemblerCache::add(
     const std::string &Name,
     const std::shared_ptr<EntityAssembler> &Assembler) {
@@ -397,6 +427,7 @@ void EntityDatabase::addEntityTemplate(EntityTemplateInfo EntityTemplateInfo) {
   EntityTemplateInfo.Id = EntityTemplateId(EntityTemplateInfos.size());
   EntityTemplateIdsByName.emplace(EntityTemplateInfo.Name,
                                   EntityTemplateInfo.Id);
+  Prototypes.push_back(EntityPrototype::compile(EntityTemplateInfo));
   EntityTemplateInfos.emplace_back(std::move(EntityTemplateInfo));
 }
 
@@ -414,6 +445,14 @@ EntityDatabase::getEntityTemplate(EntityTemplateId Id) const {
   return EntityTemplateInfos[Id];
 }
 
+const EntityPrototype &EntityDatabase::getPrototype(EntityTemplateId Id) const {
+  if (Id >= Prototypes.size()) {
+    throw std::out_of_range("Unknown entity template id: " +
+                            std::to_string(Id));
+  }
+  return Prototypes[Id];
+}
+
 EntityFactory::EntityFactory(entt::registry &Reg,
                              const EntityDatabase &EntityDb)
     : Reg(Reg), EntityDb(EntityDb) {}
@@ -421,34 +460,64 @@ EntityFactory::EntityFactory(entt::registry &Reg,
 entt::registry &EntityFactory::getRegistry() { return Reg; }
 
 entt::entity EntityFactory::createEntity(EntityTemplateId Id) const {
+  const auto &Proto = EntityDb.getPrototype(Id);
   auto Entity = Reg.create();
-  auto &EtTmpl = EntityDb.getEntityTemplate(Id);
 
-  Reg.emplace<NameComp>(Entity, EtTmpl.getDisplayName(),
-                        EtTmpl.getDescription());
+  Reg.emplace<NameComp>(Entity, Proto.DisplayName, Proto.Description);
 
   // Assemble entity
   try {
-    for (auto &[AsmNm, Assembler] : EtTmpl.Assemblers) {
-      if (Assembler->isPostProcess()) {
-        continue;
-      }
+    for (const auto &Assembler : Proto.Assemblers) {
       Assembler->assemble(Reg, Entity);
     }
+  } catch (const std::exception &E) {
+    throw std::runtime_error(
+        "Failed to assemble entity: " +
+        EntityDb.getEntityTemplate(Id).Name + " -> " + std::string(E.what()));
+  }
 
-    // Run post-process assemblers
-    for (auto &[AsmNm, Assembler] : EtTmpl.Assemblers) {
-      if (!Assembler->isPostProcess()) {
-        continue;
-      }
-      Assembler->assemble(Reg, Entity);
+  return Entity;
+}
+
+std::vector<entt::entity>
+EntityFactory::createEntities(EntityTemplateId Id, std::size_t Count) const {
+  const auto &Proto = EntityDb.getPrototype(Id);
+  std::vector<entt::entity> Entities(Count);
+  if (Count == 0) {
+    return Entities;
+  }
+  Reg.create(Entities.begin(), Entities.end());
+
+  Reg.insert<NameComp>(Entities.begin(), Entities.end(),
+                       NameComp{Proto.DisplayName, Proto.Description});
+
+  // Assemble all entities one assembler at a time
+  try {
+    for (const auto &Assembler : Proto.Assemblers) {
+      Assembler->reserve(Reg, Count);
+    }
+    for (const auto &Assembler : Proto.Assemblers) {
+      Assembler->assembleBatch(Reg, Entities.data(), Count);
     }
   } catch (const std::exception &E) {
-    throw std::runtime_error("Failed to assemble entity: " + EtTmpl.Name +
-                             " -> " + std::string(E.what()));
+    throw std::runtime_error(
+        "Failed to assemble entity: " +
+        EntityDb.getEntityTemplate(Id).Name + " -> " + std::string(E.what()));
   }
 
-  return Entity;
+  return Entities;
+}
+
+std::vector<entt::entity> EntityFactory::createEntities(
+    EntityTemplateId Id,
+    const std::vector<ymir::Point2d<int>> &Positions) const {
+  auto Entities = createEntities(Id, Positions.size());
+  for (std::size_t Idx = 0; Idx < Entities.size(); ++Idx) {
+    if (auto *PC = Reg.try_get<PositionComp>(Entities[Idx])) {
+      PC->Pos = Positions[Idx];
+    }
+  }
+  return Entities;
 }
 
 } // namespace rogue
\ No newline at end of file
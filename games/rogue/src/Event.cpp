@@ -6,7 +6,7 @@ namespace rogue {
 namespace {
 
 bool isValidAndPlayer(const entt::registry *Reg, entt::entity Entity) {
-  if (!Reg || Entity == entt::null) {
+  if (!Reg || !Reg->valid(Entity)) {
     return false;
   }
   return Reg->try_get<PlayerComp>(Entity) != nullptr;
@@ -2,6 +2,7 @@
 #include <cxxg/Screen.h>
 #include <cxxg/Types.h>
 #include <cxxg/Utils.h>
+#include <iomanip>
 #include <memory>
 #include <rogue/Components/Combat.h>
 #include <rogue/Components/Items.h>
@@ -13,6 +14,7 @@
 #include <rogue/Game.h>
 #include <rogue/GameConfig.h>
 #include <rogue/InventoryHandler.h>
+#include <rogue/Profiler.h>
 #include <rogue/Renderer.h>
 #include <rogue/UI/CommandLine.h>
 #include <rogue/UI/Controls.h>
@@ -32,8 +34,10 @@ Game::Game(cxxg::Screen &Scr, const GameConfig &Cfg)
       Ctx({EvHub, ItemDb, EntityDb, LevelDb, CraftingDb, Crafter}),
       LvlGen(LevelGeneratorLoader(Ctx, Cfg.LevelDbConfig.parent_path())
                  .load(Cfg.Seed, Cfg.InitialLevelConfig)),
-      World(GameWorld::create(LevelDb, *LvlGen, Cfg.InitialGameWorld)),
-      UICtrl(Scr) {
+      World(GameWorld::create(LevelDb, *LvlGen, Cfg.InitialGameWorld,
+                              Cfg.Seed)),
+      AutoSave(SaveGameInfo::getAutoSave(), Cfg.AutoSave), UICtrl(Scr),
+      WorldSeed(Cfg.Seed) {
   // Configure base game
   MaxNotifications = 4;
 
@@ -66,6 +70,8 @@ void Game::initialize(bool BufferedInput, unsigned TickDelayUs) {
   // Set seed for random number generator
   std::srand(Cfg.Seed);
 
+  // Defer events published while updating the level to the end of the tick
+  EvHub.setQueueEnabled(true);
   EHW.setEventHub(&EvHub);
   EHW.subscribe(*this, &Game::onEntityDiedEvent);
   EHW.subscribe(*this, &Game::onSwitchLevelEvent);
@@ -104,6 +110,7 @@ void Game::switchLevel(int Level, bool ToEntry) {
   UICtrl.closeAll();
   REC.clear();
   World->switchLevel(Level, ToEntry);
+  AutoSave.levelChanged();
 }
 
 bool Game::handleInput(int Char) {
@@ -264,6 +271,8 @@ bool Game::handleInput(int Char) {
 bool Game::handleUpdates(bool IsTick) {
   if (!IsTick) {
     World->getCurrentLevelOrFail().update(IsTick);
+    World->prefetch(Cfg.Seed + WorldSwitchCounter);
+    handleAutoSave();
     return true;
   }
 
@@ -271,16 +280,29 @@ bool Game::handleUpdates(bool IsTick) {
   // We will perform ticks until enough ticks have passed for the player to have
   // gained enough AP to take an action.
   while (GameRunning) {
-    World->getCurrentLevelOrFail().update(true);
-    GameTicks++;
+    const auto TickStart = Profiler::Clock::now();
+    {
+      Profiler::ScopedTimer Timer("Game::tick");
+      World->getCurrentLevelOrFail().update(true);
+      GameTicks++;
+      AutoSave.tick();
+
+      if (!GameRunning) {
+        break;
+      }
 
-    if (!GameRunning) {
-      break;
+      handleDrawLevel(true);
     }
 
-    handleDrawLevel(true);
+    // Keep a steady pace for animations, only wait for the time left after
+    // updating and drawing the tick
     if (UICtrl.DelayTicks || REC.hasEvents()) {
-      cxxg::utils::sleep(150000);
+      const auto Elapsed =
+          std::chrono::duration_cast<std::chrono::microseconds>(
+              Profiler::Clock::now() - TickStart);
+      if (Elapsed < AnimationTickTime) {
+        cxxg::utils::sleep((AnimationTickTime - Elapsed).count());
+      }
     }
     REC.clear();
 
@@ -293,9 +315,25 @@ bool Game::handleUpdates(bool IsTick) {
     }
   }
 
+  // Prepare levels the player may switch to while waiting for input
+  World->prefetch(Cfg.Seed + WorldSwitchCounter);
+  handleAutoSave();
   return true;
 }
 
+void Game::handleAutoSave() {
+  if (auto Error = AutoSave.takeError()) {
+    Hist.warn() << "Autosave failed: " << *Error;
+  }
+
+  // Postpone the save until the game can be saved again
+  if (!GameRunning || !AutoSave.isDue() || !World->canSaveGame()) {
+    return;
+  }
+  Profiler::ScopedTimer Timer("Game::autoSave");
+  AutoSave.submit(World->snapshotSaveGame());
+}
+
 void Game::handleDraw() {
   if (GameRunning) {
     handleDrawLevel(false);
@@ -304,6 +342,7 @@ void Game::handleDraw() {
     handleDrawGameOver();
   }
 
+  Profiler::ScopedTimer Timer("Screen::update");
   cxxg::Game::handleDraw();
 }
 
@@ -358,6 +397,17 @@ bool Game::tryInteract() {
 void Game::loadSaveGame(const SaveGameInfo &SGI) {
   REC.clear();
 
+  // The levels of the save game are regenerated from the seed it was created
+  // with, recreate the world if that differs from the current one
+  if (auto Seed = World->readSaveGameSeed(SGI); Seed && *Seed != WorldSeed) {
+    World = nullptr;
+    LvlGen = LevelGeneratorLoader(Ctx, Cfg.LevelDbConfig.parent_path())
+                 .load(*Seed, Cfg.InitialLevelConfig);
+    World = GameWorld::create(LevelDb, *LvlGen, Cfg.InitialGameWorld, *Seed);
+    World->setEventHub(&EvHub);
+    WorldSeed = *Seed;
+  }
+
   World->loadSaveGame(SGI);
 
   // We could update the level here, but we want to draw the initial state.
@@ -414,6 +464,7 @@ void Game::onSwitchGameWorldEvent(const SwitchGameWorldEvent &E) {
   REC.clear();
 
   World->switchWorld(Cfg.Seed + WorldSwitchCounter++, E.LevelName, E.SwitchEt);
+  AutoSave.levelChanged();
 
   // We could update the level here, but we want to draw the initial state.
   handleUpdates(/*IsTick=*/false);
@@ -521,6 +572,28 @@ getUITargetInfo(entt::entity Player, const ui::Controller &UICtrl,
 
 } // namespace
 
+namespace {
+
+void drawProfilerOverlay(cxxg::Screen &Scr, const Profiler &Prof) {
+  static constexpr int Width = 58;
+  const auto OverlayColor = cxxg::types::RgbColor{200, 200, 120, true, 0, 0, 0};
+
+  const int X = static_cast<int>(Scr.getSize().X) - Width;
+  int Y = 2;
+  Scr[Y++][X] << OverlayColor << std::left << std::setw(26) << "stage [ms]"
+              << std::right << std::setw(8) << "last" << std::setw(8) << "p50"
+              << std::setw(8) << "p95" << std::setw(8) << "p99";
+  for (const auto &[Name, St] : Prof.getAllStats()) {
+    Scr[Y++][X] << OverlayColor << std::left << std::setw(26)
+                << Name.substr(0, 25) << std::right << std::fixed
+                << std::setprecision(2) << std::setw(8) << St.Last / 1000.0
+                << std::setw(8) << St.P50 / 1000.0 << std::setw(8)
+                << St.P95 / 1000.0 << std::setw(8) << St.P99 / 1000.0;
+  }
+}
+
+} // namespace
+
 void Game::handleDrawLevel(bool UpdateScreen) {
   // Render the current map
   const auto RenderSize = ymir::Size2d<int>{static_cast<int>(Scr.getSize().X),
@@ -540,7 +613,10 @@ void Game::handleDrawLevel(bool UpdateScreen) {
   Render.renderEntities();
   Render.renderShadow(/*Darkness=*/30);
   Render.renderFogOfWar(CurrentLevel.getPlayerSeenMap());
-  REC.apply(Render);
+  {
+    Profiler::ScopedTimer Timer("RenderEventCollector::apply");
+    REC.apply(Render);
+  }
 
   // Draw map
   Scr << Render.get();
@@ -550,7 +626,12 @@ void Game::handleDrawLevel(bool UpdateScreen) {
   auto TI = getUITargetInfo(Player, UICtrl, getLvlReg());
   UICtrl.draw(World->getCurrentLevelIdx(), PI, TI);
 
+  if (Profiler::get().isEnabled()) {
+    drawProfilerOverlay(Scr, Profiler::get());
+  }
+
   if (UpdateScreen) {
+    Profiler::ScopedTimer Timer("Screen::update");
     handleShowNotifications(false);
     Scr.update();
     Scr.clear();
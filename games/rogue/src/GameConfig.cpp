@@ -38,6 +38,12 @@ GameConfig GameConfig::load(const std::filesystem::path &ConfigFile) {
     Config.InitialItems.push_back(ItemCfg);
   }
 
+  if (Doc.HasMember("autosave")) {
+    const auto &AutoSave = Doc["autosave"];
+    Config.AutoSave.TickInterval = AutoSave["tick_interval"].GetUint();
+    Config.AutoSave.OnLevelChange = AutoSave["on_level_change"].GetBool();
+  }
+
   return Config;
 }
 
@@ -53,6 +59,8 @@ std::ostream &operator<<(std::ostream &Out, const GameConfig &Cfg) {
   for (const auto &Item : Cfg.InitialItems) {
     Out << "    -> " << Item.Name << " x" << Item.Count << "\n";
   }
+  Out << "  AutoSave: every " << Cfg.AutoSave.TickInterval << " ticks"
+      << (Cfg.AutoSave.OnLevelChange ? ", on level change" : "") << "\n";
   return Out;
 }
 
@@ -1,17 +1,25 @@
+#include <algorithm>
+#include <cstdlib>
+#include <memory>
+#include <rogue/Components/Level.h>
 #include <rogue/Components/Transform.h>
 #include <rogue/GameWorld.h>
 #include <rogue/Level.h>
 #include <rogue/LevelDatabase.h>
 #include <rogue/LevelGenerator.h>
+#include <rogue/SaveGame.h>
+#include <rogue/SaveGameFile.h>
 #include <rogue/Serialization.h>
+#include <variant>
 
 namespace rogue {
 
 std::unique_ptr<GameWorld> GameWorld::create(LevelDatabase &LevelDb,
                                              LevelGenerator &LvlGen,
-                                             std::string_view Type) {
+                                             std::string_view Type,
+                                             unsigned Seed) {
   if (Type == MultiLevelDungeon::Type) {
-    return std::make_unique<MultiLevelDungeon>(LvlGen);
+    return std::make_unique<MultiLevelDungeon>(LvlGen, Seed);
   }
 
   if (Type == DungeonSweeper::Type) {
@@ -21,8 +29,31 @@ std::unique_ptr<GameWorld> GameWorld::create(LevelDatabase &LevelDb,
   throw std::runtime_error("GameWorld: Unknown type: " + std::string(Type));
 }
 
-MultiLevelDungeon::MultiLevelDungeon(LevelGenerator &LvlGen)
-    : LevelGen(LvlGen) {}
+void GameWorld::storeSaveGame(const SaveGameInfo &SGI) {
+  writeSaveGameAtomically(SGI, snapshotSaveGame());
+}
+
+MultiLevelDungeon::MultiLevelDungeon(LevelGenerator &LvlGen, unsigned Seed)
+    : LevelGen(LvlGen), Seed(Seed) {}
+
+void MultiLevelDungeon::setHibernationConfig(const HibernationConfig &Cfg) {
+  HibCfg = Cfg;
+  hibernateLevels();
+}
+
+MultiLevelDungeon::MemoryStats MultiLevelDungeon::getMemoryStats() const {
+  MemoryStats Stats;
+  for (const auto &Entry : Levels) {
+    if (Entry.Lvl) {
+      Stats.NumResident++;
+      Stats.ResidentBytes += Entry.Lvl->getMemoryUsage();
+    } else {
+      Stats.NumHibernated++;
+      Stats.HibernatedBytes += Entry.Snapshot.size();
+    }
+  }
+  return Stats;
+}
 
 Level &MultiLevelDungeon::switchLevel(std::size_t LevelIdx, bool ToEntry) {
   if (LevelIdx >= Levels.size() + 1) {
@@ -31,10 +62,22 @@ Level &MultiLevelDungeon::switchLevel(std::size_t LevelIdx, bool ToEntry) {
 
   auto *CurrLvl = getCurrentLevel();
   if (LevelIdx >= Levels.size()) {
-    Levels.push_back(LevelGen.generateLevel(LevelIdx));
-    Levels.back()->setEventHub(Hub);
+    auto NewLevel = Prefetcher.take(LevelIdx);
+    if (!NewLevel) {
+      NewLevel = LevelGen.generateLevel(LevelIdx);
+    }
+    NewLevel->setEventHub(Hub);
+    LevelEntry Entry;
+    Entry.Baseline = std::make_shared<serialize::LevelBaseline>(
+        serialize::LevelBaseline::create(*NewLevel));
+    Entry.Lvl = std::move(NewLevel);
+    Levels.push_back(std::move(Entry));
   }
-  auto &Nextlvl = *Levels.at(LevelIdx);
+  if (!Levels.at(LevelIdx).Lvl) {
+    wakeLevel(LevelIdx);
+  }
+  Levels.at(LevelIdx).LastUsed = ++UseCounter;
+  auto &Nextlvl = *Levels.at(LevelIdx).Lvl;
 
   if (CurrLvl && CurrLvl != &Nextlvl && CurrLvl->hasPlayer()) {
     auto ToPos =
@@ -44,6 +87,7 @@ Level &MultiLevelDungeon::switchLevel(std::size_t LevelIdx, bool ToEntry) {
   }
 
   CurrentLevelIdx = LevelIdx;
+  hibernateLevels();
   return getCurrentLevelOrFail();
 }
 
@@ -53,12 +97,221 @@ void MultiLevelDungeon::switchWorld(unsigned, const std::string &LevelName,
                            std::string(LevelName));
 }
 
-void MultiLevelDungeon::loadSaveGame(const SaveGameInfo &) {
-  throw std::runtime_error("MultiLevelDungeon: loadSaveGame not implemented");
+void MultiLevelDungeon::prefetch(unsigned) {
+  const auto PrefetchHibernated = [this](std::size_t LevelIdx) {
+    if (!Levels.at(LevelIdx).Lvl) {
+      Prefetcher.prefetch(LevelIdx, [this, LevelIdx]() {
+        return LevelGen.generateLevel(LevelIdx);
+      });
+    }
+  };
+  if (CurrentLevelIdx > 0 && CurrentLevelIdx - 1 < Levels.size()) {
+    PrefetchHibernated(CurrentLevelIdx - 1);
+  }
+
+  // Levels are generated in order, only the next one can be prefetched
+  if (CurrentLevelIdx + 1 < Levels.size()) {
+    PrefetchHibernated(CurrentLevelIdx + 1);
+    return;
+  }
+  const auto NextLevelIdx = Levels.size();
+  if (const auto *CMLG =
+          dynamic_cast<const CompositeMultiLevelGenerator *>(&LevelGen)) {
+    if (NextLevelIdx >= CMLG->getMaxLevelIdx()) {
+      return;
+    }
+  }
+  Prefetcher.prefetch(NextLevelIdx, [this, NextLevelIdx]() {
+    return LevelGen.generateLevel(NextLevelIdx);
+  });
+}
+
+void MultiLevelDungeon::hibernateLevels() {
+  if (!HibCfg.Enabled) {
+    return;
+  }
+
+  struct Candidate {
+    std::size_t Bytes = 0;
+    LevelEntry *Entry = nullptr;
+  };
+
+  std::size_t ResidentBytes = 0;
+  std::vector<Candidate> Candidates;
+  for (std::size_t Idx = 0; Idx < Levels.size(); ++Idx) {
+    auto &Entry = Levels[Idx];
+    if (!Entry.Lvl) {
+      continue;
+    }
+    const auto Bytes = Entry.Lvl->getMemoryUsage();
+    ResidentBytes += Bytes;
+
+    const auto Distance =
+        Idx > CurrentLevelIdx ? Idx - CurrentLevelIdx : CurrentLevelIdx - Idx;
+    if (Distance > HibCfg.KeepDistance && !Entry.Lvl->hasPlayer() &&
+        serialize::LevelSnapshot::canRestore(*Entry.Lvl, *Entry.Baseline)) {
+      Candidates.push_back({Bytes, &Entry});
+    }
+  }
+
+  std::sort(Candidates.begin(), Candidates.end(),
+            [](const auto &A, const auto &B) {
+              return A.Entry->LastUsed < B.Entry->LastUsed;
+            });
+  for (auto &C : Candidates) {
+    if (ResidentBytes <= HibCfg.MaxResidentBytes) {
+      break;
+    }
+    hibernateLevel(*C.Entry);
+    ResidentBytes -= C.Bytes;
+  }
+}
+
+void MultiLevelDungeon::hibernateLevel(LevelEntry &Entry) {
+  Entry.Snapshot =
+      serialize::LevelSnapshot::create(*Entry.Lvl, *Entry.Baseline).toBytes();
+  Entry.Lvl = nullptr;
+}
+
+void MultiLevelDungeon::wakeLevel(std::size_t LevelIdx) {
+  readSnapshot(LevelIdx);
+  auto &Entry = Levels.at(LevelIdx);
+  auto Lvl = Prefetcher.take(LevelIdx);
+  if (!Lvl) {
+    Lvl = LevelGen.generateLevel(LevelIdx);
+  }
+  // Levels restored from a save game have no baseline yet, the regenerated
+  // level is verified against the checksum of the snapshot
+  if (!Entry.Baseline) {
+    Entry.Baseline = std::make_shared<serialize::LevelBaseline>(
+        serialize::LevelBaseline::create(*Lvl));
+  }
+  serialize::LevelSnapshot::fromBytes(Entry.Snapshot).apply(*Lvl);
+  Lvl->setEventHub(Hub);
+  Entry.Lvl = std::move(Lvl);
+  Entry.Snapshot = std::string();
+}
+
+void MultiLevelDungeon::readSnapshot(std::size_t LevelIdx) {
+  auto &Entry = Levels.at(LevelIdx);
+  if (!Entry.InSaveGame) {
+    return;
+  }
+  Entry.Snapshot = LoadedSaveGame->readChunk(
+      SaveGameChunk::Level, static_cast<std::uint32_t>(LevelIdx));
+  Entry.InSaveGame = false;
 }
 
-void MultiLevelDungeon::storeSaveGame(const SaveGameInfo &) {
-  throw std::runtime_error("MultiLevelDungeon: storeSaveGame not implemented");
+std::optional<unsigned>
+MultiLevelDungeon::readSaveGameSeed(const SaveGameInfo &SGI) const {
+  if (SGI.JSON) {
+    return std::nullopt;
+  }
+  SaveGameReader Reader(SGI.Path);
+  return serialize::WorldSnapshot::fromBytes(
+             Reader.readChunk(SaveGameChunk::World, 0))
+      .Seed;
+}
+
+void MultiLevelDungeon::loadSaveGame(const SaveGameInfo &SGI) {
+  if (SGI.JSON) {
+    throw std::runtime_error("MultiLevelDungeon: JSON save games are not "
+                             "supported");
+  }
+
+  auto Reader = std::make_shared<SaveGameReader>(SGI.Path);
+  const auto World = serialize::WorldSnapshot::fromBytes(
+      Reader->readChunk(SaveGameChunk::World, 0));
+  if (World.Seed != Seed) {
+    throw std::runtime_error("MultiLevelDungeon: Save game was created with "
+                             "seed " +
+                             std::to_string(World.Seed) + ", the world uses " +
+                             std::to_string(Seed));
+  }
+  if (World.CurrentLevelIdx >= World.NumLevels) {
+    throw std::runtime_error("MultiLevelDungeon: Invalid current level in "
+                             "save game: " +
+                             SGI.Path.string());
+  }
+
+  // All levels start hibernated and are only read and regenerated once
+  // visited
+  std::vector<LevelEntry> LoadedLevels(World.NumLevels);
+  for (std::uint32_t Idx = 0; Idx < World.NumLevels; ++Idx) {
+    if (!Reader->hasChunk(SaveGameChunk::Level, Idx)) {
+      throw std::runtime_error("MultiLevelDungeon: Missing level " +
+                               std::to_string(Idx) +
+                               " in save game: " + SGI.Path.string());
+    }
+    LoadedLevels[Idx].InSaveGame = true;
+  }
+
+  Prefetcher.cancel();
+  Levels = std::move(LoadedLevels);
+  LoadedSaveGame = std::move(Reader);
+  CurrentLevelIdx = World.CurrentLevelIdx;
+  wakeLevel(CurrentLevelIdx);
+  Levels.at(CurrentLevelIdx).LastUsed = ++UseCounter;
+  if (World.Player) {
+    World.Player->apply(getCurrentLevelOrFail());
+  }
+}
+
+GameWorld::SaveGameWriteFn MultiLevelDungeon::snapshotSaveGame() {
+  using LevelState = std::variant<serialize::LevelSnapshot, std::string>;
+  struct SaveState {
+    serialize::WorldSnapshot World;
+    std::vector<LevelState> Levels;
+  };
+
+  // The save game may be written to the file it was loaded from
+  for (std::size_t Idx = 0; Idx < Levels.size(); ++Idx) {
+    readSnapshot(Idx);
+  }
+  LoadedSaveGame = nullptr;
+
+  const auto &CurrLvl = getCurrentLevelOrFail();
+  auto State = std::make_shared<SaveState>();
+  State->World.Seed = Seed;
+  State->World.CurrentLevelIdx = static_cast<std::uint32_t>(CurrentLevelIdx);
+  State->World.NumLevels = static_cast<std::uint32_t>(Levels.size());
+  if (CurrLvl.hasPlayer()) {
+    State->World.Player = serialize::PlayerSnapshot::create(CurrLvl);
+  }
+
+  // Resident levels are only captured, hibernated levels are already
+  // serialized and written as they are
+  State->Levels.reserve(Levels.size());
+  for (const auto &Entry : Levels) {
+    if (Entry.Lvl) {
+      State->Levels.emplace_back(
+          serialize::LevelSnapshot::create(*Entry.Lvl, *Entry.Baseline));
+    } else {
+      State->Levels.emplace_back(Entry.Snapshot);
+    }
+  }
+
+  return [State](const SaveGameInfo &SGI) {
+    if (SGI.JSON) {
+      throw std::runtime_error("MultiLevelDungeon: JSON save games are not "
+                               "supported");
+    }
+
+    // Chunks are streamed to the file one level at a time
+    SaveGameWriter Writer(SGI.Path);
+    Writer.addChunk(SaveGameChunk::World, 0, State->World.toBytes());
+    for (std::size_t Idx = 0; Idx < State->Levels.size(); ++Idx) {
+      const auto &Lvl = State->Levels[Idx];
+      const auto LevelIdx = static_cast<std::uint32_t>(Idx);
+      if (const auto *Bytes = std::get_if<std::string>(&Lvl)) {
+        Writer.addChunk(SaveGameChunk::Level, LevelIdx, *Bytes);
+      } else {
+        Writer.addChunk(SaveGameChunk::Level, LevelIdx,
+                        std::get<serialize::LevelSnapshot>(Lvl).toBytes());
+      }
+    }
+    Writer.finish();
+  };
 }
 
 std::size_t MultiLevelDungeon::getCurrentLevelIdx() const {
@@ -75,7 +328,7 @@ const Level *MultiLevelDungeon::getCurrentLevel() const {
     return nullptr;
   }
 
-  return Levels.at(CurrentLevelIdx).get();
+  return Levels.at(CurrentLevelIdx).Lvl.get();
 }
 
 Level &MultiLevelDungeon::getCurrentLevelOrFail() {
@@ -110,8 +363,7 @@ Level &DungeonSweeper::switchLevel(std::size_t LevelIdx, bool ToEntry) {
             "DungeonSweeper: No free position next to switch entity");
       }
       Lvl->movePlayer(*CurrLvl, *ToPos);
-      CurrSubWorld = nullptr;
-      CurrSubLvlGen = nullptr;
+      leaveSubWorld();
     }
   }
 
@@ -129,7 +381,8 @@ Level &DungeonSweeper::switchLevel(std::size_t LevelIdx, bool ToEntry) {
 }
 
 void DungeonSweeper::loadSaveGame(const SaveGameInfo &SGI) {
-  CurrSubWorld = nullptr;
+  discardPrefetchedSubWorld();
+  leaveSubWorld();
   Lvl = nullptr;
   switchLevel(0, true);
 
@@ -140,31 +393,128 @@ void DungeonSweeper::loadSaveGame(const SaveGameInfo &SGI) {
   SaveGame.apply(CurrLvl);
 }
 
-void DungeonSweeper::storeSaveGame(const SaveGameInfo &SGI) {
+GameWorld::SaveGameWriteFn DungeonSweeper::snapshotSaveGame() {
   if (CurrSubWorld) {
     throw std::runtime_error("Can not save game in a dungeon");
   }
   auto &CurrLvl = getCurrentLevelOrFail();
 
-  serialize::SaveGameSerializer::create(CurrLvl).saveToFile(SGI);
+  auto SaveGame = std::make_shared<serialize::SaveGameSerializer>(
+      serialize::SaveGameSerializer::create(CurrLvl));
+  return [SaveGame](const SaveGameInfo &SGI) { SaveGame->saveToFile(SGI); };
 }
 
+bool DungeonSweeper::canSaveGame() const { return !CurrSubWorld; }
+
 void DungeonSweeper::switchWorld(unsigned Seed, const std::string &LevelName,
                                  entt::entity SwitchEt) {
+  // Use the prefetched sub-world if the player entered the one prepared,
+  // waits for it if it is still being prepared
+  if (PrefetchedSubWorld && PrefetchedSubWorld->SwitchEt == SwitchEt &&
+      PrefetchedSubWorld->Seed == Seed &&
+      PrefetchedSubWorld->LevelName == LevelName) {
+    auto Future = std::move(PrefetchedSubWorld->Future);
+    PrefetchedSubWorld.reset();
+    enterSubWorld(Future.get());
+    return;
+  }
+
+  discardPrefetchedSubWorld();
   auto LI = LevelDb.getLevelInfo(LevelName);
-  switchWorld(Seed, LI.WorldType, LI.LevelConfig, SwitchEt);
+  if (LI.WorldType == DungeonSweeper::Type) {
+    // FIXME
+    leaveSubWorld();
+    return;
+  }
+  enterSubWorld(getCreateSubWorldFn(Seed, LevelName, LI, SwitchEt)());
 }
 
-void DungeonSweeper::switchWorld(unsigned Seed, std::string_view Type,
-                                 std::filesystem::path Config,
-                                 entt::entity SwitchEt) {
-  if (Type == DungeonSweeper::Type) {
-    // FIXME
-    CurrSubLvlGen = nullptr;
-    CurrSubWorld = nullptr;
+void DungeonSweeper::prefetch(unsigned NextWorldSeed) {
+  if (CurrSubWorld) {
+    // Leaving the last level returns to the local level
+    if (CurrSubWorld->getCurrentLevelIdx() + 1 < CurrMaxLevel) {
+      CurrSubWorld->prefetch(NextWorldSeed);
+    }
+    return;
+  }
+  if (!Lvl || !Lvl->hasPlayer()) {
     return;
   }
 
+  // Find the closest world entry in reach of the player
+  const auto PlayerPos = Lvl->Reg.get<PositionComp>(Lvl->getPlayer()).Pos;
+  entt::entity ClosestEt = entt::null;
+  const std::string *LevelName = nullptr;
+  int ClosestDist = PrefetchDistance + 1;
+  Lvl->Reg.view<const PositionComp, const WorldEntryComp>().each(
+      [&](auto Et, const auto &PC, const auto &WEC) {
+        const auto Dist = std::max(std::abs(PC.Pos.X - PlayerPos.X),
+                                   std::abs(PC.Pos.Y - PlayerPos.Y));
+        if (Dist < ClosestDist) {
+          ClosestDist = Dist;
+          ClosestEt = Et;
+          LevelName = &WEC.LevelName;
+        }
+      });
+
+  // Drop the prepared sub-world if the player walked away from it
+  if (ClosestEt == entt::null) {
+    discardPrefetchedSubWorld();
+    return;
+  }
+  if (PrefetchedSubWorld && PrefetchedSubWorld->SwitchEt == ClosestEt &&
+      PrefetchedSubWorld->Seed == NextWorldSeed) {
+    return;
+  }
+
+  discardPrefetchedSubWorld();
+  auto LI = LevelDb.getLevelInfo(*LevelName);
+  if (LI.WorldType == DungeonSweeper::Type) {
+    return;
+  }
+
+  // Loading the generator and generating the first level both happen on the
+  // worker, the first level is generated by the prefetcher of the sub-world
+  auto Create = getCreateSubWorldFn(NextWorldSeed, *LevelName, LI, ClosestEt);
+  PrefetchedSubWorld = PendingSubWorld{NextWorldSeed, *LevelName, ClosestEt,
+                                       {}};
+  PrefetchedSubWorld->Future = Worker.submit<std::unique_ptr<SubWorld>>(
+      [Create = std::move(Create), NextWorldSeed]() {
+        auto SW = Create();
+        SW->World->prefetch(NextWorldSeed);
+        return SW;
+      });
+}
+
+DungeonSweeper::CreateSubWorldFn
+DungeonSweeper::getCreateSubWorldFn(unsigned Seed,
+                                    const std::string &LevelName,
+                                    const LevelContainer::LevelInfo &LI,
+                                    entt::entity SwitchEt) const {
+  auto SwitchPos = Lvl->Reg.get<PositionComp>(SwitchEt).Pos;
+  unsigned GenSeed = Seed;
+  GenSeed ^= GenSeed << 12 ^ SwitchPos.X ^ SwitchPos.Y << 8;
+  GenSeed ^= SwitchedWorldCount;
+
+  auto &Db = LevelDb;
+  auto &Gen = LevelGen;
+  return [&Db, &Gen, Seed, LevelName, LI, SwitchEt, GenSeed]() {
+    auto SW = std::make_unique<SubWorld>();
+    SW->Seed = Seed;
+    SW->LevelName = LevelName;
+    SW->SwitchEt = SwitchEt;
+    SW->LvlGen = LevelGeneratorLoader(Gen.getCtx(), Gen.getDataDir())
+                     .load(GenSeed, LI.LevelConfig);
+    SW->World = GameWorld::create(Db, *SW->LvlGen, LI.WorldType, GenSeed);
+    if (auto *CMLG =
+            dynamic_cast<CompositeMultiLevelGenerator *>(SW->LvlGen.get())) {
+      SW->MaxLevel = CMLG->getMaxLevelIdx();
+    }
+    return SW;
+  };
+}
+
+void DungeonSweeper::enterSubWorld(std::unique_ptr<SubWorld> SW) {
   // If we have a sub-world active move player to local level
   if (CurrSubWorld) {
     auto *CurrLvl = getCurrentLevel();
@@ -174,20 +524,13 @@ void DungeonSweeper::switchWorld(unsigned Seed, std::string_view Type,
     Lvl->movePlayer(*CurrLvl, ToPos);
   }
 
-  auto SwitchPos = Lvl->Reg.get<PositionComp>(SwitchEt).Pos;
-  Seed ^= Seed << 12 ^ SwitchPos.X ^ SwitchPos.Y << 8;
-  Seed ^= SwitchedWorldCount++;
-
-  CurrSubLvlGen = LevelGeneratorLoader(LevelGen.getCtx(), LevelGen.getDataDir())
-                      .load(Seed, Config);
-  CurrSubWorld = GameWorld::create(LevelDb, *CurrSubLvlGen, Type);
+  leaveSubWorld();
+  SwitchedWorldCount++;
+  CurrSubLvlGen = std::move(SW->LvlGen);
+  CurrSubWorld = std::move(SW->World);
   CurrSubWorld->setEventHub(Hub);
-  CurrMaxLevel = 1;
-  if (auto *CMLG =
-          dynamic_cast<CompositeMultiLevelGenerator *>(CurrSubLvlGen.get())) {
-    CurrMaxLevel = CMLG->getMaxLevelIdx();
-  }
-  CurrSwitchEntity = SwitchEt;
+  CurrMaxLevel = SW->MaxLevel;
+  CurrSwitchEntity = SW->SwitchEt;
 
   // Move player to the new sub-world
   auto &NextLvl = CurrSubWorld->switchLevel(0, true);
@@ -196,6 +539,28 @@ void DungeonSweeper::switchWorld(unsigned Seed, std::string_view Type,
   NextLvl.movePlayer(*Lvl, ToPos);
 }
 
+void DungeonSweeper::leaveSubWorld() {
+  if (!CurrSubWorld) {
+    CurrSubLvlGen = nullptr;
+    return;
+  }
+
+  // The sub-world may still generate levels using the generator, waiting for
+  // them is left to the worker
+  auto SW = std::make_unique<SubWorld>();
+  SW->LvlGen = std::move(CurrSubLvlGen);
+  SW->World = std::move(CurrSubWorld);
+  Worker.dispose(std::move(SW));
+}
+
+void DungeonSweeper::discardPrefetchedSubWorld() {
+  if (!PrefetchedSubWorld) {
+    return;
+  }
+  Worker.dispose(std::move(PrefetchedSubWorld->Future));
+  PrefetchedSubWorld.reset();
+}
+
 std::size_t DungeonSweeper::getCurrentLevelIdx() const {
   if (CurrSubWorld) {
     return CurrSubWorld->getCurrentLevelIdx();
@@ -1,3 +1,5 @@
+#include <algorithm>
+#include <functional>
 #include <rogue/Components/Buffs.h>
 #include <rogue/Components/Visual.h>
 #include <rogue/Event.h>
@@ -21,7 +23,85 @@ HistoryMessageAssembler::~HistoryMessageAssembler() {
   Hist.addMessage(Row.get());
 }
 
-History::History(Game &G) : G(G) {}
+namespace {
+
+std::size_t hashCombine(std::size_t Seed, std::size_t Value) {
+  return Seed ^ (Value + 0x9e3779b9 + (Seed << 6) + (Seed >> 2));
+}
+
+std::size_t getFontStyleBits(const cxxg::types::FontStyle &FS) {
+  return FS.Italic | (FS.Bold << 1) | (FS.Underline << 2) |
+         (FS.Strikethrough << 3);
+}
+
+std::size_t hashColor(const cxxg::types::TermColor &Color) {
+  if (const auto *DC = std::get_if<cxxg::types::DefaultColor>(&Color)) {
+    return 1 | (getFontStyleBits(DC->FS) << 2);
+  }
+  if (const auto *RC = std::get_if<cxxg::types::RgbColor>(&Color)) {
+    std::size_t Bits = RC->R | (RC->G << 8) | (RC->B << 16);
+    if (RC->HasBackground) {
+      Bits = hashCombine(Bits, RC->BgR | (RC->BgG << 8) | (RC->BgB << 16));
+    }
+    return hashCombine(Bits, 2 | (getFontStyleBits(RC->FS) << 2));
+  }
+  return 0;
+}
+
+} // namespace
+
+History::Message History::Message::create(const cxxg::Row &Rw) {
+  const auto &Buffer = Rw.getBuffer();
+  const auto &ColorInfo = Rw.getColorInfo();
+
+  // Strip blanks at the end, those will be restored when materializing
+  std::size_t Length = Buffer.size();
+  while (Length > 0 && Buffer[Length - 1] == ' ' &&
+         ColorInfo[Length - 1] == cxxg::types::Color::NONE) {
+    Length--;
+  }
+
+  Message Msg;
+  Msg.Text = Buffer.substr(0, Length);
+  Msg.Hash = std::hash<std::string>()(Msg.Text);
+  for (std::size_t Idx = 0; Idx < Length; Idx++) {
+    if (!Msg.Colors.empty() && Msg.Colors.back().Color == ColorInfo[Idx]) {
+      continue;
+    }
+    Msg.Colors.push_back({Idx, ColorInfo[Idx]});
+    Msg.Hash = hashCombine(Msg.Hash, Idx);
+    Msg.Hash = hashCombine(Msg.Hash, hashColor(ColorInfo[Idx]));
+  }
+  return Msg;
+}
+
+cxxg::Row History::Message::getRow(std::size_t Width) const {
+  cxxg::Row Rw(Width);
+  for (std::size_t Idx = 0; Idx < Colors.size(); Idx++) {
+    const auto &Run = Colors.at(Idx);
+    const auto End =
+        Idx + 1 < Colors.size() ? Colors.at(Idx + 1).Start : Text.size();
+    Rw[Run.Start] << Run.Color << Text.substr(Run.Start, End - Run.Start);
+  }
+  return Rw;
+}
+
+bool History::Message::isSameAs(const Message &Other) const {
+  if (Hash != Other.Hash || Text != Other.Text ||
+      Colors.size() != Other.Colors.size()) {
+    return false;
+  }
+  for (std::size_t Idx = 0; Idx < Colors.size(); Idx++) {
+    if (Colors[Idx].Start != Other.Colors[Idx].Start ||
+        Colors[Idx].Color != Other.Colors[Idx].Color) {
+      return false;
+    }
+  }
+  return true;
+}
+
+History::History(cxxg::Game &G, std::size_t MaxMessages)
+    : G(G), MaxMessages(std::max(MaxMessages, std::size_t(1))) {}
 
 HistoryMessageAssembler History::info() {
   return HistoryMessageAssembler(*this, G.notify());
@@ -31,12 +111,33 @@ HistoryMessageAssembler History::warn() {
   return HistoryMessageAssembler(*this, G.notify());
 }
 
-void History::addMessage(const cxxg::Row &Msg) {
-  if (Messages.size() > 0 && Messages.back().Row == Msg) {
-    Messages.back().Count++;
+const History::Message &History::getMessage(std::size_t Idx) const {
+  if (Idx >= Messages.size()) {
+    throw std::out_of_range("History message index out of range: " +
+                            std::to_string(Idx));
+  }
+  return Messages[(FirstMessageIdx + Idx) % Messages.size()];
+}
+
+void History::addMessage(const cxxg::Row &Rw) {
+  auto Msg = Message::create(Rw);
+  if (!Messages.empty()) {
+    auto &LastMsg = Messages[(FirstMessageIdx + Messages.size() - 1) %
+                             Messages.size()];
+    if (LastMsg.isSameAs(Msg)) {
+      LastMsg.Count++;
+      return;
+    }
+  }
+
+  if (Messages.size() < MaxMessages) {
+    Messages.push_back(std::move(Msg));
     return;
   }
-  Messages.push_back(Message{Msg});
+
+  // Buffer is full, overwrite the oldest message
+  Messages[FirstMessageIdx] = std::move(Msg);
+  FirstMessageIdx = (FirstMessageIdx + 1) % Messages.size();
 }
 
 EventHistoryWriter::EventHistoryWriter(History &Hist, bool Debug)
@@ -125,7 +226,8 @@ void EventHistoryWriter::onBuffApplyEffectEvent(
 }
 
 void EventHistoryWriter::onRestoreHealthEvent(const RestoreHealthEvent &RHE) {
-  if ((!RHE.isPlayerAffected() && !Debug) || !RHE.Registry) {
+  if ((!RHE.isPlayerAffected() && !Debug) || !RHE.Registry ||
+      !RHE.Registry->valid(RHE.Entity)) {
     return;
   }
   const auto *NC = RHE.Registry->try_get<NameComp>(RHE.Entity);
@@ -153,6 +255,9 @@ void EventHistoryWriter::onBuffExpiredEvent(const BuffExpiredEvent &BEE) {
 }
 
 void EventHistoryWriter::onSpawnEntityEvent(const SpawnEntityEvent &SEE) {
+  if (!SEE.Registry || !SEE.Registry->valid(SEE.Entity)) {
+    return;
+  }
   const auto *NC = SEE.Registry->try_get<NameComp>(SEE.Entity);
   if (!NC) {
     return;
@@ -1,3 +1,4 @@
+#include <algorithm>
 #include <iostream>
 #include <rogue/Inventory.h>
 
@@ -13,21 +14,46 @@ bool Inventory::applyItemTo(const Item &It, CapabilityFlags Flags,
   return true;
 }
 
-void Inventory::addItem(Item It) {
-  for (auto &InvIt : Items) {
-    if (InvIt.isSameKind(It) && InvIt.StackSize < It.getMaxStackSize() &&
-        (MaxStackSize == 0 ||
-         static_cast<unsigned>(InvIt.StackSize) < MaxStackSize)) {
-      auto Stacks =
-          std::min(It.getMaxStackSize() - InvIt.StackSize, It.StackSize);
-      if (MaxStackSize > 0) {
-        Stacks = std::min(static_cast<unsigned>(Stacks), MaxStackSize);
-      }
-      InvIt.StackSize += Stacks;
-      It.StackSize -= Stacks;
+void Inventory::setItems(std::vector<Item> Items) {
+  this->Items = std::move(Items);
+  rebuildIndex();
+}
+
+Inventory::SlotHandle Inventory::getSlotHandle(std::size_t ItemIdx) const {
+  return Handles.at(ItemIdx);
+}
+
+std::optional<std::size_t> Inventory::getItemIndex(SlotHandle Handle) const {
+  auto It = std::lower_bound(Handles.begin(), Handles.end(), Handle);
+  if (It == Handles.end() || *It != Handle) {
+    return {};
+  }
+  return static_cast<std::size_t>(It - Handles.begin());
+}
 
-      if (It.StackSize == 0) {
-        return;
+void Inventory::addItem(Item It) {
+  ++Revision;
+
+  // Only stacks of the same kind are considered for merging
+  if (auto KindIt = SlotsByKind.find(getKindKey(It));
+      KindIt != SlotsByKind.end()) {
+    for (const auto Handle : KindIt->second) {
+      auto &InvIt = Items[*getItemIndex(Handle)];
+      if (InvIt.StackSize < It.getMaxStackSize() &&
+          (MaxStackSize == 0 ||
+           static_cast<unsigned>(InvIt.StackSize) < MaxStackSize)) {
+        auto Stacks =
+            std::min(It.getMaxStackSize() - InvIt.StackSize, It.StackSize);
+        if (MaxStackSize > 0) {
+          Stacks = std::min(static_cast<unsigned>(Stacks), MaxStackSize);
+        }
+        InvIt.StackSize += Stacks;
+        It.StackSize -= Stacks;
+        CountById[It.getId()] += Stacks;
+
+        if (It.StackSize == 0) {
+          return;
+        }
       }
     }
   }
@@ -42,21 +68,19 @@ void Inventory::addItem(Item It) {
     auto Stacks = std::min(static_cast<unsigned>(RemainingStacks), InvMaxSize);
     Stacks = std::min(Stacks, static_cast<unsigned>(It.getMaxStackSize()));
     It.StackSize = Stacks;
-    Items.push_back(It);
+    appendSlot(It);
     RemainingStacks -= Stacks;
   }
 }
 
-Item Inventory::takeItem(std::size_t ItemIdx) {
-  Item It = Items.at(ItemIdx);
-  Items.erase(Items.begin() + ItemIdx);
-  return It;
-}
+Item Inventory::takeItem(std::size_t ItemIdx) { return eraseSlot(ItemIdx); }
 
 Item Inventory::takeItem(std::size_t ItemIdx, unsigned Count) {
   Item &It = Items.at(ItemIdx);
   if (It.StackSize > static_cast<int>(Count)) {
+    ++Revision;
     It.StackSize -= Count;
+    CountById[It.getId()] -= Count;
     auto SubStack = It;
     SubStack.StackSize = Count;
     return SubStack;
@@ -65,29 +89,61 @@ Item Inventory::takeItem(std::size_t ItemIdx, unsigned Count) {
   return takeItem(ItemIdx);
 }
 
-bool Inventory::hasItem(int Id, unsigned Count) const {
-  if (Count == 0) {
-    return false;
+void Inventory::addItems(std::vector<Item> NewItems) {
+  for (auto &It : NewItems) {
+    addItem(std::move(It));
   }
-  unsigned FoundCount = 0;
-  for (const auto &It : Items) {
-    if (It.getId() == Id) {
-      FoundCount += It.StackSize;
-      if (FoundCount >= Count) {
-        return true;
+}
+
+std::optional<std::vector<Item>>
+Inventory::takeItemsById(const std::vector<ItemProtoId> &Ids) {
+  std::unordered_map<int, unsigned> RequiredCounts;
+  for (const auto Id : Ids) {
+    RequiredCounts[Id] += 1;
+  }
+  for (const auto &[Id, Count] : RequiredCounts) {
+    if (!hasItem(Id, Count)) {
+      return std::nullopt;
+    }
+  }
+
+  // Stacks are only emptied here and removed at once afterwards, so taking
+  // many items does not erase from the middle of the inventory repeatedly
+  ++Revision;
+  std::vector<Item> Taken;
+  Taken.reserve(Ids.size());
+  for (const auto Id : Ids) {
+    for (const auto Handle : SlotsById.at(Id)) {
+      auto &InvIt = Items[*getItemIndex(Handle)];
+      if (InvIt.StackSize > 0) {
+        InvIt.StackSize -= 1;
+        CountById[Id] -= 1;
+        Taken.push_back(InvIt);
+        Taken.back().StackSize = 1;
+        break;
       }
     }
   }
-  return false;
+  eraseEmptySlots();
+
+  return Taken;
+}
+
+bool Inventory::hasItem(int Id, unsigned Count) const {
+  return Count != 0 && getItemCount(Id) >= Count;
+}
+
+unsigned Inventory::getItemCount(int Id) const {
+  auto It = CountById.find(Id);
+  return It != CountById.end() ? It->second : 0;
 }
 
 std::optional<std::size_t> Inventory::getItemIndexForId(int Id) const {
-  for (std::size_t Idx = 0; Idx < Items.size(); ++Idx) {
-    if (Items.at(Idx).getId() == Id) {
-      return Idx;
-    }
+  auto It = SlotsById.find(Id);
+  if (It == SlotsById.end()) {
+    return {};
   }
-  return {};
+  return getItemIndex(It->second.front());
 }
 
 std::optional<Item> Inventory::applyItemTo(std::size_t ItemIdx,
@@ -105,7 +161,84 @@ std::size_t Inventory::size() const { return Items.size(); }
 
 bool Inventory::empty() const { return Items.empty(); }
 
-void Inventory::clear() { Items.clear(); }
+void Inventory::clear() {
+  Items.clear();
+  rebuildIndex();
+}
+
+Inventory::KindKey Inventory::getKindKey(const Item &It) {
+  return {&It.getProto(), It.getSpecialization().get()};
+}
+
+void Inventory::appendSlot(Item It) {
+  const auto Handle = NextHandle++;
+  SlotsByKind[getKindKey(It)].push_back(Handle);
+  SlotsById[It.getId()].push_back(Handle);
+  CountById[It.getId()] += It.StackSize;
+  Items.push_back(std::move(It));
+  Handles.push_back(Handle);
+}
+
+void Inventory::removeFromIndex(SlotHandle Handle, const Item &It) {
+  const auto EraseHandle = [Handle](auto &Map, const auto &Key) {
+    auto MapIt = Map.find(Key);
+    auto &Slots = MapIt->second;
+    Slots.erase(std::lower_bound(Slots.begin(), Slots.end(), Handle));
+    if (Slots.empty()) {
+      Map.erase(MapIt);
+    }
+  };
+  EraseHandle(SlotsByKind, getKindKey(It));
+  EraseHandle(SlotsById, int(It.getId()));
+
+  auto CountIt = CountById.find(It.getId());
+  CountIt->second -= It.StackSize;
+  if (CountIt->second == 0) {
+    CountById.erase(CountIt);
+  }
+}
+
+Item Inventory::eraseSlot(std::size_t ItemIdx) {
+  Item It = Items.at(ItemIdx);
+  ++Revision;
+  removeFromIndex(Handles[ItemIdx], It);
+  Items.erase(Items.begin() + ItemIdx);
+  Handles.erase(Handles.begin() + ItemIdx);
+  return It;
+}
+
+void Inventory::eraseEmptySlots() {
+  std::size_t NewSize = 0;
+  for (std::size_t Idx = 0; Idx < Items.size(); ++Idx) {
+    if (Items[Idx].StackSize == 0) {
+      removeFromIndex(Handles[Idx], Items[Idx]);
+      continue;
+    }
+    if (NewSize != Idx) {
+      Items[NewSize] = std::move(Items[Idx]);
+      Handles[NewSize] = Handles[Idx];
+    }
+    ++NewSize;
+  }
+  Items.erase(Items.begin() + NewSize, Items.end());
+  Handles.resize(NewSize);
+}
+
+void Inventory::rebuildIndex() {
+  ++Revision;
+  Handles.clear();
+  SlotsByKind.clear();
+  SlotsById.clear();
+  CountById.clear();
+  Handles.reserve(Items.size());
+  for (const auto &It : Items) {
+    const auto Handle = NextHandle++;
+    Handles.push_back(Handle);
+    SlotsByKind[getKindKey(It)].push_back(Handle);
+    SlotsById[It.getId()].push_back(Handle);
+    CountById[It.getId()] += It.StackSize;
+  }
+}
 
 std::ostream &operator<<(std::ostream &OS, const Inventory &Inv) {
   OS << "Inventory:\n";
@@ -365,7 +365,7 @@ bool InventoryHandler::canCraft(const CraftingRecipe &Recipe) const {
     return false;
   }
 
-  std::map<int, unsigned> ItemCounts;
+  std::unordered_map<int, unsigned> ItemCounts;
   for (const auto &ItId : Recipe.getRequiredItems()) {
     ItemCounts[ItId] += 1;
   }
@@ -379,22 +379,25 @@ bool InventoryHandler::canCraft(const CraftingRecipe &Recipe) const {
   return true;
 }
 
-bool InventoryHandler::tryCraft(const CraftingRecipe &Recipe) {
+std::vector<CraftingRecipeId> InventoryHandler::getCraftableRecipes() const {
   // Nothing can be crafted if there is no inventory
   if (!Inv) {
-    return false;
+    return {};
   }
+  return Crafter.getCraftableRecipes(Inv->getItemCounts());
+}
 
-  if (!canCraft(Recipe)) {
+bool InventoryHandler::tryCraft(const CraftingRecipe &Recipe) {
+  // Nothing can be crafted if there is no inventory
+  if (!Inv) {
     return false;
   }
 
-  std::vector<Item> CraftItems;
-  for (const auto &ItId : Recipe.getRequiredItems()) {
-    if (auto IdxOrNone = Inv->getItemIndexForId(ItId)) {
-      CraftItems.push_back(Inv->takeItem(*IdxOrNone, 1));
-    }
+  auto CraftItemsOrNone = Inv->takeItemsById(Recipe.getRequiredItems());
+  if (!CraftItemsOrNone) {
+    return false;
   }
+  auto &CraftItems = *CraftItemsOrNone;
 
   auto NewItemsOrNone = Crafter.tryCraft(CraftItems);
   if (!NewItemsOrNone) {
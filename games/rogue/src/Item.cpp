@@ -1,17 +1,23 @@
+#include <mutex>
 #include <rogue/Components/Buffs.h>
 #include <rogue/Item.h>
 #include <rogue/ItemEffect.h>
 #include <rogue/ItemPrototype.h>
+#include <unordered_set>
 
 namespace rogue {
 
-Item::Item(const ItemPrototype &Proto, int StackSize,
-           const std::shared_ptr<const ItemPrototype> &Spec, bool SpecOverrides)
-    : StackSize(StackSize), Proto(&Proto), Specialization(Spec),
-      SpecOverrides(SpecOverrides) {}
-
 namespace {
 
+/// Returns the interned copy of \p Str, interned strings are never released.
+/// Items may be created concurrently when generating levels.
+const std::string &internString(std::string Str) {
+  static std::mutex Mutex;
+  static std::unordered_set<std::string> Strings;
+  std::lock_guard<std::mutex> Lock(Mutex);
+  return *Strings.insert(std::move(Str)).first;
+}
+
 std::string getQualifierNameForHash(std::size_t Hash) {
   static constexpr std::array Runes = {"f", "u", "t", "o", "r", "k", "o",
                                        "n", "i", "s", "x", "v", "y", "z"};
@@ -30,15 +36,12 @@ std::string getQualifierNameForItem(const Item &It, CapabilityFlags Flags) {
   // Check for stats buff effect and return name based strongest
   // stat point boost
   std::size_t Hash = 0;
-  for (const auto &ItEff : It.getAllEffects()) {
-    if (!(ItEff.Attributes.Flags.is(Flags))) {
-      continue;
-    }
+  It.forEachEffect(Flags, [&Hash](const auto &ItEff) {
     if (dynamic_cast<const NullEffect *>(ItEff.Effect.get())) {
-      continue;
+      return;
     }
     Hash ^= std::hash<std::string>{}(ItEff.Effect->getDescription());
-  }
+  });
   if (Hash != 0) {
     return getQualifierNameForHash(Hash);
   }
@@ -47,6 +50,25 @@ std::string getQualifierNameForItem(const Item &It, CapabilityFlags Flags) {
 
 } // namespace
 
+Item::Item(const ItemPrototype &Proto, int StackSize,
+           const std::shared_ptr<const ItemPrototype> &Spec, bool SpecOverrides)
+    : StackSize(StackSize), Proto(&Proto), Specialization(Spec),
+      SpecOverrides(SpecOverrides), AllEffects(&Proto.Effects) {
+  if (Specialization && (SpecOverrides || Proto.Effects.empty())) {
+    AllEffects = &Specialization->Effects;
+  } else if (Specialization && !Specialization->Effects.empty()) {
+    auto Merged = std::make_shared<std::vector<EffectInfo>>();
+    Merged->reserve(Proto.Effects.size() + Specialization->Effects.size());
+    Merged->insert(Merged->end(), Proto.Effects.begin(), Proto.Effects.end());
+    Merged->insert(Merged->end(), Specialization->Effects.begin(),
+                   Specialization->Effects.end());
+    AllEffects = Merged.get();
+    MergedEffects = std::move(Merged);
+  }
+  Index = EffectIndex(*AllEffects);
+  QualifierName = &internString(computeQualifierName());
+}
+
 ItemProtoId Item::getId() const { return getProto().ItemId; }
 
 const std::string &Item::getName() const {
@@ -57,7 +79,7 @@ const std::string &Item::getName() const {
   }
 }
 
-std::string Item::getQualifierName() const {
+std::string Item::computeQualifierName() const {
   auto Name = getProto().Name;
   if (Specialization && SpecOverrides) {
     Name = Specialization->Name;
@@ -71,7 +93,7 @@ std::string Item::getQualifierName() const {
   return Name;
 }
 
-std::string Item::getDescription() const {
+const std::string &Item::getDescription() const {
   if (Specialization && SpecOverrides) {
     return Specialization->Description;
   }
@@ -102,50 +124,6 @@ const std::optional<ItemType> &Item::getEnhanceFilterType() const {
   return getProto().EnhanceTypeFilter;
 }
 
-std::vector<EffectInfo> Item::getAllEffects() const {
-  if (Specialization && SpecOverrides) {
-    return Specialization->Effects;
-  }
-  std::vector<EffectInfo> AllEffects;
-  auto NumEffects = getProto().Effects.size();
-  NumEffects += Specialization ? Specialization->Effects.size() : 0;
-  AllEffects.reserve(NumEffects);
-
-  for (const auto &Info : getProto().Effects) {
-    AllEffects.push_back(Info);
-  }
-  if (Specialization) {
-    for (const auto &Info : Specialization->Effects) {
-      AllEffects.push_back(Info);
-    }
-  }
-  return AllEffects;
-}
-
-bool Item::hasEffect(CapabilityFlags Flags, bool AllowNull,
-                     bool AllowRemove) const {
-  bool HasEffect = false;
-  if (Specialization) {
-    HasEffect = Specialization->hasEffect(Flags, AllowNull, AllowRemove);
-    if (SpecOverrides) {
-      return HasEffect;
-    }
-  }
-  return HasEffect || getProto().hasEffect(Flags, AllowNull, AllowRemove);
-}
-
-CapabilityFlags Item::getCapabilityFlags() const {
-  if (Specialization && SpecOverrides) {
-    return Specialization->getCapabilityFlags();
-  }
-
-  auto Flags = getProto().getCapabilityFlags();
-  if (Specialization) {
-    Flags = Flags | Specialization->getCapabilityFlags();
-  }
-  return Flags;
-}
-
 bool Item::isSameKind(const Item &Other) const {
   return Proto == Other.Proto && Specialization == Other.Specialization;
 }
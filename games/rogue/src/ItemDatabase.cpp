@@ -587,6 +587,12 @@ void ItemDatabase::addItemProto(
 
 Item ItemDatabase::createItem(ItemProtoId ItemId, int StackSize,
                               bool AllowEnchanting) const {
+  auto Rng = makeGameRandomEngine();
+  return createItem(ItemId, StackSize, Rng, AllowEnchanting);
+}
+
+Item ItemDatabase::createItem(ItemProtoId ItemId, int StackSize,
+                              RandomEngine &Rng, bool AllowEnchanting) const {
   auto It = ItemProtos.find(ItemId);
   if (It == ItemProtos.end()) {
     throw std::out_of_range("Unknown item id: " + std::to_string(ItemId));
@@ -594,7 +600,7 @@ Item ItemDatabase::createItem(ItemProtoId ItemId, int StackSize,
   // Actualize the specialization
   std::shared_ptr<ItemPrototype> Spec = nullptr;
   if (auto SpecIt = ItemSpecs.find(ItemId); SpecIt != ItemSpecs.end()) {
-    Spec = SpecIt->second.actualize(It->second);
+    Spec = SpecIt->second.actualize(It->second, Rng);
   }
 
   auto NewItem = Item(It->second, StackSize, Spec);
@@ -602,11 +608,11 @@ Item ItemDatabase::createItem(ItemProtoId ItemId, int StackSize,
   // Craft enhancements
   if (auto EnhIt = ItemEnhancements.find(ItemId);
       AllowEnchanting && EnhIt != ItemEnhancements.end() && EnhIt->second) {
-    auto LootRewards = EnhIt->second->generateLoot();
+    auto LootRewards = EnhIt->second->generateLoot(Rng);
     std::vector<Item> LootItems;
     for (const auto &Reward : LootRewards) {
       for (unsigned I = 0; I < Reward.Count; ++I) {
-        LootItems.push_back(createItem(Reward.ItId, 1));
+        LootItems.push_back(createItem(Reward.ItId, 1, Rng));
       }
     }
     CraftingHandler Crafter;
@@ -644,6 +650,7 @@ LootTable &ItemDatabase::addLootTable(const std::string &Name) {
     throw std::out_of_range("Loot table with name '" + Name +
                             "' already exists");
   }
+  LootDropCalc = LootDropCalculator();
   return *It->second;
 }
 
@@ -661,6 +668,11 @@ ItemDatabase::getLootTables() const {
   return LootTables;
 }
 
+const LootDropRates &
+ItemDatabase::getLootDropRates(const std::string &Name) const {
+  return LootDropCalc.getDropRates(*getLootTable(Name));
+}
+
 const std::shared_ptr<ItemEffect> &
 ItemDatabase::getItemEffect(const std::string &Name) const {
   const auto It = Effects.find(Name);
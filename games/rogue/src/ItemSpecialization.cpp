@@ -6,17 +6,20 @@
 
 namespace rogue {
 
-std::shared_ptr<ItemEffect> StatsBuffSpecialization::createEffect() const {
+std::shared_ptr<ItemEffect>
+StatsBuffSpecialization::createEffect(RandomEngine &Rng) const {
   // Compute points to spent
   assert(MinPoints <= MaxPoints);
-  StatPoint Points = std::rand() % (MaxPoints - MinPoints + 1) + MinPoints;
+  std::uniform_int_distribution<StatPoint> PointsDist(MinPoints, MaxPoints);
+  StatPoint Points = PointsDist(Rng);
 
   StatPoints Stats;
   auto AllStats = Stats.all();
 
   // Distribute points
+  std::uniform_int_distribution<std::size_t> StatDist(0, AllStats.size() - 1);
   while (Points-- > 0) {
-    auto *Stat = AllStats[std::rand() % AllStats.size()];
+    auto *Stat = AllStats[StatDist(Rng)];
     *Stat += 1;
   }
 
@@ -31,11 +34,12 @@ void ItemSpecializations::addSpecialization(
 }
 
 std::shared_ptr<ItemPrototype>
-ItemSpecializations::actualize(const ItemPrototype &Proto) const {
+ItemSpecializations::actualize(const ItemPrototype &Proto,
+                               RandomEngine &Rng) const {
   std::vector<EffectInfo> AllEffects;
   AllEffects.reserve(Generators.size());
   for (const auto &Gen : Generators) {
-    AllEffects.push_back({Gen.Attributes, Gen.Specialization->createEffect()});
+    AllEffects.push_back({Gen.Attributes, Gen.Specialization->createEffect(Rng)});
   }
   return std::make_shared<ItemPrototype>(Proto.ItemId, Proto.Name,
                                          Proto.Description, Proto.Type,
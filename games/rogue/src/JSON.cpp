@@ -1,32 +1,59 @@
+#include <algorithm>
+#include <atomic>
 #include <fstream>
+#include <map>
+#include <memory>
+#include <mutex>
 #include <rapidjson/schema.h>
 #include <rapidjson/stringbuffer.h>
+#include <rogue/DataBundle.h>
 #include <rogue/JSON.h>
 #include <sstream>
 #include <string>
+#include <unordered_set>
 
 namespace {
-std::pair<std::string, rapidjson::Document>
-loadJSON(const std::filesystem::path &JsonFile) {
-  rapidjson::Document Doc;
-  std::ifstream FileIn(JsonFile);
+
+std::uint64_t hashContent(const char *Data, std::size_t Size) {
+  // FNV-1a
+  std::uint64_t Hash = 0xcbf29ce484222325ULL;
+  for (std::size_t Idx = 0; Idx < Size; ++Idx) {
+    Hash ^= static_cast<unsigned char>(Data[Idx]);
+    Hash *= 0x100000001b3ULL;
+  }
+  return Hash;
+}
+
+rogue::JSONBuffer makeBuffer(std::string_view Data) {
+  rogue::JSONBuffer Buffer(Data.size() + 1);
+  std::copy(Data.begin(), Data.end(), Buffer.begin());
+  Buffer.back() = '\0';
+  return Buffer;
+}
+
+rogue::JSONBuffer readFile(const std::filesystem::path &JsonFile) {
+  // Read the file with a single read, reserving space for the terminator
+  std::ifstream FileIn(JsonFile, std::ios::binary | std::ios::ate);
   if (!FileIn.is_open()) {
     throw std::runtime_error("Failed to open JSON file: " + JsonFile.string());
   }
-  std::string JsonStr((std::istreambuf_iterator<char>(FileIn)),
-                      std::istreambuf_iterator<char>());
-  Doc.Parse(JsonStr.c_str());
-  if (Doc.HasParseError()) {
-    throw std::runtime_error("Failed to parse JSON file: " + JsonFile.string());
+  const auto Size = static_cast<std::size_t>(FileIn.tellg());
+  rogue::JSONBuffer Buffer(Size + 1);
+  FileIn.seekg(0);
+  FileIn.read(Buffer.data(), Size);
+  if (!FileIn) {
+    throw std::runtime_error("Failed to read JSON file: " + JsonFile.string());
   }
-  return {JsonStr, std::move(Doc)};
+  Buffer.back() = '\0';
+  return Buffer;
 }
 
-std::tuple<std::string, rapidjson::Document, rapidjson::SchemaDocument>
-loadSchema(const std::filesystem::path &SchemaFile) {
-  auto [SchemaJsonStr, SchemaDoc] = loadJSON(SchemaFile);
-  rapidjson::SchemaDocument Schema(SchemaDoc);
-  return {SchemaJsonStr, std::move(SchemaDoc), std::move(Schema)};
+void parseInsitu(rapidjson::Document &Doc, rogue::JSONBuffer &Buffer,
+                 const std::filesystem::path &JsonFile) {
+  Doc.ParseInsitu(Buffer.data());
+  if (Doc.HasParseError()) {
+    throw std::runtime_error("Failed to parse JSON file: " + JsonFile.string());
+  }
 }
 
 void assertValidates(const rapidjson::Document &Doc,
@@ -50,18 +77,145 @@ void assertValidates(const rapidjson::Document &Doc,
     throw std::runtime_error(SS.str());
   }
 }
+
+/// Compiled schema, the schema document references the parsed document which
+/// references the buffer, hence it is never moved once created
+struct CompiledSchema {
+  std::filesystem::file_time_type WriteTime;
+  std::uintmax_t FileSize = 0;
+  rogue::JSONBuffer Buffer;
+  rapidjson::Document Doc;
+  std::unique_ptr<rapidjson::SchemaDocument> Schema;
+
+  /// Hashes of file contents that passed validation against this schema
+  std::unordered_set<std::uint64_t> ValidatedHashes;
+};
+
+class SchemaCache {
+public:
+  static SchemaCache &get() {
+    static SchemaCache Instance;
+    return Instance;
+  }
+
+  /// Validates the document against the schema, throws if invalid
+  void validate(const rapidjson::Document &Doc, std::uint64_t DocHash,
+                const std::filesystem::path &DocPath,
+                const std::filesystem::path &SchemaPath) {
+    auto Schema = getSchema(SchemaPath);
+    const bool Skip = Mode == rogue::JSONValidationMode::SkipValidated;
+    if (Skip) {
+      std::lock_guard<std::mutex> Lock(Mutex);
+      if (Schema->ValidatedHashes.count(DocHash)) {
+        return;
+      }
+    }
+
+    ++NumValidations;
+    assertValidates(Doc, DocPath, *Schema->Schema, SchemaPath);
+
+    if (Skip) {
+      std::lock_guard<std::mutex> Lock(Mutex);
+      Schema->ValidatedHashes.insert(DocHash);
+    }
+  }
+
+  void clear() {
+    std::lock_guard<std::mutex> Lock(Mutex);
+    Schemas.clear();
+  }
+
+  std::atomic<rogue::JSONValidationMode> Mode =
+      rogue::JSONValidationMode::SkipValidated;
+  std::atomic<std::size_t> NumValidations = 0;
+
+private:
+  std::shared_ptr<CompiledSchema>
+  getSchema(const std::filesystem::path &SchemaPath) {
+    const auto WriteTime = std::filesystem::last_write_time(SchemaPath);
+    const auto FileSize = std::filesystem::file_size(SchemaPath);
+    const auto Key =
+        std::filesystem::absolute(SchemaPath).lexically_normal().string();
+
+    std::lock_guard<std::mutex> Lock(Mutex);
+    auto &Schema = Schemas[Key];
+    if (!Schema || Schema->WriteTime != WriteTime ||
+        Schema->FileSize != FileSize) {
+      auto NewSchema = std::make_shared<CompiledSchema>();
+      NewSchema->WriteTime = WriteTime;
+      NewSchema->FileSize = FileSize;
+      NewSchema->Buffer = readFile(SchemaPath);
+      parseInsitu(NewSchema->Doc, NewSchema->Buffer, SchemaPath);
+      NewSchema->Schema =
+          std::make_unique<rapidjson::SchemaDocument>(NewSchema->Doc);
+      Schema = std::move(NewSchema);
+    }
+    return Schema;
+  }
+
+private:
+  std::mutex Mutex;
+  std::map<std::string, std::shared_ptr<CompiledSchema>> Schemas;
+};
+
+rogue::JSONLoadObserver &getJSONLoadObserver() {
+  static rogue::JSONLoadObserver Observer;
+  return Observer;
+}
+
 } // namespace
 
 namespace rogue {
 
-std::pair<std::string, JSONDocument>
+void setJSONLoadObserver(JSONLoadObserver Observer) {
+  getJSONLoadObserver() = std::move(Observer);
+}
+
+void setJSONValidationMode(JSONValidationMode Mode) {
+  SchemaCache::get().Mode = Mode;
+}
+
+void clearJSONSchemaCache() { SchemaCache::get().clear(); }
+
+std::size_t getJSONValidationCount() {
+  return SchemaCache::get().NumValidations;
+}
+
+std::pair<JSONBuffer, JSONDocument>
 loadJSON(const std::filesystem::path &JsonPath,
          const std::filesystem::path *SchemaPath) {
-  auto [DocStr, Doc] = ::loadJSON(JsonPath);
+  JSONDocument Doc;
+  if (auto Bundle = DataBundle::getActive()) {
+    if (auto Data = Bundle->getIfCurrent(JsonPath, SchemaPath)) {
+      auto Buffer = makeBuffer(*Data);
+      parseInsitu(Doc, Buffer, JsonPath);
+      return {std::move(Buffer), std::move(Doc)};
+    }
+  }
+
+  auto Buffer = readFile(JsonPath);
+  const auto Size = Buffer.size() - 1;
+
+  // In-situ parsing modifies the buffer, keep the original text for observers
+  const auto &Observer = getJSONLoadObserver();
+  std::string Text;
+  if (Observer) {
+    Text.assign(Buffer.data(), Size);
+  }
+
+  std::uint64_t Hash = 0;
+  if (SchemaPath) {
+    Hash = hashContent(Buffer.data(), Size);
+  }
+
+  parseInsitu(Doc, Buffer, JsonPath);
   if (SchemaPath) {
-    auto [SchemaJsonStr, SchemaDoc, Schema] = ::loadSchema(*SchemaPath);
-    assertValidates(Doc, JsonPath, Schema, *SchemaPath);
+    SchemaCache::get().validate(Doc, Hash, JsonPath, *SchemaPath);
+  }
+  if (Observer) {
+    Observer(JsonPath, Text, SchemaPath);
   }
-  return {DocStr, std::move(Doc)};
+  return {std::move(Buffer), std::move(Doc)};
 }
-} // namespace rogue
\ No newline at end of file
+
+} // namespace rogue
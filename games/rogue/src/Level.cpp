@@ -1,8 +1,10 @@
+#include <rogue/Components/Items.h>
 #include <rogue/Components/LOS.h>
 #include <rogue/Components/Level.h>
 #include <rogue/Components/Player.h>
 #include <rogue/Components/Transform.h>
 #include <rogue/Level.h>
+#include <rogue/Profiler.h>
 #include <rogue/Systems/AgilitySystem.h>
 #include <rogue/Systems/AttackAISystem.h>
 #include <rogue/Systems/CombatSystem.h>
@@ -13,6 +15,7 @@
 #include <rogue/Systems/PlayerSystem.h>
 #include <rogue/Systems/RegenSystem.h>
 #include <rogue/Systems/StatsSystem.h>
+#include <rogue/Systems/TimedBuffSystem.h>
 #include <rogue/Systems/WanderAISystem.h>
 #include <rogue/Systems/SearchAISystem.h>
 #include <sstream>
@@ -27,6 +30,7 @@ const std::vector<std::string> Level::LayerNames = {
 Level::Level(int LevelId, ymir::Size2d<int> Size)
     : Map(LayerNames, Size), LevelId(LevelId), PlayerSeenMap(Size) {
   Systems = {
+      std::make_shared<TimedBuffSystem>(Reg),
       std::make_shared<StatsSystem>(Reg),
       std::make_shared<LOSSystem>(Reg),
       std::make_shared<AgilitySystem>(Reg),
@@ -51,9 +55,16 @@ void Level::setEventHub(EventHub *Hub) {
 }
 
 bool Level::update(bool IsTick) {
+  Profiler::ScopedTimer Timer("Level::update");
+
+  // Deferrable events published by systems are dispatched once all systems
+  // have been updated, if queuing is enabled on the event hub
+  EventHub::QueueScope EvQueueScope(Hub);
+
   updateEntityPosCache();
 
   for (auto &Sys : Systems) {
+    Profiler::ScopedTimer SysTimer(Sys->getName());
     Sys->update(IsTick ? System::UpdateType::Tick : System::UpdateType::NoTick);
   }
 
@@ -62,8 +73,10 @@ bool Level::update(bool IsTick) {
   return true;
 }
 
-void Level::createPlayer() {
-  Player = PlayerComp::createPlayer(Reg, "Player", getLevelStartPos());
+void Level::createPlayer() { createPlayer(getLevelStartPos()); }
+
+void Level::createPlayer(ymir::Point2d<int> AtPos) {
+  Player = PlayerComp::createPlayer(Reg, "Player", AtPos);
 }
 
 bool Level::hasPlayer() const { return Reg.valid(Player); }
@@ -213,10 +226,33 @@ Level::getDijkstraMap(Tile Target, std::size_t Layer) const {
 
 void Level::revealMap() { PlayerSeenMap.fill(true); }
 
+ymir::Map<bool, int> &Level::getPlayerSeenMap() { return PlayerSeenMap; }
+
 const ymir::Map<bool, int> &Level::getPlayerSeenMap() const {
   return PlayerSeenMap;
 }
 
+std::size_t Level::getMemoryUsage() const {
+  // Component pools are type erased, each component is estimated by its
+  // sparse and packed entry plus an average payload
+  static constexpr std::size_t ComponentBytes = 64;
+
+  const auto Size = Map.getSize();
+  const auto NumTiles = static_cast<std::size_t>(Size.W * Size.H);
+  std::size_t Bytes = sizeof(Level);
+  Bytes += NumTiles * LayerNames.size() * sizeof(Tile);
+  Bytes += NumTiles * (sizeof(entt::entity) + sizeof(bool));
+  for (const auto &[Id, Pool] : Reg.storage()) {
+    Bytes += Pool.size() * (2 * sizeof(entt::entity) + ComponentBytes);
+  }
+
+  // Items of inventories are stored outside of the pools
+  Reg.view<const InventoryComp>().each([&Bytes](const auto &IC) {
+    Bytes += IC.Inv.getItems().size() * sizeof(Item);
+  });
+  return Bytes;
+}
+
 const entt::entity &Level::getEntityAt(ymir::Point2d<int> AtPos) const {
   if (!EntityPosCache.contains(AtPos)) {
     static const entt::entity EtNull = entt::null;
@@ -138,4 +138,9 @@ void LevelDatabase::addLevelTable(const std::string &LevelName,
   LevelsByName[LevelName] = LC;
 }
 
+const std::map<std::string, std::shared_ptr<LevelTable>> &
+LevelDatabase::getLevelTables() const {
+  return LevelsByName;
+}
+
 } // namespace rogue
\ No newline at end of file
@@ -1,3 +1,5 @@
+#include <algorithm>
+#include <atomic>
 #include <rogue/Components/Items.h>
 #include <rogue/Components/Level.h>
 #include <rogue/Components/RaceFaction.h>
@@ -10,6 +12,7 @@
 #include <rogue/LevelGenerator.h>
 #include <rogue/LootTable.h>
 #include <rogue/Parser.h>
+#include <rogue/Random.h>
 #include <ymir/Config/Types.hpp>
 #include <ymir/Dungeon/BuilderPass.hpp>
 #include <ymir/Dungeon/CaveRoomGenerator.hpp>
@@ -23,25 +26,26 @@
 #include <ymir/Dungeon/RoomPlacer.hpp>
 #include <ymir/Dungeon/StartEndPlacer.hpp>
 #include <ymir/MapIo.hpp>
+#include <thread>
 
 namespace rogue {
 
 LevelGenerator::LevelGenerator(const GameContext &Ctx,
-                               const std::filesystem::path &DataDir)
-    : Ctx(Ctx), DataDir(DataDir) {}
+                               const std::filesystem::path &DataDir,
+                               unsigned Seed)
+    : Ctx(Ctx), DataDir(DataDir), Seed(Seed) {}
 
-void LevelGenerator::spawnEntities(const LevelEntityConfig &Cfg,
-                                   Level &L) const {
-  auto &EntitiesMap = L.Map.get(Level::LayerEntitiesIdx);
-  const auto AllEntitiesPos = EntitiesMap.findTilesNot(Level::EmptyTile);
-  for (const auto &EntityPos : AllEntitiesPos) {
-    spawnEntity(EntitiesMap.getTile(EntityPos).kind(), Cfg, L, EntityPos);
+namespace {
+
+void placeEntity(entt::registry &Reg, entt::entity Entity, int LevelId) {
+  if (auto *LSC = Reg.try_get<LevelStartComp>(Entity)) {
+    LSC->NextLevelId = LevelId - 1;
+  }
+  if (auto *LEC = Reg.try_get<LevelEndComp>(Entity)) {
+    LEC->NextLevelId = LevelId + 1;
   }
-  EntitiesMap.fill(Level::EmptyTile);
 }
 
-namespace {
-
 void spawnAndPlaceEntity(EntityFactory &Factory, ymir::Point2d<int> Pos,
                          EntityTemplateId EtId, int LevelId) {
   auto Entity = Factory.createEntity(EtId);
@@ -49,19 +53,42 @@ void spawnAndPlaceEntity(EntityFactory &Factory, ymir::Point2d<int> Pos,
   if (auto *PC = Reg.try_get<PositionComp>(Entity)) {
     PC->Pos = Pos;
   }
-  if (auto *LSC = Reg.try_get<LevelStartComp>(Entity)) {
-    LSC->NextLevelId = LevelId - 1;
-  }
-  if (auto *LEC = Reg.try_get<LevelEndComp>(Entity)) {
-    LEC->NextLevelId = LevelId + 1;
-  }
+  placeEntity(Reg, Entity, LevelId);
 }
 
 } // namespace
 
-void LevelGenerator::spawnEntity(char Char, const LevelEntityConfig &Cfg,
-                                 Level &L, ymir::Point2d<int> Pos) const {
+void LevelGenerator::initRandomEngine(Level &L) const {
+  L.Reg.ctx().emplace<RandomEngine>(
+      makeLevelRandomEngine(Seed, L.getLevelId()));
+}
+
+void LevelGenerator::spawnEntities(const LevelEntityConfig &Cfg,
+                                   Level &L) const {
+  auto &EntitiesMap = L.Map.get(Level::LayerEntitiesIdx);
+  const auto AllEntitiesPos = EntitiesMap.findTilesNot(Level::EmptyTile);
+
+  // Group positions by entity template so all entities of a template are
+  // created as one batch
+  std::map<char, std::vector<ymir::Point2d<int>>> PositionsByChar;
+  for (const auto &EntityPos : AllEntitiesPos) {
+    PositionsByChar[EntitiesMap.getTile(EntityPos).kind()].push_back(
+        EntityPos);
+  }
+
   EntityFactory Factory(L.Reg, Ctx.EntityDb);
+  for (const auto &[Char, Positions] : PositionsByChar) {
+    const auto EtId = getEntityTemplateId(Char, Cfg, Positions.front());
+    for (const auto Entity : Factory.createEntities(EtId, Positions)) {
+      placeEntity(L.Reg, Entity, L.getLevelId());
+    }
+  }
+  EntitiesMap.fill(Level::EmptyTile);
+}
+
+EntityTemplateId
+LevelGenerator::getEntityTemplateId(char Char, const LevelEntityConfig &Cfg,
+                                    ymir::Point2d<int> Pos) const {
   auto It = Cfg.Entities.find(Char);
   if (It == Cfg.Entities.end()) {
     std::stringstream SS;
@@ -72,18 +99,24 @@ void LevelGenerator::spawnEntity(char Char, const LevelEntityConfig &Cfg,
     }
     throw std::out_of_range(SS.str());
   }
-  spawnAndPlaceEntity(Factory, Pos,
-                      Ctx.EntityDb.getEntityTemplateId(It->second),
+  return Ctx.EntityDb.getEntityTemplateId(It->second);
+}
+
+void LevelGenerator::spawnEntity(char Char, const LevelEntityConfig &Cfg,
+                                 Level &L, ymir::Point2d<int> Pos) const {
+  EntityFactory Factory(L.Reg, Ctx.EntityDb);
+  spawnAndPlaceEntity(Factory, Pos, getEntityTemplateId(Char, Cfg, Pos),
                       L.getLevelId());
 }
 
 EmptyLevelGenerator::EmptyLevelGenerator(const GameContext &Ctx,
                                          const std::filesystem::path &DataDir,
-                                         const Config &Cfg)
-    : LevelGenerator(Ctx, DataDir), Cfg(Cfg) {}
+                                         const Config &Cfg, unsigned Seed)
+    : LevelGenerator(Ctx, DataDir, Seed), Cfg(Cfg) {}
 
 std::shared_ptr<Level> EmptyLevelGenerator::generateLevel(int LevelId) const {
   auto NewLevel = std::make_shared<Level>(LevelId, Cfg.Size);
+  initRandomEngine(*NewLevel);
 
   NewLevel->Reg.ctx().emplace<GameContext>(Ctx);
   NewLevel->Reg.ctx().emplace<Level *>(NewLevel.get());
@@ -93,8 +126,8 @@ std::shared_ptr<Level> EmptyLevelGenerator::generateLevel(int LevelId) const {
 
 DesignedMapLevelGenerator::DesignedMapLevelGenerator(
     const GameContext &Ctx, const std::filesystem::path &DataDir,
-    const Config &Cfg)
-    : LevelGenerator(Ctx, DataDir), Cfg(Cfg) {}
+    const Config &Cfg, unsigned Seed)
+    : LevelGenerator(Ctx, DataDir, Seed), Cfg(Cfg) {}
 
 std::shared_ptr<Level>
 DesignedMapLevelGenerator::generateLevel(int LevelId) const {
@@ -114,6 +147,7 @@ std::shared_ptr<Level>
 DesignedMapLevelGenerator::createNewLevel(int LevelId) const {
   auto Map = ymir::loadMap(Cfg.MapFile);
   auto NewLevel = std::make_shared<Level>(LevelId, Map.getSize());
+  initRandomEngine(*NewLevel);
   auto &LevelMap = NewLevel->Map;
 
   // Setup the default background
@@ -138,12 +172,13 @@ bool GeneratedMapLevelGenerator::DebugRooms = false;
 GeneratedMapLevelGenerator::GeneratedMapLevelGenerator(
     const GameContext &Ctx, const std::filesystem::path &DataDir,
     const Config &Cfg)
-    : LevelGenerator(Ctx, DataDir), Cfg(Cfg) {}
+    : LevelGenerator(Ctx, DataDir, Cfg.Seed), Cfg(Cfg) {}
 
 std::shared_ptr<Level>
 GeneratedMapLevelGenerator::generateLevel(int LevelId) const {
   // Create the new level
   auto NewLevel = createNewLevel(LevelId);
+  initRandomEngine(*NewLevel);
 
   // Deal with spawning entities
   spawnEntities(Cfg.EntityConfig, *NewLevel);
@@ -247,13 +282,15 @@ CompositeMultiLevelGenerator::CompositeMultiLevelGenerator(
 
 const LevelGenerator &
 CompositeMultiLevelGenerator::getGeneratorForLevel(std::size_t LevelIdx) const {
-  for (const auto &[LvlEndIdx, Generator] : Generators) {
-    if (LvlEndIdx >= LevelIdx) {
-      return *Generator;
-    }
+  // Level ranges are sorted by their end index, see `addGenerator`
+  auto It = std::lower_bound(
+      Generators.begin(), Generators.end(), LevelIdx,
+      [](const auto &LR, std::size_t Idx) { return LR.LevelEndIdx < Idx; });
+  if (It == Generators.end()) {
+    throw std::out_of_range("No level config for level index " +
+                            std::to_string(LevelIdx));
   }
-  throw std::out_of_range("No level config for level index " +
-                          std::to_string(LevelIdx));
+  return *It->Generator;
 }
 
 void CompositeMultiLevelGenerator::addGenerator(
@@ -270,6 +307,58 @@ CompositeMultiLevelGenerator::generateLevel(int LevelId) const {
   return Generator.generateLevel(LevelId);
 }
 
+std::vector<std::shared_ptr<Level>>
+CompositeMultiLevelGenerator::generateRange(std::size_t BeginIdx,
+                                            std::size_t EndIdx,
+                                            unsigned NumThreads) const {
+  if (BeginIdx > EndIdx) {
+    throw std::out_of_range("Invalid level range " + std::to_string(BeginIdx) +
+                            "-" + std::to_string(EndIdx));
+  }
+  const auto NumLevels = EndIdx - BeginIdx;
+  if (NumThreads == 0) {
+    NumThreads = std::max(1U, std::thread::hardware_concurrency());
+  }
+  NumThreads = static_cast<unsigned>(
+      std::min<std::size_t>(NumThreads, NumLevels));
+
+  // Workers pick the next level to generate, every level is written to its
+  // own slot so the order of generation does not matter
+  std::vector<std::shared_ptr<Level>> Levels(NumLevels);
+  std::vector<std::exception_ptr> Errors(NumLevels);
+  std::atomic<std::size_t> NextIdx{0};
+  auto Work = [&]() {
+    for (auto Idx = NextIdx++; Idx < NumLevels; Idx = NextIdx++) {
+      try {
+        Levels[Idx] = generateLevel(static_cast<int>(BeginIdx + Idx));
+      } catch (...) {
+        Errors[Idx] = std::current_exception();
+      }
+    }
+  };
+
+  std::vector<std::thread> Workers;
+  for (unsigned Idx = 1; Idx < NumThreads; ++Idx) {
+    Workers.emplace_back(Work);
+  }
+  Work();
+  for (auto &Worker : Workers) {
+    Worker.join();
+  }
+
+  for (const auto &Error : Errors) {
+    if (Error) {
+      std::rethrow_exception(Error);
+    }
+  }
+  return Levels;
+}
+
+std::vector<std::shared_ptr<Level>>
+CompositeMultiLevelGenerator::generateAll(unsigned NumThreads) const {
+  return generateRange(0, getMaxLevelIdx(), NumThreads);
+}
+
 std::size_t CompositeMultiLevelGenerator::getMaxLevelIdx() const {
   if (Generators.empty()) {
     return 0;
@@ -279,8 +368,8 @@ std::size_t CompositeMultiLevelGenerator::getMaxLevelIdx() const {
 
 TiledMapLevelGenerator::TiledMapLevelGenerator(
     const GameContext &Ctx, const std::filesystem::path &DataDir,
-    const Config &Cfg)
-    : LevelGenerator(Ctx, DataDir), Cfg(Cfg) {}
+    const Config &Cfg, unsigned Seed)
+    : LevelGenerator(Ctx, DataDir, Seed), Cfg(Cfg) {}
 
 std::shared_ptr<Level>
 TiledMapLevelGenerator::generateLevel(int LevelId) const {
@@ -360,6 +449,7 @@ TiledMapLevelGenerator::createNewLevel(int LevelId) const {
   auto TileInfos = loadTileInfos(Cfg.TiledIdMapFile);
 
   auto NewLevel = std::make_shared<Level>(LevelId, TiledMap.getSize());
+  initRandomEngine(*NewLevel);
 
   static const std::array<std::size_t, 4> LayerIndices = {
       Level::LayerGroundIdx, Level::LayerGroundDecoIdx, Level::LayerWallsIdx,
@@ -549,10 +639,12 @@ LevelGeneratorLoader::create(unsigned Seed, const LevelConfig &Cfg) {
     return std::make_shared<GeneratedMapLevelGenerator>(Ctx, DataDir, *GenCfg);
   }
   if (auto *DesCfg = std::get_if<DesignedMapLevelGenerator::Config>(&Cfg)) {
-    return std::make_shared<DesignedMapLevelGenerator>(Ctx, DataDir, *DesCfg);
+    return std::make_shared<DesignedMapLevelGenerator>(Ctx, DataDir, *DesCfg,
+                                                       Seed);
   }
   if (auto *EmptyCfg = std::get_if<EmptyLevelGenerator::Config>(&Cfg)) {
-    return std::make_shared<EmptyLevelGenerator>(Ctx, DataDir, *EmptyCfg);
+    return std::make_shared<EmptyLevelGenerator>(Ctx, DataDir, *EmptyCfg,
+                                                 Seed);
   }
   if (auto *CompCfg = std::get_if<CompositeMultiLevelGenerator::Config>(&Cfg)) {
     auto CompGen = std::make_shared<CompositeMultiLevelGenerator>(Ctx, DataDir);
@@ -564,7 +656,8 @@ LevelGeneratorLoader::create(unsigned Seed, const LevelConfig &Cfg) {
     return CompGen;
   }
   if (auto *TiledCfg = std::get_if<TiledMapLevelGenerator::Config>(&Cfg)) {
-    return std::make_shared<TiledMapLevelGenerator>(Ctx, DataDir, *TiledCfg);
+    return std::make_shared<TiledMapLevelGenerator>(Ctx, DataDir, *TiledCfg,
+                                                    Seed);
   }
   throw std::out_of_range("Invalid map type");
 }
@@ -0,0 +1,89 @@
+#include <algorithm>
+#include <rogue/LevelPrefetcher.h>
+
+namespace rogue {
+
+LevelPrefetcher::~LevelPrefetcher() {
+  {
+    std::lock_guard<std::mutex> Lock(Mutex);
+    Stop = true;
+    Jobs.clear();
+  }
+  CV.notify_all();
+  if (Worker.joinable()) {
+    Worker.join();
+  }
+}
+
+void LevelPrefetcher::prefetch(std::size_t LevelIdx, GenerateFn Generate) {
+  {
+    std::lock_guard<std::mutex> Lock(Mutex);
+    if (Futures.count(LevelIdx)) {
+      return;
+    }
+    Task T(std::move(Generate));
+    Futures[LevelIdx] = T.get_future();
+    Jobs.push_back({LevelIdx, std::move(T)});
+    if (!Worker.joinable()) {
+      Worker = std::thread([this]() { run(); });
+    }
+  }
+  CV.notify_one();
+}
+
+bool LevelPrefetcher::isScheduled(std::size_t LevelIdx) const {
+  std::lock_guard<std::mutex> Lock(Mutex);
+  return Futures.count(LevelIdx) != 0;
+}
+
+std::shared_ptr<Level> LevelPrefetcher::take(std::size_t LevelIdx) {
+  std::future<std::shared_ptr<Level>> Future;
+  Task T;
+  {
+    std::lock_guard<std::mutex> Lock(Mutex);
+    auto It = Futures.find(LevelIdx);
+    if (It == Futures.end()) {
+      return nullptr;
+    }
+    Future = std::move(It->second);
+    Futures.erase(It);
+
+    // Don't wait for the worker to get to the level, generate it right away
+    auto JobIt = std::find_if(Jobs.begin(), Jobs.end(), [LevelIdx](auto &J) {
+      return J.LevelIdx == LevelIdx;
+    });
+    if (JobIt != Jobs.end()) {
+      T = std::move(JobIt->Generate);
+      Jobs.erase(JobIt);
+    }
+  }
+
+  if (T.valid()) {
+    T();
+  }
+  return Future.get();
+}
+
+void LevelPrefetcher::cancel() {
+  std::lock_guard<std::mutex> Lock(Mutex);
+  Jobs.clear();
+  Futures.clear();
+}
+
+void LevelPrefetcher::run() {
+  while (true) {
+    Task T;
+    {
+      std::unique_lock<std::mutex> Lock(Mutex);
+      CV.wait(Lock, [this]() { return Stop || !Jobs.empty(); });
+      if (Stop) {
+        return;
+      }
+      T = std::move(Jobs.front().Generate);
+      Jobs.pop_front();
+    }
+    T();
+  }
+}
+
+} // namespace rogue
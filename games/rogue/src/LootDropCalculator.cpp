@@ -0,0 +1,190 @@
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <rogue/LootDropCalculator.h>
+#include <stdexcept>
+#include <unordered_map>
+
+namespace rogue {
+
+namespace {
+
+/// Probability of an item to not drop and its expected count, independent
+/// events are combined by multiplying the probabilities and adding the counts
+struct DropAccumulator {
+  double NoneProbability = 1.0;
+  double ExpectedCount = 0.0;
+};
+
+LootDropRates
+toDropRates(const std::map<ItemProtoId, DropAccumulator> &Acc) {
+  LootDropRates Rates;
+  for (const auto &[ItId, ItAcc] : Acc) {
+    Rates[ItId] = {1.0 - ItAcc.NoneProbability, ItAcc.ExpectedCount};
+  }
+  return Rates;
+}
+
+} // namespace
+
+const LootDropRates &
+LootDropCalculator::getDropRates(const LootContainer &LC) {
+  if (auto It = Cache.find(&LC); It != Cache.end()) {
+    return It->second;
+  }
+  if (std::find(Path.begin(), Path.end(), &LC) != Path.end()) {
+    throw std::runtime_error("LootDropCalculator: Loot table contains itself");
+  }
+
+  LootDropRates Rates;
+  if (const auto *LI = dynamic_cast<const LootItem *>(&LC)) {
+    const auto MeanCount = (LI->getMinCount() + LI->getMaxCount()) / 2.0;
+    Rates[LI->getItemId()] = {1.0, MeanCount};
+  } else if (const auto *LT = dynamic_cast<const LootTable *>(&LC)) {
+    // Leave the path intact for later calls if the table can't be evaluated
+    Path.push_back(&LC);
+    try {
+      Rates = computeTableRates(*LT);
+    } catch (...) {
+      Path.pop_back();
+      throw;
+    }
+    Path.pop_back();
+  } else {
+    throw std::runtime_error("LootDropCalculator: Unknown loot container");
+  }
+  return Cache.emplace(&LC, std::move(Rates)).first->second;
+}
+
+LootDropRates LootDropCalculator::computeTableRates(const LootTable &LT) {
+  std::map<ItemProtoId, DropAccumulator> Acc;
+
+  for (const auto &Slot : LT.getGuaranteedSlots()) {
+    if (!Slot.LC) {
+      continue;
+    }
+    for (const auto &[ItId, Drop] : getDropRates(*Slot.LC)) {
+      auto &ItAcc = Acc[ItId];
+      ItAcc.NoneProbability *= 1.0 - Drop.Probability;
+      ItAcc.ExpectedCount += Drop.ExpectedCount;
+    }
+  }
+
+  // Slots without weight are never picked
+  std::vector<const LootDropRates *> Picks;
+  std::vector<double> Weights;
+  double TotalWeight = 0.0;
+  for (const auto &Slot : LT.getSlots()) {
+    if (Slot.Weight <= 0) {
+      continue;
+    }
+    Picks.push_back(Slot.LC ? &getDropRates(*Slot.LC) : nullptr);
+    Weights.push_back(Slot.Weight);
+    TotalWeight += Slot.Weight;
+  }
+  const auto NumRolls = LT.getRolls();
+  if (Picks.empty() || NumRolls == 0) {
+    return toDropRates(Acc);
+  }
+
+  std::map<ItemProtoId, DropAccumulator> PickAcc;
+  if (LT.isPickAndReturn() || NumRolls == 1) {
+    // Every roll picks from the same distribution independent of the others
+    for (std::size_t Idx = 0; Idx < Picks.size(); ++Idx) {
+      if (!Picks[Idx]) {
+        continue;
+      }
+      const auto PickProb = Weights[Idx] / TotalWeight;
+      for (const auto &[ItId, Drop] : *Picks[Idx]) {
+        auto &ItAcc = PickAcc[ItId];
+        ItAcc.NoneProbability -= PickProb * Drop.Probability;
+        ItAcc.ExpectedCount += PickProb * Drop.ExpectedCount;
+      }
+    }
+    for (auto &[ItId, ItAcc] : PickAcc) {
+      ItAcc.NoneProbability = std::pow(ItAcc.NoneProbability, NumRolls);
+      ItAcc.ExpectedCount *= NumRolls;
+    }
+  } else {
+    // Picked slots are removed, so compute the probability of every set of
+    // picked slots from the sets picked by the previous rolls
+    if (Picks.size() > 64) {
+      throw std::runtime_error(
+          "LootDropCalculator: Too many slots for picking without returns");
+    }
+    const auto NumPicks = std::min<std::size_t>(NumRolls, Picks.size());
+    std::unordered_map<std::uint64_t, double> Sets = {{0, 1.0}};
+    for (std::size_t Roll = 0; Roll < NumPicks; ++Roll) {
+      std::unordered_map<std::uint64_t, double> NextSets;
+      for (const auto &[Set, SetProb] : Sets) {
+        double LeftWeight = TotalWeight;
+        for (std::size_t Idx = 0; Idx < Picks.size(); ++Idx) {
+          if (Set & (std::uint64_t(1) << Idx)) {
+            LeftWeight -= Weights[Idx];
+          }
+        }
+        for (std::size_t Idx = 0; Idx < Picks.size(); ++Idx) {
+          const auto Bit = std::uint64_t(1) << Idx;
+          if (!(Set & Bit)) {
+            NextSets[Set | Bit] += SetProb * Weights[Idx] / LeftWeight;
+          }
+        }
+      }
+      if (NextSets.size() > MaxCombinations) {
+        throw std::runtime_error(
+            "LootDropCalculator: Too many slot combinations");
+      }
+      Sets = std::move(NextSets);
+    }
+
+    // Children of the picked slots are independent of each other
+    std::vector<double> PickedProbs(Picks.size());
+    std::map<ItemProtoId, double> NoneProbs;
+    for (const auto *Pick : Picks) {
+      if (Pick) {
+        for (const auto &[ItId, Drop] : *Pick) {
+          NoneProbs[ItId] = 0.0;
+        }
+      }
+    }
+    for (const auto &[Set, SetProb] : Sets) {
+      for (auto &[ItId, NoneProb] : NoneProbs) {
+        double SetNoneProb = SetProb;
+        for (std::size_t Idx = 0; Idx < Picks.size(); ++Idx) {
+          if (!(Set & (std::uint64_t(1) << Idx)) || !Picks[Idx]) {
+            continue;
+          }
+          if (auto It = Picks[Idx]->find(ItId); It != Picks[Idx]->end()) {
+            SetNoneProb *= 1.0 - It->second.Probability;
+          }
+        }
+        NoneProb += SetNoneProb;
+      }
+      for (std::size_t Idx = 0; Idx < Picks.size(); ++Idx) {
+        if (Set & (std::uint64_t(1) << Idx)) {
+          PickedProbs[Idx] += SetProb;
+        }
+      }
+    }
+    for (const auto &[ItId, NoneProb] : NoneProbs) {
+      PickAcc[ItId].NoneProbability = NoneProb;
+    }
+    for (std::size_t Idx = 0; Idx < Picks.size(); ++Idx) {
+      if (!Picks[Idx]) {
+        continue;
+      }
+      for (const auto &[ItId, Drop] : *Picks[Idx]) {
+        PickAcc[ItId].ExpectedCount += PickedProbs[Idx] * Drop.ExpectedCount;
+      }
+    }
+  }
+
+  for (const auto &[ItId, ItAcc] : PickAcc) {
+    auto &TableAcc = Acc[ItId];
+    TableAcc.NoneProbability *= ItAcc.NoneProbability;
+    TableAcc.ExpectedCount += ItAcc.ExpectedCount;
+  }
+  return toDropRates(Acc);
+}
+
+} // namespace rogue
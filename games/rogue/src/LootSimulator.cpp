@@ -0,0 +1,257 @@
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <rogue/LootSimulator.h>
+#include <stdexcept>
+#include <thread>
+
+namespace rogue {
+
+AliasTable::AliasTable(const std::vector<int> &Weights) {
+  std::int64_t TotalWeight = 0;
+  for (const auto Weight : Weights) {
+    if (Weight < 0) {
+      throw std::out_of_range("AliasTable: Negative weight");
+    }
+    TotalWeight += Weight;
+  }
+  if (TotalWeight == 0) {
+    return;
+  }
+
+  // Weights are scaled by the number of slots so that the average slot has
+  // the total weight, the scaled weights stay integers to keep it exact
+  const auto NumSlots = static_cast<std::int64_t>(Weights.size());
+  std::vector<std::int64_t> Scaled(Weights.size());
+  std::vector<std::size_t> Small, Large;
+  for (std::size_t Idx = 0; Idx < Weights.size(); ++Idx) {
+    Scaled[Idx] = Weights[Idx] * NumSlots;
+    (Scaled[Idx] < TotalWeight ? Small : Large).push_back(Idx);
+  }
+
+  Probs.resize(Weights.size(), 1.0);
+  Aliases.resize(Weights.size());
+  for (std::size_t Idx = 0; Idx < Aliases.size(); ++Idx) {
+    Aliases[Idx] = Idx;
+  }
+  while (!Small.empty() && !Large.empty()) {
+    const auto SmallIdx = Small.back();
+    const auto LargeIdx = Large.back();
+    Small.pop_back();
+    Large.pop_back();
+
+    Probs[SmallIdx] = static_cast<double>(Scaled[SmallIdx]) / TotalWeight;
+    Aliases[SmallIdx] = LargeIdx;
+    Scaled[LargeIdx] -= TotalWeight - Scaled[SmallIdx];
+    (Scaled[LargeIdx] < TotalWeight ? Small : Large).push_back(LargeIdx);
+  }
+}
+
+struct LootSimulator::Histogram {
+  explicit Histogram(std::size_t NumItems)
+      : Counts(NumItems), Occurrences(NumItems), LastSeen(NumItems) {}
+
+  std::vector<std::uint64_t> Counts;
+  std::vector<std::uint64_t> Occurrences;
+
+  /// Last roll (starting at one) that dropped the item
+  std::vector<std::uint64_t> LastSeen;
+};
+
+LootSimulator::LootSimulator(const LootContainer &Root) {
+  std::vector<const LootContainer *> Path;
+  RootIdx = addNode(Root, Path);
+}
+
+int LootSimulator::addNode(const LootContainer &LC,
+                           std::vector<const LootContainer *> &Path) {
+  if (auto It = Visited.find(&LC); It != Visited.end()) {
+    return It->second;
+  }
+  if (std::find(Path.begin(), Path.end(), &LC) != Path.end()) {
+    throw std::runtime_error("LootSimulator: Loot table contains itself");
+  }
+
+  Node N;
+  if (const auto *LI = dynamic_cast<const LootItem *>(&LC)) {
+    N.ItemIdx = getItemIdx(LI->getItemId());
+    N.MinCount = LI->getMinCount();
+    N.MaxCount = LI->getMaxCount();
+  } else if (const auto *LT = dynamic_cast<const LootTable *>(&LC)) {
+    Path.push_back(&LC);
+    for (const auto &Slot : LT->getGuaranteedSlots()) {
+      N.Guaranteed.push_back(Slot.LC ? addNode(*Slot.LC, Path) : NoNode);
+    }
+    for (const auto &Slot : LT->getSlots()) {
+      N.Children.push_back(Slot.LC ? addNode(*Slot.LC, Path) : NoNode);
+      N.Weights.push_back(Slot.Weight);
+      N.TotalWeight += Slot.Weight;
+    }
+    Path.pop_back();
+    N.NumRolls = LT->getRolls();
+    N.PickAndReturn = LT->isPickAndReturn();
+    N.Alias = AliasTable(N.Weights);
+  } else {
+    throw std::runtime_error("LootSimulator: Unknown loot container");
+  }
+
+  const auto NodeIdx = static_cast<int>(Nodes.size());
+  Nodes.push_back(std::move(N));
+  Visited[&LC] = NodeIdx;
+  return NodeIdx;
+}
+
+int LootSimulator::getItemIdx(ItemProtoId ItId) {
+  auto [It, Inserted] =
+      ItemIdxById.emplace(ItId, static_cast<int>(ItemIds.size()));
+  if (Inserted) {
+    ItemIds.push_back(ItId);
+  }
+  return It->second;
+}
+
+template <typename VisitFn>
+void LootSimulator::rollNode(int NodeIdx, std::mt19937 &Rng,
+                             VisitFn &Visit) const {
+  const auto &N = Nodes[NodeIdx];
+  if (N.ItemIdx != NoNode) {
+    std::uniform_int_distribution<unsigned> CountDist(N.MinCount, N.MaxCount);
+    Visit(N.ItemIdx, CountDist(Rng));
+    return;
+  }
+
+  for (const auto Child : N.Guaranteed) {
+    if (Child != NoNode) {
+      rollNode(Child, Rng, Visit);
+    }
+  }
+  if (N.Alias.empty()) {
+    return;
+  }
+
+  if (N.PickAndReturn || N.NumRolls == 1) {
+    for (unsigned Cnt = 0; Cnt < N.NumRolls; ++Cnt) {
+      const auto Child = N.Children[N.Alias.sample(Rng)];
+      if (Child != NoNode) {
+        rollNode(Child, Rng, Visit);
+      }
+    }
+    return;
+  }
+
+  // Picked slots are removed from the table, so only the first pick can use
+  // the alias table and the remaining picks scan the left over weights
+  auto Weights = N.Weights;
+  auto RemainingWeight = N.TotalWeight;
+  auto SlotIdx = N.Alias.sample(Rng);
+  for (unsigned Cnt = 0; Cnt < N.NumRolls; ++Cnt) {
+    if (Cnt > 0) {
+      if (RemainingWeight == 0) {
+        break;
+      }
+      std::uniform_int_distribution<int> RollDist(0, RemainingWeight - 1);
+      auto Roll = RollDist(Rng);
+      for (SlotIdx = 0; Roll >= Weights[SlotIdx]; ++SlotIdx) {
+        Roll -= Weights[SlotIdx];
+      }
+    }
+    if (const auto Child = N.Children[SlotIdx]; Child != NoNode) {
+      rollNode(Child, Rng, Visit);
+    }
+    RemainingWeight -= Weights[SlotIdx];
+    Weights[SlotIdx] = 0;
+  }
+}
+
+void LootSimulator::fillLoot(std::vector<LootContainer::LootReward> &Loot,
+                             std::mt19937 &Rng) const {
+  auto Visit = [this, &Loot](int ItemIdx, unsigned Count) {
+    Loot.push_back({ItemIds[ItemIdx], Count});
+  };
+  rollNode(RootIdx, Rng, Visit);
+}
+
+void LootSimulator::runBatch(std::uint64_t BatchIdx, std::uint64_t NumRolls,
+                             unsigned Seed, Histogram &Hist) const {
+  std::seed_seq SeedSeq{Seed, static_cast<unsigned>(BatchIdx),
+                        static_cast<unsigned>(BatchIdx >> 32)};
+  std::mt19937 Rng(SeedSeq);
+
+  for (std::uint64_t Roll = 1; Roll <= NumRolls; ++Roll) {
+    const auto RollId = BatchIdx * BatchSize + Roll;
+    auto Visit = [&Hist, RollId](int ItemIdx, unsigned Count) {
+      Hist.Counts[ItemIdx] += Count;
+      if (Hist.LastSeen[ItemIdx] != RollId) {
+        Hist.LastSeen[ItemIdx] = RollId;
+        Hist.Occurrences[ItemIdx] += 1;
+      }
+    };
+    rollNode(RootIdx, Rng, Visit);
+  }
+}
+
+LootSimulator::Result LootSimulator::run(std::uint64_t Rolls, unsigned Seed,
+                                         unsigned NumThreads) const {
+  const auto NumBatches = (Rolls + BatchSize - 1) / BatchSize;
+  if (NumThreads == 0) {
+    NumThreads = std::max(1U, std::thread::hardware_concurrency());
+  }
+  NumThreads = static_cast<unsigned>(std::max<std::uint64_t>(
+      1, std::min<std::uint64_t>(NumThreads, NumBatches)));
+
+  // Every worker fills its own histogram, they are merged once all batches
+  // are done
+  std::vector<Histogram> Hists(NumThreads, Histogram(ItemIds.size()));
+  std::vector<std::exception_ptr> Errors(NumThreads);
+  std::atomic<std::uint64_t> NextBatch{0};
+  auto Work = [&](unsigned ThreadIdx) {
+    try {
+      for (auto Batch = NextBatch++; Batch < NumBatches; Batch = NextBatch++) {
+        const auto NumRolls = std::min(BatchSize, Rolls - Batch * BatchSize);
+        runBatch(Batch, NumRolls, Seed, Hists[ThreadIdx]);
+      }
+    } catch (...) {
+      Errors[ThreadIdx] = std::current_exception();
+    }
+  };
+
+  std::vector<std::thread> Workers;
+  for (unsigned Idx = 1; Idx < NumThreads; ++Idx) {
+    Workers.emplace_back(Work, Idx);
+  }
+  Work(0);
+  for (auto &Worker : Workers) {
+    Worker.join();
+  }
+
+  for (const auto &Error : Errors) {
+    if (Error) {
+      std::rethrow_exception(Error);
+    }
+  }
+
+  Result Res;
+  Res.Rolls = Rolls;
+  for (std::size_t ItemIdx = 0; ItemIdx < ItemIds.size(); ++ItemIdx) {
+    ItemStats Stats;
+    Stats.ItId = ItemIds[ItemIdx];
+    for (const auto &Hist : Hists) {
+      Stats.Count += Hist.Counts[ItemIdx];
+      Stats.Occurrences += Hist.Occurrences[ItemIdx];
+    }
+    if (Stats.Occurrences != 0) {
+      Res.Total += Stats.Count;
+      Res.Items.push_back(Stats);
+    }
+  }
+  std::sort(Res.Items.begin(), Res.Items.end(),
+            [](const auto &A, const auto &B) {
+              if (A.Count != B.Count) {
+                return A.Count > B.Count;
+              }
+              return A.ItId > B.ItId;
+            });
+  return Res;
+}
+
+} // namespace rogue
@@ -6,12 +6,23 @@
 
 namespace rogue {
 
-std::vector<LootContainer::LootReward> LootContainer::generateLoot() const {
+std::vector<LootContainer::LootReward>
+LootContainer::generateLoot(RandomEngine &Rng) const {
   std::vector<LootContainer::LootReward> Loot;
-  fillLoot(Loot);
+  fillLoot(Loot, Rng);
   return Loot;
 }
 
+void LootContainer::fillLoot(std::vector<LootReward> &Loot) const {
+  auto Rng = makeGameRandomEngine();
+  fillLoot(Loot, Rng);
+}
+
+std::vector<LootContainer::LootReward> LootContainer::generateLoot() const {
+  auto Rng = makeGameRandomEngine();
+  return generateLoot(Rng);
+}
+
 LootItem::LootItem(ItemProtoId ItId, unsigned MinCount, unsigned MaxCount)
     : ItId(ItId), MinCount(MinCount), MaxCount(MaxCount) {
   assert(MinCount <= MaxCount && MinCount > 0);
@@ -19,9 +30,10 @@ LootItem::LootItem(ItemProtoId ItId, unsigned MinCount, unsigned MaxCount)
 
 ItemProtoId LootItem::getItemId() const { return ItId; }
 
-void LootItem::fillLoot(std::vector<LootReward> &Loot) const {
-  auto Count = MinCount + std::rand() % (MaxCount - MinCount + 1);
-  Loot.push_back({ItId, Count});
+void LootItem::fillLoot(std::vector<LootReward> &Loot,
+                        RandomEngine &Rng) const {
+  std::uniform_int_distribution<unsigned> CountDist(MinCount, MaxCount);
+  Loot.push_back({ItId, CountDist(Rng)});
 }
 
 std::size_t LootTable::getSlotForRoll(int Roll,
@@ -35,14 +47,14 @@ std::size_t LootTable::getSlotForRoll(int Roll,
   throw std::runtime_error("LootTable::getSlotForRoll() failed");
 }
 
-std::size_t LootTable::rollForSlot(const std::vector<LootSlot> &Slots) {
-  // FIXME this needs to be based on the seed as well
+std::size_t LootTable::rollForSlot(const std::vector<LootSlot> &Slots,
+                                   RandomEngine &Rng) {
   int TotalWeight = 0;
   for (const auto &Slot : Slots) {
     TotalWeight += Slot.Weight;
   }
-  int Roll = std::rand() % TotalWeight;
-  return getSlotForRoll(Roll, Slots);
+  std::uniform_int_distribution<int> RollDist(0, TotalWeight - 1);
+  return getSlotForRoll(RollDist(Rng), Slots);
 }
 
 LootTable::LootTable() { reset(0, {}); }
@@ -82,35 +94,38 @@ const std::vector<LootTable::LootSlot> &LootTable::getGuaranteedSlots() const {
   return GuaranteedSlots;
 }
 
-void LootTable::fillGuaranteedLoot(std::vector<LootReward> &Loot) const {
+void LootTable::fillGuaranteedLoot(std::vector<LootReward> &Loot,
+                                   RandomEngine &Rng) const {
   for (const auto &Slot : GuaranteedSlots) {
     if (!Slot.LC) {
       continue;
     }
-    Slot.LC->fillLoot(Loot);
+    Slot.LC->fillLoot(Loot, Rng);
   }
 }
 
-void LootTable::fillLoot(std::vector<LootReward> &Loot) const {
-  fillGuaranteedLoot(Loot);
+void LootTable::fillLoot(std::vector<LootReward> &Loot,
+                         RandomEngine &Rng) const {
+  fillGuaranteedLoot(Loot, Rng);
   if (PickAndReturn) {
-    fillLootWithReturns(Loot);
+    fillLootWithReturns(Loot, Rng);
   } else {
-    fillLootNoReturns(Loot);
+    fillLootNoReturns(Loot, Rng);
   }
 }
 
-void LootTable::fillLootNoReturns(std::vector<LootReward> &Loot) const {
+void LootTable::fillLootNoReturns(std::vector<LootReward> &Loot,
+                                  RandomEngine &Rng) const {
   std::vector<LootSlot> LeftOverSlots = Slots;
   for (unsigned Cnt = 0; Cnt < NumRolls; Cnt++) {
     if (LeftOverSlots.empty()) {
       break;
     }
 
-    auto SlotIdx = rollForSlot(LeftOverSlots);
+    auto SlotIdx = rollForSlot(LeftOverSlots, Rng);
     const auto &Slot = LeftOverSlots.at(SlotIdx);
     if (Slot.LC) {
-      Slot.LC->fillLoot(Loot);
+      Slot.LC->fillLoot(Loot, Rng);
     }
 
     // Remove the slot so the given entry can not be included again
@@ -119,15 +134,16 @@ void LootTable::fillLootNoReturns(std::vector<LootReward> &Loot) const {
   }
 }
 
-void LootTable::fillLootWithReturns(std::vector<LootReward> &Loot) const {
+void LootTable::fillLootWithReturns(std::vector<LootReward> &Loot,
+                                    RandomEngine &Rng) const {
   if (Slots.empty()) {
     return;
   }
   for (unsigned Cnt = 0; Cnt < NumRolls; Cnt++) {
-    auto SlotIdx = rollForSlot(Slots);
+    auto SlotIdx = rollForSlot(Slots, Rng);
     const auto &Slot = Slots.at(SlotIdx);
     if (Slot.LC) {
-      Slot.LC->fillLoot(Loot);
+      Slot.LC->fillLoot(Loot, Rng);
     }
   }
 }
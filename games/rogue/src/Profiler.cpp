@@ -0,0 +1,209 @@
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <limits>
+#include <ostream>
+#include <rogue/Profiler.h>
+#include <stdexcept>
+
+namespace rogue {
+
+namespace {
+
+std::uint64_t toMicroseconds(Profiler::Clock::duration Duration) {
+  const auto Us =
+      std::chrono::duration_cast<std::chrono::microseconds>(Duration).count();
+  return Us < 0 ? 0 : static_cast<std::uint64_t>(Us);
+}
+
+double getPercentile(const std::vector<std::uint32_t> &Sorted, double P) {
+  const auto Idx = static_cast<std::size_t>(P * (Sorted.size() - 1) + 0.5);
+  return Sorted.at(Idx);
+}
+
+/// Writes the string as a quoted JSON string, escaping quotes, backslashes and
+/// control characters
+void writeJSONString(std::ostream &Out, std::string_view Str) {
+  Out << '"';
+  for (const char C : Str) {
+    switch (C) {
+    case '"':
+      Out << "\\\"";
+      break;
+    case '\\':
+      Out << "\\\\";
+      break;
+    case '\n':
+      Out << "\\n";
+      break;
+    case '\r':
+      Out << "\\r";
+      break;
+    case '\t':
+      Out << "\\t";
+      break;
+    default:
+      if (static_cast<unsigned char>(C) < 0x20) {
+        char Buf[8];
+        std::snprintf(Buf, sizeof(Buf), "\\u%04x",
+                      static_cast<unsigned>(static_cast<unsigned char>(C)));
+        Out << Buf;
+      } else {
+        Out << C;
+      }
+    }
+  }
+  Out << '"';
+}
+
+} // namespace
+
+Profiler::ScopedTimer::ScopedTimer(std::string_view Name, Profiler &Prof)
+    : Name(Name) {
+  if (Prof.isEnabled()) {
+    this->Prof = &Prof;
+    Start = Clock::now();
+  }
+}
+
+Profiler::ScopedTimer::~ScopedTimer() {
+  if (Prof) {
+    Prof->record(Name, Start, Clock::now());
+  }
+}
+
+Profiler &Profiler::get() {
+  static Profiler Instance;
+  return Instance;
+}
+
+Profiler::Profiler() : Epoch(Clock::now()) {}
+
+void Profiler::setEnabled(bool Enabled) { this->Enabled = Enabled; }
+
+void Profiler::record(std::string_view Name, Clock::time_point Start,
+                      Clock::time_point End) {
+  const auto DurationUs = static_cast<std::uint32_t>(std::min<std::uint64_t>(
+      toMicroseconds(End - Start), std::numeric_limits<std::uint32_t>::max()));
+
+  std::lock_guard<std::mutex> Lock(Mutex);
+  auto It = Stages.find(Name);
+  if (It == Stages.end()) {
+    It = Stages.emplace(std::string(Name), Stage{}).first;
+    It->second.Samples.reserve(MaxSamples);
+  }
+
+  auto &S = It->second;
+  if (S.Samples.size() < MaxSamples) {
+    S.Samples.push_back(DurationUs);
+  } else {
+    S.Samples[S.NextIdx] = DurationUs;
+  }
+  S.NextIdx = (S.NextIdx + 1) % MaxSamples;
+  S.TotalCount++;
+  S.Last = DurationUs;
+
+  TraceEvent TE{&It->first, toMicroseconds(Start - Epoch), DurationUs};
+  if (Trace.size() < MaxTraceEvents) {
+    Trace.push_back(TE);
+  } else {
+    Trace[NextTraceIdx] = TE;
+  }
+  NextTraceIdx = (NextTraceIdx + 1) % MaxTraceEvents;
+}
+
+Profiler::Stats Profiler::getStats(std::string_view Name) const {
+  std::lock_guard<std::mutex> Lock(Mutex);
+  auto It = Stages.find(Name);
+  if (It == Stages.end()) {
+    throw std::out_of_range("Unknown profiler stage: " + std::string(Name));
+  }
+  return computeStats(It->second);
+}
+
+std::vector<std::pair<std::string, Profiler::Stats>>
+Profiler::getAllStats() const {
+  std::lock_guard<std::mutex> Lock(Mutex);
+  std::vector<std::pair<std::string, Stats>> AllStats;
+  AllStats.reserve(Stages.size());
+  for (const auto &[Name, S] : Stages) {
+    AllStats.emplace_back(Name, computeStats(S));
+  }
+  return AllStats;
+}
+
+void Profiler::clear() {
+  std::lock_guard<std::mutex> Lock(Mutex);
+  Stages.clear();
+  Trace.clear();
+  NextTraceIdx = 0;
+}
+
+void Profiler::dumpCSV(std::ostream &Out) const {
+  Out << "stage,count,samples,last_us,min_us,max_us,mean_us,p50_us,p95_us,"
+         "p99_us\n";
+  for (const auto &[Name, S] : getAllStats()) {
+    Out << Name << "," << S.TotalCount << "," << S.NumSamples << "," << S.Last
+        << "," << S.Min << "," << S.Max << "," << S.Mean << "," << S.P50 << ","
+        << S.P95 << "," << S.P99 << "\n";
+  }
+}
+
+void Profiler::dumpChromeTrace(std::ostream &Out) const {
+  std::lock_guard<std::mutex> Lock(Mutex);
+  Out << "{\"traceEvents\":[";
+
+  // Oldest event is at the next write position once the trace is full
+  const auto Start = Trace.size() < MaxTraceEvents ? 0 : NextTraceIdx;
+  for (std::size_t Idx = 0; Idx < Trace.size(); ++Idx) {
+    const auto &TE = Trace[(Start + Idx) % Trace.size()];
+    Out << (Idx == 0 ? "\n" : ",\n") << "{\"name\":";
+    writeJSONString(Out, *TE.Name);
+    Out << ",\"ph\":\"X\",\"pid\":1,\"tid\":1,\"ts\":" << TE.StartUs
+        << ",\"dur\":" << TE.DurationUs << "}";
+  }
+  Out << "\n]}\n";
+}
+
+void Profiler::dump(const std::filesystem::path &CSVFile,
+                    const std::filesystem::path &TraceFile) const {
+  std::ofstream CSVOut(CSVFile);
+  if (!CSVOut) {
+    throw std::runtime_error("Profiler::dump: Could not open file: " +
+                             CSVFile.string());
+  }
+  dumpCSV(CSVOut);
+
+  std::ofstream TraceOut(TraceFile);
+  if (!TraceOut) {
+    throw std::runtime_error("Profiler::dump: Could not open file: " +
+                             TraceFile.string());
+  }
+  dumpChromeTrace(TraceOut);
+}
+
+Profiler::Stats Profiler::computeStats(const Stage &S) {
+  Stats St;
+  St.NumSamples = S.Samples.size();
+  St.TotalCount = S.TotalCount;
+  St.Last = S.Last;
+  if (S.Samples.empty()) {
+    return St;
+  }
+
+  auto Sorted = S.Samples;
+  std::sort(Sorted.begin(), Sorted.end());
+  St.Min = Sorted.front();
+  St.Max = Sorted.back();
+  double Sum = 0;
+  for (const auto Sample : Sorted) {
+    Sum += Sample;
+  }
+  St.Mean = Sum / Sorted.size();
+  St.P50 = getPercentile(Sorted, 0.50);
+  St.P95 = getPercentile(Sorted, 0.95);
+  St.P99 = getPercentile(Sorted, 0.99);
+  return St;
+}
+
+} // namespace rogue
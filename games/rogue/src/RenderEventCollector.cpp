@@ -8,8 +8,8 @@ namespace rogue {
 void RenderEventCollector::setEventHub(EventHub *EH) {
   EventHubConnector::setEventHub(EH);
   EH->subscribe(*this, &RenderEventCollector::onEntityAttackEvent);
-  EH->subscribe(*this, &RenderEventCollector::onDetectTargetEvent);
-  EH->subscribe(*this, &RenderEventCollector::onLostTargetEvent);
+  EH->subscribeBatch(*this, &RenderEventCollector::onDetectTargetEvents);
+  EH->subscribeBatch(*this, &RenderEventCollector::onLostTargetEvents);
   EH->subscribe(*this, &RenderEventCollector::onEffectDelayEvent);
   EH->subscribe(*this, &RenderEventCollector::onBuffAppliedEvent);
   EH->subscribe(*this, &RenderEventCollector::onBuffExpiredEvent);
@@ -29,30 +29,45 @@ void RenderEventCollector::onEntityAttackEvent(const EntityAttackEvent &E) {
   });
 }
 
-void RenderEventCollector::onDetectTargetEvent(const DetectTargetEvent &E) {
-  auto *PC = E.Registry->try_get<PositionComp>(E.Entity);
-  if (!PC) {
-    return;
+void RenderEventCollector::onDetectTargetEvents(
+    const EventBatch<DetectTargetEvent> &Events) {
+  RenderFns.reserve(RenderFns.size() + Events.size());
+  for (const auto &E : Events) {
+    // Events may be deferred, the entity could have been destroyed since
+    if (!E.Registry->valid(E.Entity)) {
+      continue;
+    }
+    auto *PC = E.Registry->try_get<PositionComp>(E.Entity);
+    if (!PC) {
+      continue;
+    }
+    auto const AtPos = PC->Pos;
+    RenderFns.push_back([this, AtPos](Renderer &R) {
+      HasEvents |= R.renderEffect(
+          cxxg::types::ColoredChar{'!', cxxg::types::RgbColor{173, 161, 130}},
+          AtPos);
+    });
   }
-  auto const AtPos = PC->Pos;
-  RenderFns.push_back([this, AtPos](Renderer &R) {
-    HasEvents |= R.renderEffect(
-        cxxg::types::ColoredChar{'!', cxxg::types::RgbColor{173, 161, 130}},
-        AtPos);
-  });
 }
 
-void RenderEventCollector::onLostTargetEvent(const LostTargetEvent &E) {
-  auto *PC = E.Registry->try_get<PositionComp>(E.Entity);
-  if (!PC) {
-    return;
+void RenderEventCollector::onLostTargetEvents(
+    const EventBatch<LostTargetEvent> &Events) {
+  RenderFns.reserve(RenderFns.size() + Events.size());
+  for (const auto &E : Events) {
+    if (!E.Registry->valid(E.Entity)) {
+      continue;
+    }
+    auto *PC = E.Registry->try_get<PositionComp>(E.Entity);
+    if (!PC) {
+      continue;
+    }
+    auto const AtPos = PC->Pos;
+    RenderFns.push_back([this, AtPos](Renderer &R) {
+      HasEvents |= R.renderEffect(
+          cxxg::types::ColoredChar{'?', cxxg::types::RgbColor{56, 55, 89}},
+          AtPos);
+    });
   }
-  auto const AtPos = PC->Pos;
-  RenderFns.push_back([this, AtPos](Renderer &R) {
-    HasEvents |= R.renderEffect(
-        cxxg::types::ColoredChar{'?', cxxg::types::RgbColor{56, 55, 89}},
-        AtPos);
-  });
 }
 
 void RenderEventCollector::onEffectDelayEvent(const EffectDelayEvent &) {
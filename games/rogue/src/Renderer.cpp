@@ -2,6 +2,7 @@
 #include <rogue/Components/Transform.h>
 #include <rogue/Components/Visual.h>
 #include <rogue/Level.h>
+#include <rogue/Profiler.h>
 #include <rogue/Renderer.h>
 #include <ymir/Algorithm/LineOfSight.hpp>
 
@@ -9,6 +10,7 @@ namespace rogue {
 
 Renderer::Renderer(ymir::Size2d<int> Size, Level &L, ymir::Point2d<int> Center)
     : L(L), VisibleMap(Size), IsVisibleMap(Size) {
+  Profiler::ScopedTimer Timer("Renderer::Renderer");
   Offset.X = -(Center.X - Size.W / 2);
   Offset.Y = -(Center.Y - Size.H / 2);
 
@@ -46,6 +48,7 @@ Renderer::Renderer(ymir::Size2d<int> Size, Level &L, ymir::Point2d<int> Center)
 }
 
 void Renderer::renderShadow(unsigned char Darkness) {
+  Profiler::ScopedTimer Timer("Renderer::renderShadow");
   const cxxg::types::RgbColor ShadowColor{Darkness, Darkness, Darkness, true,
                                           0,        0,        0};
   VisibleMap.forEach([ShadowColor, this](auto Pos, auto &Tile) {
@@ -59,6 +62,7 @@ void Renderer::renderShadow(unsigned char Darkness) {
 }
 
 void Renderer::renderFogOfWar(const ymir::Map<bool, int> &SeenMap) {
+  Profiler::ScopedTimer Timer("Renderer::renderFogOfWar");
   static constexpr Tile FogTile =
       Tile{{'#', cxxg::types::RgbColor{20, 20, 20, true, 18, 18, 18}}};
   VisibleMap.forEach([&SeenMap, this](auto Pos, auto &Tile) {
@@ -70,6 +74,7 @@ void Renderer::renderFogOfWar(const ymir::Map<bool, int> &SeenMap) {
 }
 
 void Renderer::renderAllLineOfSight() {
+  Profiler::ScopedTimer Timer("Renderer::renderAllLineOfSight");
   auto View = L.Reg.view<const PositionComp, const LineOfSightComp,
                          const VisibleLOSComp>();
   View.each([this](const auto &Pos, const auto &LOS, const auto &) {
@@ -130,6 +135,7 @@ bool Renderer::renderEffect(cxxg::types::ColoredChar EffC,
 }
 
 void Renderer::renderEntities() {
+  Profiler::ScopedTimer Timer("Renderer::renderEntities");
   L.Reg.sort<TileComp>(
       [](const auto &Lhs, const auto &Rhs) { return Lhs.T.ZIndex < Rhs.T.ZIndex; });
   L.Reg.sort<PositionComp, TileComp>();
@@ -1,6 +1,11 @@
 #include <cxxg/Utils.h>
 #include <rogue/SaveGame.h>
 
+#ifndef WIN32
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
 namespace rogue {
 
 std::filesystem::path
@@ -29,6 +34,12 @@ SaveGameInfo SaveGameInfo::fromSlot(unsigned Slot, bool JSON) {
   return fromPath(getSaveGamePath("slot_" + std::to_string(Slot), JSON), JSON);
 }
 
+SaveGameInfo SaveGameInfo::getAutoSave() {
+  auto SGI = fromPath(getSaveGamePath("autosave", false), false);
+  SGI.Name = "Autosave";
+  return SGI;
+}
+
 namespace {
 
 template <typename TimePointTy> std::time_t getTime(TimePointTy TimePoint) {
@@ -46,6 +57,24 @@ std::string getFileWriteDate(const std::filesystem::path &Path) {
   return SS.str();
 }
 
+/// Flushes the file or directory to disk
+void syncPath(const std::filesystem::path &Path) {
+#ifndef WIN32
+  const int Fd = ::open(Path.c_str(), O_RDONLY);
+  if (Fd < 0) {
+    throw std::runtime_error("SaveGame: Failed to open for sync: " +
+                             Path.string());
+  }
+  const int Ret = ::fsync(Fd);
+  ::close(Fd);
+  if (Ret != 0) {
+    throw std::runtime_error("SaveGame: Failed to sync: " + Path.string());
+  }
+#else
+  (void)Path;
+#endif
+}
+
 } // namespace
 
 bool SaveGameInfo::exists() const { return std::filesystem::exists(Path); }
@@ -58,4 +87,24 @@ std::string SaveGameInfo::getDateStr() const {
   return getFileWriteDate(Path);
 }
 
-} // namespace rogue
\ No newline at end of file
+void writeSaveGameAtomically(
+    const SaveGameInfo &SGI,
+    const std::function<void(const SaveGameInfo &)> &Write) {
+  auto TmpSGI = SGI;
+  TmpSGI.Path += ".tmp";
+  try {
+    Write(TmpSGI);
+    syncPath(TmpSGI.Path);
+    std::filesystem::rename(TmpSGI.Path, SGI.Path);
+  } catch (...) {
+    std::error_code EC;
+    std::filesystem::remove(TmpSGI.Path, EC);
+    throw;
+  }
+
+  // Make sure the rename itself is persisted
+  auto Dir = SGI.Path.parent_path();
+  syncPath(Dir.empty() ? std::filesystem::path(".") : Dir);
+}
+
+} // namespace rogue
@@ -0,0 +1,135 @@
+#include <rogue/SaveGameFile.h>
+#include <stdexcept>
+
+namespace rogue {
+
+namespace {
+
+struct ChunkHeader {
+  std::uint32_t Kind = 0;
+  std::uint32_t Index = 0;
+  std::uint64_t Size = 0;
+};
+
+template <typename T> void writeValue(std::ostream &Out, const T &Value) {
+  Out.write(reinterpret_cast<const char *>(&Value), sizeof(T));
+}
+
+template <typename T> bool readValue(std::istream &In, T &Value) {
+  In.read(reinterpret_cast<char *>(&Value), sizeof(T));
+  return static_cast<bool>(In);
+}
+
+} // namespace
+
+SaveGameWriter::SaveGameWriter(const std::filesystem::path &Path)
+    : Path(Path), Out(Path, std::ios::binary | std::ios::trunc) {
+  if (!Out) {
+    throw std::runtime_error("SaveGameWriter: Failed to open file: " +
+                             Path.string());
+  }
+  writeValue(Out, Magic);
+  writeValue(Out, Version);
+}
+
+void SaveGameWriter::addChunk(SaveGameChunk Kind, std::uint32_t Index,
+                              std::string_view Data) {
+  if (Finished) {
+    throw std::runtime_error("SaveGameWriter: Save game already finished: " +
+                             Path.string());
+  }
+  ChunkHeader Header;
+  Header.Kind = static_cast<std::uint32_t>(Kind);
+  Header.Index = Index;
+  Header.Size = Data.size();
+  writeValue(Out, Header);
+  Out.write(Data.data(), Data.size());
+  if (!Out) {
+    throw std::runtime_error("SaveGameWriter: Failed to write file: " +
+                             Path.string());
+  }
+}
+
+void SaveGameWriter::finish() {
+  addChunk(SaveGameChunk::End, 0, {});
+  Finished = true;
+  Out.flush();
+  if (!Out) {
+    throw std::runtime_error("SaveGameWriter: Failed to write file: " +
+                             Path.string());
+  }
+}
+
+SaveGameReader::SaveGameReader(const std::filesystem::path &Path)
+    : Path(Path), In(Path, std::ios::binary) {
+  if (!In) {
+    throw std::runtime_error("SaveGameReader: Failed to open file: " +
+                             Path.string());
+  }
+
+  std::uint32_t FileMagic = 0, FileVersion = 0;
+  if (!readValue(In, FileMagic) || FileMagic != SaveGameWriter::Magic) {
+    throw std::runtime_error("SaveGameReader: Not a save game: " +
+                             Path.string());
+  }
+  if (!readValue(In, FileVersion) || FileVersion != SaveGameWriter::Version) {
+    throw std::runtime_error("SaveGameReader: Unsupported version " +
+                             std::to_string(FileVersion) +
+                             " of save game: " + Path.string());
+  }
+
+  // Skip over the chunk data, it is read on demand
+  const auto FileSize = std::filesystem::file_size(Path);
+  ChunkHeader Header;
+  while (readValue(In, Header)) {
+    const auto Kind = static_cast<SaveGameChunk>(Header.Kind);
+    if (Kind == SaveGameChunk::End) {
+      return;
+    }
+    const auto Offset = static_cast<std::uint64_t>(In.tellg());
+    if (Header.Size > FileSize - Offset) {
+      break;
+    }
+    Chunks[{Kind, Header.Index}] = {Offset, Header.Size};
+    In.seekg(static_cast<std::streamoff>(Header.Size), std::ios::cur);
+  }
+  throw std::runtime_error("SaveGameReader: Truncated save game: " +
+                           Path.string());
+}
+
+bool SaveGameReader::hasChunk(SaveGameChunk Kind, std::uint32_t Index) const {
+  return Chunks.count({Kind, Index}) != 0;
+}
+
+std::vector<std::uint32_t>
+SaveGameReader::getChunkIndices(SaveGameChunk Kind) const {
+  std::vector<std::uint32_t> Indices;
+  for (const auto &[Key, Loc] : Chunks) {
+    if (Key.first == Kind) {
+      Indices.push_back(Key.second);
+    }
+  }
+  return Indices;
+}
+
+std::string SaveGameReader::readChunk(SaveGameChunk Kind,
+                                      std::uint32_t Index) {
+  auto It = Chunks.find({Kind, Index});
+  if (It == Chunks.end()) {
+    throw std::out_of_range("SaveGameReader: Missing chunk " +
+                            std::to_string(static_cast<std::uint32_t>(Kind)) +
+                            ":" + std::to_string(Index) + " in save game: " +
+                            Path.string());
+  }
+  std::string Data(It->second.Size, '\0');
+  In.clear();
+  In.seekg(static_cast<std::streamoff>(It->second.Offset));
+  In.read(Data.data(), Data.size());
+  if (!In) {
+    throw std::runtime_error("SaveGameReader: Failed to read file: " +
+                             Path.string());
+  }
+  return Data;
+}
+
+} // namespace rogue
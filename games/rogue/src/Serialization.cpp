@@ -5,15 +5,24 @@
 #include <cereal/types/optional.hpp>
 #include <cereal/types/set.hpp>
 #include <cereal/types/string.hpp>
+#include <cereal/types/utility.hpp>
 #include <cereal/types/variant.hpp>
 #include <cereal/types/vector.hpp>
 #include <fstream>
+#include <rogue/Components/AI.h>
+#include <rogue/Components/Buffs.h>
+#include <rogue/Components/Entity.h>
 #include <rogue/Components/Serialization.h>
+#include <rogue/Components/Stats.h>
+#include <rogue/Components/Transform.h>
 #include <rogue/Context.h>
 #include <rogue/ItemDatabase.h>
 #include <rogue/ItemEffectImpl.h>
 #include <rogue/Level.h>
 #include <rogue/Serialization.h>
+#include <sstream>
+#include <tuple>
+#include <type_traits>
 
 #define CEREAL_REGISTER_ITEM_EFFECT_TYPE(Type)                                 \
   CEREAL_REGISTER_TYPE(Type);                                                  \
@@ -60,6 +69,59 @@ CEREAL_REGISTER_ITEM_EFFECT_TYPE(rogue::SpawnEntityEffect);
 
 namespace rogue::serialize {
 
+namespace {
+
+template <typename T, typename RegistryT>
+auto *tryGetComp(RegistryT &Reg, std::uint32_t Id) {
+  const auto Entity = static_cast<entt::entity>(Id);
+  return Reg.valid(Entity) ? Reg.template try_get<T>(Entity) : nullptr;
+}
+
+/// FNV-1a hash over the bytes of the added values
+class ChecksumBuilder {
+public:
+  template <typename T> void add(const T &Value) {
+    static_assert(std::is_integral_v<T>, "Only integral values are hashed");
+    const auto *Bytes = reinterpret_cast<const unsigned char *>(&Value);
+    for (std::size_t Idx = 0; Idx < sizeof(T); ++Idx) {
+      Hash ^= Bytes[Idx];
+      Hash *= 0x100000001b3ULL;
+    }
+  }
+
+  std::uint64_t get() const { return Hash; }
+
+private:
+  std::uint64_t Hash = 0xcbf29ce484222325ULL;
+};
+
+bool hasBuffs(const entt::registry &Reg, entt::entity Entity) {
+  bool HasBuffs = false;
+  applyForComponents<BuffTypeList>([&Reg, Entity, &HasBuffs](const auto &Arg) {
+    HasBuffs = HasBuffs || Reg.all_of<std::decay_t<decltype(Arg)>>(Entity);
+  });
+  return HasBuffs;
+}
+
+template <typename T> std::string toBinary(const T &Value) {
+  std::ostringstream Out;
+  {
+    cereal::BinaryOutputArchive Ar(Out);
+    Ar(Value);
+  }
+  return Out.str();
+}
+
+template <typename T> T fromBinary(const std::string &Bytes) {
+  T Value;
+  std::istringstream In(Bytes);
+  cereal::BinaryInputArchive Ar(In);
+  Ar(Value);
+  return Value;
+}
+
+} // namespace
+
 ItemInfo ItemInfo::createFrom(const Item &It) {
   return {It.getId(), It.StackSize, It.getSpecialization(),
           It.doesSpecOverride()};
@@ -105,6 +167,51 @@ void EquipmentInfo::applyTo(const ItemDatabase &ItemDb, EquipmentComp &EC,
   }
 }
 
+AIInfo AIInfo::createFrom(const entt::registry &Reg, entt::entity Et) {
+  AIInfo Info;
+  if (const auto *WAI = Reg.try_get<WanderAIComp>(Et)) {
+    Info.HasWander = true;
+    Info.WanderState = static_cast<unsigned>(WAI->State);
+    Info.WanderStateDelayLeft = WAI->StateDelayLeft;
+  }
+  if (const auto *SAI = Reg.try_get<SearchAIComp>(Et)) {
+    Info.HasSearch = true;
+    Info.SearchState = static_cast<unsigned>(SAI->State);
+    if (SAI->LastTargetPos) {
+      Info.LastTargetPos = {SAI->LastTargetPos->X, SAI->LastTargetPos->Y};
+    }
+    Info.SearchDurationLeft = SAI->SearchDurationLeft;
+  }
+  return Info;
+}
+
+void AIInfo::applyTo(entt::registry &Reg, entt::entity Et) const {
+  auto *WAI = Reg.try_get<WanderAIComp>(Et);
+  if (HasWander && WAI) {
+    WAI->State = static_cast<WanderAIState>(WanderState);
+    WAI->StateDelayLeft = WanderStateDelayLeft;
+  }
+  auto *SAI = Reg.try_get<SearchAIComp>(Et);
+  if (HasSearch && SAI) {
+    SAI->State = static_cast<SearchAIState>(SearchState);
+    SAI->LastTargetPos = std::nullopt;
+    if (LastTargetPos) {
+      SAI->LastTargetPos = ymir::Point2d<int>(LastTargetPos->first,
+                                              LastTargetPos->second);
+    }
+    SAI->SearchDurationLeft = SearchDurationLeft;
+  }
+}
+
+bool AIInfo::operator==(const AIInfo &Other) const {
+  return std::tie(HasWander, WanderState, WanderStateDelayLeft, HasSearch,
+                  SearchState, LastTargetPos, SearchDurationLeft) ==
+         std::tie(Other.HasWander, Other.WanderState,
+                  Other.WanderStateDelayLeft, Other.HasSearch,
+                  Other.SearchState, Other.LastTargetPos,
+                  Other.SearchDurationLeft);
+}
+
 SaveGameSerializer SaveGameSerializer::loadFromFile(const SaveGameInfo &SGI) {
   std::ifstream InFile(SGI.Path);
   if (!InFile) {
@@ -215,4 +322,379 @@ void SaveGameSerializer::saveToFile(const SaveGameInfo &SGI) const {
   }
 }
 
-} // namespace rogue::serialize
\ No newline at end of file
+LevelBaseline LevelBaseline::create(const Level &Lvl) {
+  LevelBaseline Baseline;
+  Baseline.Checksum = computeChecksum(Lvl);
+  Lvl.Reg.view<const PositionComp>().each(
+      [&Baseline](auto Entity, const auto &PC) {
+        Baseline.Positions[entt::to_integral(Entity)] = {PC.Pos.X, PC.Pos.Y};
+      });
+  Lvl.Reg.view<const PositionComp, const HealthComp>().each(
+      [&Baseline](auto Entity, const auto &, const auto &HC) {
+        Baseline.Health[entt::to_integral(Entity)] = HC.Value;
+      });
+  Lvl.Reg.view<const PositionComp, const ManaComp>().each(
+      [&Baseline](auto Entity, const auto &, const auto &MC) {
+        Baseline.Mana[entt::to_integral(Entity)] = MC.Value;
+      });
+  Lvl.Reg.view<const PositionComp, const DoorComp>().each(
+      [&Baseline](auto Entity, const auto &, const auto &DC) {
+        Baseline.Doors[entt::to_integral(Entity)] = DC;
+      });
+  Lvl.Reg.view<const PositionComp, const LootInteractComp>().each(
+      [&Baseline](auto Entity, const auto &, const auto &LIC) {
+        Baseline.Looted[entt::to_integral(Entity)] = LIC.IsLooted;
+      });
+  const auto StoreAI = [&Baseline, &Lvl](auto Entity, const auto &) {
+    Baseline.AIInfos[entt::to_integral(Entity)] =
+        AIInfo::createFrom(Lvl.Reg, Entity);
+  };
+  Lvl.Reg.view<const WanderAIComp>().each(StoreAI);
+  Lvl.Reg.view<const SearchAIComp>().each(StoreAI);
+
+  // The player and drops are never part of a snapshot
+  const auto IsLevelEntity = [&Lvl](auto Entity) {
+    return !Lvl.Reg.any_of<PlayerComp, DropComp>(Entity);
+  };
+  Lvl.Reg.view<const PositionComp, const EquipmentComp>().each(
+      [&Baseline, &IsLevelEntity](auto Entity, const auto &, const auto &EC) {
+        if (IsLevelEntity(Entity)) {
+          Baseline.Equipment[entt::to_integral(Entity)] =
+              toBinary(EquipmentInfo::createFrom(EC));
+        }
+      });
+  Lvl.Reg.view<const PositionComp, const InventoryComp>().each(
+      [&Baseline, &IsLevelEntity](auto Entity, const auto &, const auto &IC) {
+        if (IsLevelEntity(Entity)) {
+          Baseline.Inventories[entt::to_integral(Entity)] =
+              toBinary(InventoryInfo::createFrom(IC));
+        }
+      });
+  return Baseline;
+}
+
+std::uint64_t LevelBaseline::computeChecksum(const Level &Lvl) {
+  ChecksumBuilder Checksum;
+  const auto Size = Lvl.Map.getSize();
+  Checksum.add(Size.W);
+  Checksum.add(Size.H);
+  for (std::size_t Layer = 0; Layer < Level::LayerNames.size(); ++Layer) {
+    const auto &LayerMap = Lvl.Map.get(Layer);
+    for (int Y = 0; Y < Size.H; Y++) {
+      for (int X = 0; X < Size.W; X++) {
+        Checksum.add(LayerMap.getTile({X, Y}).kind());
+      }
+    }
+  }
+
+  // Entities are visited in storage order, which is the creation order for a
+  // freshly generated level
+  Lvl.Reg.view<const PositionComp>().each(
+      [&Checksum](auto Entity, const auto &PC) {
+        Checksum.add(entt::to_integral(Entity));
+        Checksum.add(PC.Pos.X);
+        Checksum.add(PC.Pos.Y);
+      });
+  return Checksum.get();
+}
+
+LevelSnapshot LevelSnapshot::create(const Level &Lvl,
+                                    const LevelBaseline &Baseline) {
+  LevelSnapshot Snapshot;
+  Snapshot.Checksum = Baseline.Checksum;
+
+  for (const auto &[Id, BasePos] : Baseline.Positions) {
+    const auto *PC = tryGetComp<PositionComp>(Lvl.Reg, Id);
+    if (!PC) {
+      Snapshot.Removed.push_back(Id);
+    } else if (BasePos != std::pair<int, int>{PC->Pos.X, PC->Pos.Y}) {
+      Snapshot.Positions[Id] = {PC->Pos.X, PC->Pos.Y};
+    }
+  }
+
+  for (const auto &[Id, BaseValue] : Baseline.Health) {
+    const auto *HC = tryGetComp<HealthComp>(Lvl.Reg, Id);
+    if (HC && HC->Value != BaseValue) {
+      Snapshot.Health[Id] = HC->Value;
+    }
+  }
+
+  for (const auto &[Id, BaseValue] : Baseline.Mana) {
+    const auto *MC = tryGetComp<ManaComp>(Lvl.Reg, Id);
+    if (MC && MC->Value != BaseValue) {
+      Snapshot.Mana[Id] = MC->Value;
+    }
+  }
+
+  for (const auto &[Id, BaseDoor] : Baseline.Doors) {
+    const auto *DC = tryGetComp<DoorComp>(Lvl.Reg, Id);
+    if (DC && (DC->IsOpen != BaseDoor.IsOpen || DC->KeyId != BaseDoor.KeyId)) {
+      Snapshot.Doors[Id] = *DC;
+    }
+  }
+
+  for (const auto &[Id, BaseLooted] : Baseline.Looted) {
+    const auto *LIC = tryGetComp<LootInteractComp>(Lvl.Reg, Id);
+    if (LIC && LIC->IsLooted != BaseLooted) {
+      Snapshot.Looted[Id] = LIC->IsLooted;
+    }
+  }
+
+  for (const auto &[Id, BaseAI] : Baseline.AIInfos) {
+    const auto Entity = static_cast<entt::entity>(Id);
+    if (!Lvl.Reg.valid(Entity)) {
+      continue;
+    }
+    auto AI = AIInfo::createFrom(Lvl.Reg, Entity);
+    if (AI != BaseAI) {
+      Snapshot.AIInfos[Id] = std::move(AI);
+    }
+  }
+
+  // The player is not part of the level, it is stored separately
+  entt::entity Player = entt::null;
+  if (Lvl.hasPlayer()) {
+    Player = Lvl.getPlayer();
+  }
+
+  // Only equipment and inventories that differ from the baseline are stored
+  const auto IsChanged = [](const auto &BaseMap, auto Entity,
+                            const auto &Info) {
+    auto It = BaseMap.find(entt::to_integral(Entity));
+    return It == BaseMap.end() || It->second != toBinary(Info);
+  };
+
+  Lvl.Reg.view<const PositionComp, const EquipmentComp>().each(
+      [&Snapshot, &Baseline, &IsChanged, Player](auto Entity, const auto &,
+                                                 const auto &EC) {
+        if (Entity == Player) {
+          return;
+        }
+        auto Info = EquipmentInfo::createFrom(EC);
+        if (IsChanged(Baseline.Equipment, Entity, Info)) {
+          Snapshot.EquipmentInfos[entt::to_integral(Entity)] = std::move(Info);
+        }
+      });
+
+  // Drops are recreated, their inventory is stored with them
+  Lvl.Reg.view<const PositionComp, const InventoryComp>().each(
+      [&Snapshot, &Baseline, &IsChanged, &Lvl, Player](
+          auto Entity, const auto &PC, const auto &IC) {
+        if (Entity == Player) {
+          return;
+        }
+        auto Info = InventoryInfo::createFrom(IC);
+        if (Lvl.Reg.all_of<DropComp>(Entity)) {
+          Snapshot.Drops.push_back({{PC.Pos.X, PC.Pos.Y}, std::move(Info)});
+          return;
+        }
+        if (IsChanged(Baseline.Inventories, Entity, Info)) {
+          Snapshot.InventoryInfos[entt::to_integral(Entity)] = std::move(Info);
+        }
+      });
+
+  const auto &LvlSeenMap = Lvl.getPlayerSeenMap();
+  const auto Size = LvlSeenMap.getSize();
+  bool Seen = false;
+  std::uint32_t Run = 0;
+  for (int Y = 0; Y < Size.H; Y++) {
+    for (int X = 0; X < Size.W; X++) {
+      if (LvlSeenMap.getTile({X, Y}) != Seen) {
+        Snapshot.SeenRuns.push_back(Run);
+        Seen = !Seen;
+        Run = 0;
+      }
+      Run++;
+    }
+  }
+  Snapshot.SeenRuns.push_back(Run);
+
+  return Snapshot;
+}
+
+LevelSnapshot LevelSnapshot::fromBytes(const std::string &Bytes) {
+  return fromBinary<LevelSnapshot>(Bytes);
+}
+
+bool LevelSnapshot::canRestore(const Level &Lvl,
+                               const LevelBaseline &Baseline) {
+  entt::entity Player = entt::null;
+  if (Lvl.hasPlayer()) {
+    Player = Lvl.getPlayer();
+  }
+
+  bool CanRestore = true;
+  Lvl.Reg.view<const PositionComp>().each(
+      [&CanRestore, &Lvl, &Baseline, Player](auto Entity, const auto &) {
+        if (!CanRestore || Entity == Player) {
+          return;
+        }
+        const bool IsGenerated =
+            Baseline.Positions.count(entt::to_integral(Entity)) != 0;
+        if ((!IsGenerated && !Lvl.Reg.all_of<DropComp>(Entity)) ||
+            hasBuffs(Lvl.Reg, Entity)) {
+          CanRestore = false;
+        }
+      });
+  return CanRestore;
+}
+
+void LevelSnapshot::apply(Level &Lvl) const {
+  if (LevelBaseline::computeChecksum(Lvl) != Checksum) {
+    throw std::runtime_error("LevelSnapshot: Regenerated level " +
+                             std::to_string(Lvl.getLevelId()) +
+                             " does not match the snapshot");
+  }
+  auto &ItemDb = Lvl.Reg.ctx().get<GameContext>().ItemDb;
+
+  for (const auto Id : Removed) {
+    const auto Entity = static_cast<entt::entity>(Id);
+    if (Lvl.Reg.valid(Entity)) {
+      Lvl.Reg.destroy(Entity);
+    }
+  }
+
+  for (const auto &[Id, Pos] : Positions) {
+    if (auto *PC = tryGetComp<PositionComp>(Lvl.Reg, Id)) {
+      PC->Pos = {Pos.first, Pos.second};
+    }
+  }
+
+  for (const auto &[Id, Value] : Health) {
+    if (auto *HC = tryGetComp<HealthComp>(Lvl.Reg, Id)) {
+      HC->Value = Value;
+    }
+  }
+
+  for (const auto &[Id, Value] : Mana) {
+    if (auto *MC = tryGetComp<ManaComp>(Lvl.Reg, Id)) {
+      MC->Value = Value;
+    }
+  }
+
+  for (const auto &[Id, Door] : Doors) {
+    if (auto *DC = tryGetComp<DoorComp>(Lvl.Reg, Id)) {
+      *DC = Door;
+      const auto Entity = static_cast<entt::entity>(Id);
+      if (DC->IsOpen) {
+        DC->openDoor(Lvl.Reg, Entity);
+      } else {
+        DC->closeDoor(Lvl.Reg, Entity);
+      }
+    }
+  }
+
+  for (const auto &[Id, Info] : EquipmentInfos) {
+    if (auto *EC = tryGetComp<EquipmentComp>(Lvl.Reg, Id)) {
+      // Drop the equipment rolled when regenerating the level
+      const auto Entity = static_cast<entt::entity>(Id);
+      for (auto *Slot : EC->Equip.all()) {
+        if (Slot->It) {
+          EC->Equip.unequip(Slot->It->getType(), Entity, Lvl.Reg);
+        }
+      }
+      Info.applyTo(ItemDb, *EC, Entity, Lvl.Reg);
+    }
+  }
+
+  for (const auto &[Id, IsLooted] : Looted) {
+    if (auto *LIC = tryGetComp<LootInteractComp>(Lvl.Reg, Id)) {
+      LIC->IsLooted = IsLooted;
+      if (auto *TC = tryGetComp<TileComp>(Lvl.Reg, Id)) {
+        TC->T = IsLooted ? LIC->LootedTile : LIC->DefaultTile;
+      }
+    }
+  }
+
+  for (const auto &[Id, Info] : InventoryInfos) {
+    if (auto *IC = tryGetComp<InventoryComp>(Lvl.Reg, Id)) {
+      Info.applyTo(ItemDb, *IC);
+    }
+  }
+
+  for (const auto &[Id, Info] : AIInfos) {
+    const auto Entity = static_cast<entt::entity>(Id);
+    if (Lvl.Reg.valid(Entity)) {
+      Info.applyTo(Lvl.Reg, Entity);
+    }
+  }
+
+  // Drops are created last, they may reuse identifiers of removed entities
+  for (const auto &Drop : Drops) {
+    InventoryComp IC;
+    Drop.Inventory.applyTo(ItemDb, IC);
+    createDropEntity(Lvl.Reg, {Drop.Pos.first, Drop.Pos.second}, IC.Inv);
+  }
+
+  auto &LvlSeenMap = Lvl.getPlayerSeenMap();
+  const auto Size = LvlSeenMap.getSize();
+  bool Seen = false;
+  auto RunIt = SeenRuns.begin();
+  std::uint32_t RunLeft = RunIt != SeenRuns.end() ? *RunIt : 0;
+  for (int Y = 0; Y < Size.H; Y++) {
+    for (int X = 0; X < Size.W; X++) {
+      while (RunLeft == 0) {
+        if (RunIt == SeenRuns.end() || ++RunIt == SeenRuns.end()) {
+          throw std::runtime_error(
+              "LevelSnapshot: Seen map does not match level");
+        }
+        RunLeft = *RunIt;
+        Seen = !Seen;
+      }
+      LvlSeenMap.getTile({X, Y}) = Seen;
+      RunLeft--;
+    }
+  }
+}
+
+std::string LevelSnapshot::toBytes() const { return toBinary(*this); }
+
+bool LevelSnapshot::empty() const {
+  // The seen map is a single run of unseen tiles if nothing was seen
+  return Removed.empty() && Positions.empty() && Health.empty() &&
+         Mana.empty() && Doors.empty() && Looted.empty() && AIInfos.empty() &&
+         EquipmentInfos.empty() && InventoryInfos.empty() && Drops.empty() &&
+         SeenRuns.size() <= 1;
+}
+
+PlayerSnapshot PlayerSnapshot::create(const Level &Lvl) {
+  const auto Player = Lvl.getPlayer();
+  const auto &Reg = Lvl.Reg;
+  const auto &Pos = Reg.get<PositionComp>(Player).Pos;
+
+  PlayerSnapshot Snapshot;
+  Snapshot.Pos = {Pos.X, Pos.Y};
+  Snapshot.Stats = Reg.get<StatsComp>(Player).Base;
+  Snapshot.Health = Reg.get<HealthComp>(Player).Value;
+  Snapshot.Mana = Reg.get<ManaComp>(Player).Value;
+  Snapshot.Equipment =
+      EquipmentInfo::createFrom(Reg.get<EquipmentComp>(Player));
+  Snapshot.Inventory =
+      InventoryInfo::createFrom(Reg.get<InventoryComp>(Player));
+  Snapshot.Info.KnownRecipes = Reg.get<PlayerComp>(Player).KnownRecipes;
+  return Snapshot;
+}
+
+void PlayerSnapshot::apply(Level &Lvl) const {
+  auto &ItemDb = Lvl.Reg.ctx().get<GameContext>().ItemDb;
+  Lvl.createPlayer({Pos.first, Pos.second});
+  const auto Player = Lvl.getPlayer();
+
+  Lvl.Reg.patch<StatsComp>(Player, [this](auto &SC) { SC.Base = Stats; });
+  Equipment.applyTo(ItemDb, Lvl.Reg.get<EquipmentComp>(Player), Player,
+                    Lvl.Reg);
+  Inventory.applyTo(ItemDb, Lvl.Reg.get<InventoryComp>(Player));
+  Lvl.Reg.get<PlayerComp>(Player).KnownRecipes = Info.KnownRecipes;
+
+  // Restore values last, equipment may have changed the maximum values
+  Lvl.Reg.get<HealthComp>(Player).Value = Health;
+  Lvl.Reg.get<ManaComp>(Player).Value = Mana;
+}
+
+WorldSnapshot WorldSnapshot::fromBytes(const std::string &Bytes) {
+  return fromBinary<WorldSnapshot>(Bytes);
+}
+
+std::string WorldSnapshot::toBytes() const { return toBinary(*this); }
+
+} // namespace rogue::serialize
@@ -71,25 +71,6 @@ void handlePotentialTarget(Level &L, entt::registry &Reg, entt::entity Entity,
   }
 }
 
-void updateEffectExecutor(entt::registry &Reg, entt::entity Entity,
-                          EffectExecutorComp &Executer) {
-  if (Executer.DelayLeft > 0) {
-    Executer.DelayLeft--;
-    return;
-  }
-
-  auto &Effect = Executer.Effects.at(Executer.NextEffect);
-  if (Effect.Effect->canApplyTo(Entity, Entity, Reg)) {
-    Effect.Effect->applyTo(Entity, Entity, Reg);
-  }
-
-  Executer.DelayLeft = Effect.DelayDist(RD);
-  Executer.NextEffect++;
-  if (Executer.NextEffect >= Executer.Effects.size()) {
-    Executer.NextEffect = 0;
-  }
-}
-
 void handleRangedAndMeleeAutoAttacks(Level &L) {
   auto View = L.Reg.view<const PositionComp, AttackAIComp, AgilityComp,
                          const FactionComp>();
@@ -126,7 +107,22 @@ void handleRangedAndMeleeAutoAttacks(Level &L) {
 
 } // namespace
 
-AttackAISystem::AttackAISystem(Level &L) : System(L.Reg), L(L) {}
+AttackAISystem::AttackAISystem(Level &L) : System(L.Reg), L(L) {
+  Reg.on_construct<EffectExecutorComp>()
+      .connect<&AttackAISystem::onExecutorConstruct>(*this);
+  Reg.on_destroy<EffectExecutorComp>()
+      .connect<&AttackAISystem::onExecutorDestroy>(*this);
+
+  // Schedule executors that were added before the system was created
+  for (auto Entity : Reg.view<EffectExecutorComp>()) {
+    onExecutorConstruct(Reg, Entity);
+  }
+}
+
+AttackAISystem::~AttackAISystem() {
+  Reg.on_construct<EffectExecutorComp>().disconnect(*this);
+  Reg.on_destroy<EffectExecutorComp>().disconnect(*this);
+}
 
 void AttackAISystem::update(UpdateType Type) {
   if (Type == UpdateType::NoTick) {
@@ -134,10 +130,47 @@ void AttackAISystem::update(UpdateType Type) {
   }
 
   handleRangedAndMeleeAutoAttacks(L);
+  updateEffectExecutors();
+}
 
-  Reg.view<EffectExecutorComp>().each([&](auto Entity, auto &Executer) {
-    updateEffectExecutor(Reg, Entity, Executer);
-  });
+void AttackAISystem::onExecutorConstruct(entt::registry &,
+                                         entt::entity Entity) {
+  // The next effect is executed on the tick after the delay
+  const auto &Executer = Reg.get<EffectExecutorComp>(Entity);
+  ExecutorTimers.schedule(Entity, Executer.FirstDelay + 1);
+}
+
+void AttackAISystem::onExecutorDestroy(entt::registry &,
+                                       entt::entity Entity) {
+  ExecutorTimers.cancel(Entity);
+}
+
+void AttackAISystem::updateEffectExecutors() {
+  for (auto Entity : ExecutorTimers.advance()) {
+    // Effects may remove executors that are woken up on the same tick
+    auto *Executer = Reg.try_get<EffectExecutorComp>(Entity);
+    if (!Executer) {
+      continue;
+    }
+
+    const auto EffectIdx = Executer->NextEffect;
+    const auto Effect = Executer->Effects.at(EffectIdx).Effect;
+    if (Effect->canApplyTo(Entity, Entity, Reg)) {
+      Effect->applyTo(Entity, Entity, Reg);
+    }
+
+    // Applying the effect may have removed the executor
+    Executer = Reg.try_get<EffectExecutorComp>(Entity);
+    if (!Executer) {
+      continue;
+    }
+    const auto Delay = Executer->Effects.at(EffectIdx).DelayDist(RD);
+    Executer->NextEffect = EffectIdx + 1;
+    if (Executer->NextEffect >= Executer->Effects.size()) {
+      Executer->NextEffect = 0;
+    }
+    ExecutorTimers.schedule(Entity, Delay + 1);
+  }
 }
 
-} // namespace rogue
\ No newline at end of file
+} // namespace rogue
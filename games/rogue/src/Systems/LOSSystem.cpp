@@ -18,31 +18,18 @@ void resetLOSComps(entt::registry &Reg) {
   });
 }
 
-void applyStaticDebuffs(entt::registry &Reg, bool Tick) {
+/// Applies the effects of active buffs, they are ticked and removed on expiry
+/// by the timed buff system
+void applyStaticDebuffs(entt::registry &Reg) {
   Reg.view<LineOfSightComp, BlindedDebuffComp>().each(
-      [&Reg, Tick](auto Et, auto &LOS, auto &DB) {
-        if (Tick && DB.tick() == TimedBuff::State::Expired) {
-          Reg.erase<BlindedDebuffComp>(Et);
-          return;
-        }
-        LOS.LOSRange = LOS.LOSRange * DB.Factor;
-      });
+      [](auto &LOS, auto &DB) { LOS.LOSRange = LOS.LOSRange * DB.Factor; });
 
-  Reg.view<InvisibilityBuffComp>().each([&Reg, Tick](auto Et, auto &IBC) {
-    if (Tick && IBC.tick() == TimedBuff::State::Expired) {
-      Reg.erase<InvisibilityBuffComp>(Et);
-      return;
-    }
+  Reg.view<InvisibilityBuffComp>().each([&Reg](auto Et, auto &) {
     Reg.get_or_emplace<VisibleComp>(Et).IsVisible = false;
   });
 
-  Reg.view<MindVisionBuffComp, PositionComp>().each([&Reg, Tick](auto Et,
-                                                                 auto &MVB,
-                                                                 auto &PC) {
-    if (Tick && MVB.tick() == TimedBuff::State::Expired) {
-      Reg.erase<MindVisionBuffComp>(Et);
-      return;
-    }
+  Reg.view<MindVisionBuffComp, PositionComp>().each([&Reg](auto Et, auto &MVB,
+                                                           auto &PC) {
     Reg.view<LineOfSightComp, PositionComp>().each(
         [&Reg, Et, &PC, &MVB](auto TEt, auto &, auto &TPC) {
           if (TEt == Et) {
@@ -61,12 +48,12 @@ void applyStaticDebuffs(entt::registry &Reg, bool Tick) {
 
 } // namespace
 
-void LOSSystem::update(UpdateType Type) {
+void LOSSystem::update(UpdateType) {
   // Reset
   resetLOSComps(Reg);
 
   // Apply static de-buffs
-  applyStaticDebuffs(Reg, UpdateType::Tick == Type);
+  applyStaticDebuffs(Reg);
 }
 
 } // namespace rogue
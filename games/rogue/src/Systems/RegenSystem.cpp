@@ -1,84 +1,82 @@
 #include <entt/entt.hpp>
-#include <rogue/Components/Buffs.h>
 #include <rogue/Components/Stats.h>
-#include <rogue/Event.h>
 #include <rogue/Systems/RegenSystem.h>
 
 namespace rogue {
 
-namespace {
+template <typename RegenComp> TimerWheel &RegenSystem::getTimers() {
+  static_assert(std::is_same_v<RegenComp, HealthComp> ||
+                    std::is_same_v<RegenComp, ManaComp>,
+                "No timers for the regeneration component");
+  if constexpr (std::is_same_v<RegenComp, HealthComp>) {
+    return HealthTimers;
+  } else {
+    return ManaTimers;
+  }
+}
 
-template <typename T>
-using IsRegenComp = std::is_base_of<ValueRegenCompBase, T>;
+template <typename RegenComp> void RegenSystem::connectTimers() {
+  Reg.on_construct<RegenComp>()
+      .template connect<&RegenSystem::onRegenCompConstruct<RegenComp>>(*this);
+  Reg.on_destroy<RegenComp>()
+      .template connect<&RegenSystem::onRegenCompDestroy<RegenComp>>(*this);
 
-template <typename T>
-using IsDimRetBuff = std::is_base_of<DiminishingReturnsValueGenBuff, T>;
+  // Schedule components that were added before the system was created
+  for (auto Entity : Reg.view<RegenComp>()) {
+    onRegenCompConstruct<RegenComp>(Reg, Entity);
+  }
+}
 
-template <typename Component>
-typename std::enable_if_t<IsRegenComp<Component>::value>
-runRegenUpdate(entt::registry &Reg) {
-  auto View = Reg.view<Component>();
-  View.each([](auto &C) {
-    // Check there are ticks left until the next update, pre-decrement so
-    // tick period of 1 means every tick
-    if (--C.TicksLeft != 0) {
-      return;
-    }
-    C.TicksLeft = C.TickPeriod;
+template <typename RegenComp> void RegenSystem::disconnectTimers() {
+  Reg.on_construct<RegenComp>().disconnect(*this);
+  Reg.on_destroy<RegenComp>().disconnect(*this);
+}
 
-    // Restore the given amount to regenerate
-    C.restore(C.RegenAmount);
-  });
+template <typename RegenComp>
+void RegenSystem::onRegenCompConstruct(entt::registry &,
+                                       entt::entity Entity) {
+  const auto &C = Reg.get<RegenComp>(Entity);
+  getTimers<RegenComp>().schedule(Entity, C.FirstTickDelay);
 }
 
-template <typename Component, typename Buff>
-typename std::enable_if_t<IsRegenComp<Component>::value &&
-                          IsDimRetBuff<Buff>::value>
-runDimRetValueGenBuff(System &Sys, entt::registry &Reg, bool Reduce) {
-  auto View = Reg.view<Buff, Component>();
-  View.each([&Sys, &Reg, Reduce](auto Entity, auto &B, auto &C) {
-    // Post decrement to match count
-    auto St = B.tick();
-    if (St == TimedBuff::State::Expired) {
-      Sys.publish(BuffExpiredEvent{{}, Entity, &Reg, &B});
-      Reg.erase<Buff>(Entity);
-      return;
-    }
-    if (St == TimedBuff::State::Waiting) {
-      return;
-    }
-    // Reduce the given amount
-    Sys.publish(BuffApplyEffectEvent{{}, Entity, &Reg, Reduce, &B});
-    if (Reduce) {
-      C.reduce(B.TickAmount);
-    } else {
-      C.restore(B.TickAmount);
+template <typename RegenComp>
+void RegenSystem::onRegenCompDestroy(entt::registry &, entt::entity Entity) {
+  getTimers<RegenComp>().cancel(Entity);
+}
+
+template <typename RegenComp> void RegenSystem::runRegenUpdate() {
+  auto &Timers = getTimers<RegenComp>();
+  for (auto Entity : Timers.advance()) {
+    auto &C = Reg.get<RegenComp>(Entity);
+
+    // Restore the given amount to regenerate, a tick period of zero only
+    // regenerates once
+    C.restore(C.RegenAmount);
+    if (C.TickPeriod != 0) {
+      Timers.schedule(Entity, C.TickPeriod);
     }
-  });
+  }
 }
 
-} // namespace
+RegenSystem::RegenSystem(entt::registry &Reg) : System(Reg) {
+  connectTimers<HealthComp>();
+  connectTimers<ManaComp>();
+}
+
+RegenSystem::~RegenSystem() {
+  disconnectTimers<HealthComp>();
+  disconnectTimers<ManaComp>();
+}
 
 void RegenSystem::update(UpdateType Type) {
   if (Type != UpdateType::Tick) {
     return;
   }
 
-  // Run mana regeneration
-  runRegenUpdate<ManaComp>(Reg);
-  runDimRetValueGenBuff<ManaComp, ManaRegenBuffComp>(*this, Reg,
-                                                     /*Reduce=*/false);
-
-  // Run health regeneration
-  runRegenUpdate<HealthComp>(Reg);
-  runDimRetValueGenBuff<HealthComp, HealthRegenBuffComp>(*this, Reg,
-                                                         /*Reduce=*/false);
-
-  // Run health reduction
-  runDimRetValueGenBuff<HealthComp, PoisonDebuffComp>(*this, Reg,
-                                                      /*Reduce=*/true);
-  runDimRetValueGenBuff<HealthComp, BleedingDebuffComp>(*this, Reg,
-                                                        /*Reduce=*/true);
+  // Run mana and health regeneration, regeneration and reduction by buffs is
+  // applied by the timed buff system
+  runRegenUpdate<ManaComp>();
+  runRegenUpdate<HealthComp>();
 }
 
-} // namespace rogue
\ No newline at end of file
+} // namespace rogue
@@ -1,3 +1,6 @@
+#include <algorithm>
+#include <array>
+#include <cmath>
 #include <rogue/Components/Buffs.h>
 #include <rogue/Components/LOS.h>
 #include <rogue/Components/Stats.h>
@@ -17,32 +20,31 @@ static constexpr float AgilityPerDexLogBase = 1.2f;
 static constexpr float AgilityPerDexScale = 10.0f;
 static constexpr float AgilityPerDexLogOffset = 1.0f;
 
-void resetStats(entt::registry &Reg) {
-  Reg.view<StatsComp>().each([](auto &S) { S.reset(); });
-}
+/// Dex values for which the agility is looked up instead of computed
+static constexpr StatPoint MaxTabulatedDex = 256;
 
-void updateStatsTimedBuffComp(entt::entity Entity, entt::registry &Reg,
-                              StatsComp &S, StatsTimedBuffComp &STB,
-                              bool IsTick) {
-  if (!IsTick) {
-    S.add(STB.Bonus);
-    return;
-  }
+StatValue computeAgility(StatPoint Dex) {
+  return std::log(AgilityPerDexLogBase + Dex) /
+         std::log(AgilityPerDexLogBase + AgilityPerDexLogOffset) *
+         AgilityPerDexScale;
+}
 
-  auto St = STB.tick();
-  if (St == TimedBuff::State::Expired) {
-    Reg.erase<StatsTimedBuffComp>(Entity);
-    return;
+StatValue getAgility(StatPoint Dex) {
+  static const auto Table = [] {
+    std::array<StatValue, MaxTabulatedDex> Table;
+    for (StatPoint Idx = 0; Idx < MaxTabulatedDex; ++Idx) {
+      Table[Idx] = computeAgility(Idx);
+    }
+    return Table;
+  }();
+  if (Dex >= 0 && Dex < MaxTabulatedDex) {
+    return Table[Dex];
   }
-  S.add(STB.Bonus);
+  return computeAgility(Dex);
 }
 
 void updateStatsBuffPerHitComp(entt::entity Entity, entt::registry &Reg,
-                               StatsBuffPerHitComp &SBPH, bool Tick) {
-  if (!SBPH.Stacks) {
-    return;
-  }
-
+                               StatsBuffPerHitComp &SBPH) {
   auto *SC = Reg.try_get<StatsBuffComp>(Entity);
   if (SC && SBPH.AppliedStack) {
     if (SC->remove(SBPH.getEffectiveBuff(*SBPH.AppliedStack))) {
@@ -53,7 +55,8 @@ void updateStatsBuffPerHitComp(entt::entity Entity, entt::registry &Reg,
     SBPH.AppliedStack = std::nullopt;
   }
 
-  if (Tick && SBPH.tick() == TimedBuff::State::Expired) {
+  // All stacks are lost once the buff expired
+  if (!SBPH.Stacks) {
     SBPH.AppliedStack = std::nullopt;
     return;
   }
@@ -68,75 +71,128 @@ void updateStatsBuffPerHitComp(entt::entity Entity, entt::registry &Reg,
   SBPH.AppliedStack = SBPH.Stacks;
 }
 
-void applyStatsBuffPerHitComp(entt::registry &Reg, bool Tick) {
-  Reg.view<StatsBuffPerHitComp>().each([&Reg, Tick](auto Entity, auto &SBPH) {
-    updateStatsBuffPerHitComp(Entity, Reg, SBPH, Tick);
-  });
-}
-
-void applyTimedStatsAndBuffs(entt::registry &Reg, bool IsTick) {
-  // Apply timed stats buff
-  Reg.view<StatsComp, StatsTimedBuffComp>().each(
-      [&Reg, IsTick](auto Entity, auto &S, auto &STB) {
-        updateStatsTimedBuffComp(Entity, Reg, S, STB, IsTick);
-      });
-}
-
-void applyStaticStatBuffs(entt::registry &Reg) {
-  // Apply static stats buff
-  Reg.view<StatsComp, StatsBuffComp>().each(
-      [&Reg](auto Entity, auto &S, auto const &SB) {
-        if (SB.SourceCount == 0) {
-          Reg.erase<StatsBuffComp>(Entity);
-          return;
-        }
-        S.add(SB.Bonus);
-      });
+/// Buffs are ticked and removed on expiry by the timed buff system, only
+/// active ones are applied here
+void applyStatsBuffs(entt::registry &Reg, entt::entity Entity,
+                     StatsComp &S) {
+  if (const auto *STB = Reg.try_get<StatsTimedBuffComp>(Entity)) {
+    S.add(STB->Bonus);
+  }
+  if (const auto *SB = Reg.try_get<StatsBuffComp>(Entity)) {
+    if (SB->SourceCount == 0) {
+      Reg.erase<StatsBuffComp>(Entity);
+      return;
+    }
+    S.add(SB->Bonus);
+  }
 }
 
-void applyStatEffects(entt::registry &Reg) {
+void applyStatEffects(entt::registry &Reg, entt::entity Entity,
+                      const StatsComp &St) {
   // Health
   // If the entity has stats they override the maximum values defined
-  Reg.view<const StatsComp, HealthComp>().each(
-      [](const auto &St, auto &Health) {
-        Health.MaxValue = St.effective().Vit * HealthPerVit;
-        if (Health.Value > Health.MaxValue) {
-          Health.Value = Health.MaxValue;
-        }
-        Health.RegenAmount = St.effective().Vit * HealthRegenPerVit;
-      });
+  if (auto *Health = Reg.try_get<HealthComp>(Entity)) {
+    Health->MaxValue = St.effective().Vit * HealthPerVit;
+    if (Health->Value > Health->MaxValue) {
+      Health->Value = Health->MaxValue;
+    }
+    Health->RegenAmount = St.effective().Vit * HealthRegenPerVit;
+  }
 
   // Mana
   // If the entity has stats they override the maximum values defined
-  Reg.view<const StatsComp, ManaComp>().each([](const auto &St, auto &Mana) {
-    Mana.MaxValue = St.effective().Int * ManaPerInt;
-    if (Mana.Value > Mana.MaxValue) {
-      Mana.Value = Mana.MaxValue;
+  if (auto *Mana = Reg.try_get<ManaComp>(Entity)) {
+    Mana->MaxValue = St.effective().Int * ManaPerInt;
+    if (Mana->Value > Mana->MaxValue) {
+      Mana->Value = Mana->MaxValue;
     }
-    Mana.RegenAmount = St.effective().Int * ManaRegenPerInt;
-  });
+    Mana->RegenAmount = St.effective().Int * ManaRegenPerInt;
+  }
 
   // Agility is determined by Dex
-  Reg.view<const StatsComp, AgilityComp>().each([](const auto &St, auto &Ag) {
-    Ag.Agility = std::log(AgilityPerDexLogBase + St.effective().Dex) /
-                 std::log(AgilityPerDexLogBase + AgilityPerDexLogOffset) *
-                 AgilityPerDexScale;
-  });
+  if (auto *Ag = Reg.try_get<AgilityComp>(Entity)) {
+    Ag->Agility = getAgility(St.effective().Dex);
+  }
 }
 
 } // namespace
 
-void StatsSystem::update(UpdateType Type) {
-  resetStats(Reg);
+template <typename... CompTypes> void StatsSystem::connectComps() {
+  (Reg.on_construct<CompTypes>()
+       .template connect<&StatsSystem::onStatsChanged>(*this),
+   ...);
+  (Reg.on_update<CompTypes>()
+       .template connect<&StatsSystem::onStatsChanged>(*this),
+   ...);
+  (Reg.on_destroy<CompTypes>()
+       .template connect<&StatsSystem::onStatsChanged>(*this),
+   ...);
+}
 
-  // Update stats buff per hit comp
-  applyStatsBuffPerHitComp(Reg, UpdateType::Tick == Type);
+template <typename... CompTypes> void StatsSystem::disconnectComps() {
+  (Reg.on_construct<CompTypes>().disconnect(*this), ...);
+  (Reg.on_update<CompTypes>().disconnect(*this), ...);
+  (Reg.on_destroy<CompTypes>().disconnect(*this), ...);
+}
 
-  // Update timed stats
-  applyTimedStatsAndBuffs(Reg, Type == UpdateType::Tick);
+StatsSystem::StatsSystem(entt::registry &Reg) : System(Reg) {
+  connectComps<StatsComp, StatsBuffComp, StatsTimedBuffComp,
+               StatsBuffPerHitComp, HealthComp, ManaComp, AgilityComp>();
+
+  // Compute stats of entities that were created before the system
+  for (auto Entity : Reg.view<StatsComp>()) {
+    Dirty.push_back(Entity);
+  }
+}
 
-  applyStaticStatBuffs(Reg);
-  applyStatEffects(Reg);
+StatsSystem::~StatsSystem() {
+  disconnectComps<StatsComp, StatsBuffComp, StatsTimedBuffComp,
+                  StatsBuffPerHitComp, HealthComp, ManaComp, AgilityComp>();
+}
+
+void StatsSystem::update(UpdateType) {
+  // Stacks of per hit buffs are changed in place on hit and on expiry
+  Reg.view<const StatsBuffPerHitComp>().each(
+      [this](auto Entity, const auto &SBPH) {
+        if (SBPH.AppliedStack.value_or(0) != SBPH.Stacks) {
+          Dirty.push_back(Entity);
+        }
+      });
+  if (Dirty.empty()) {
+    return;
+  }
+
+  std::sort(Dirty.begin(), Dirty.end());
+  Dirty.erase(std::unique(Dirty.begin(), Dirty.end()), Dirty.end());
+  IsUpdating = true;
+  for (auto Entity : Dirty) {
+    // Entities are marked while being destroyed
+    if (Reg.valid(Entity)) {
+      updateEntity(Entity);
+    }
+  }
+  IsUpdating = false;
+  Dirty.clear();
+}
+
+void StatsSystem::onStatsChanged(entt::registry &, entt::entity Entity) {
+  if (!IsUpdating) {
+    Dirty.push_back(Entity);
+  }
+}
+
+void StatsSystem::updateEntity(entt::entity Entity) {
+  if (auto *SBPH = Reg.try_get<StatsBuffPerHitComp>(Entity)) {
+    updateStatsBuffPerHitComp(Entity, Reg, *SBPH);
+  }
+
+  auto *S = Reg.try_get<StatsComp>(Entity);
+  if (!S) {
+    return;
+  }
+  S->reset();
+  applyStatsBuffs(Reg, Entity, *S);
+  applyStatEffects(Reg, Entity, *S);
 }
 
 } // namespace rogue
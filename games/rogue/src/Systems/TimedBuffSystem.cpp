@@ -0,0 +1,73 @@
+#include <rogue/Components/Buffs.h>
+#include <rogue/Components/Stats.h>
+#include <rogue/Event.h>
+#include <rogue/Systems/TimedBuffSystem.h>
+
+namespace rogue {
+
+template <typename BuffType, typename OnActiveFn>
+void TimedBuffSystem::tickBuffs(bool EraseExpired, OnActiveFn OnActive) {
+  static_assert(std::is_base_of_v<TimedBuff, BuffType>,
+                "Buff must be a timed buff");
+
+  // Buffs of a type are stored densely by the registry, they are ticked in a
+  // single pass through their static type so the call is not virtual. Expired
+  // buffs are erased after the pass to not invalidate the iteration.
+  Expired.clear();
+  Reg.view<BuffType>().each([this, EraseExpired, &OnActive](auto Entity,
+                                                            auto &Buff) {
+    const auto St = Buff.BuffType::tick();
+    if (St == TimedBuff::State::Active) {
+      OnActive(Entity, Buff);
+    } else if (St == TimedBuff::State::Expired && EraseExpired) {
+      publish(BuffExpiredEvent{{}, Entity, &Reg, &Buff});
+      Expired.push_back(Entity);
+    }
+  });
+  Reg.erase<BuffType>(Expired.begin(), Expired.end());
+}
+
+template <typename BuffType>
+void TimedBuffSystem::tickBuffs(bool EraseExpired) {
+  tickBuffs<BuffType>(EraseExpired, [](auto, auto &) {});
+}
+
+template <typename BuffType, typename ValueCompType>
+void TimedBuffSystem::tickValueGenBuffs(bool Reduce) {
+  tickBuffs<BuffType>(
+      /*EraseExpired=*/true, [this, Reduce](auto Entity, auto &Buff) {
+        auto *C = Reg.try_get<ValueCompType>(Entity);
+        if (!C) {
+          return;
+        }
+        publish(BuffApplyEffectEvent{{}, Entity, &Reg, Reduce, &Buff});
+        if (Reduce) {
+          C->reduce(Buff.TickAmount);
+        } else {
+          C->restore(Buff.TickAmount);
+        }
+      });
+}
+
+void TimedBuffSystem::update(UpdateType Type) {
+  if (Type != UpdateType::Tick) {
+    return;
+  }
+
+  // Regeneration and reduction of health and mana
+  tickValueGenBuffs<ManaRegenBuffComp, ManaComp>(/*Reduce=*/false);
+  tickValueGenBuffs<HealthRegenBuffComp, HealthComp>(/*Reduce=*/false);
+  tickValueGenBuffs<PoisonDebuffComp, HealthComp>(/*Reduce=*/true);
+  tickValueGenBuffs<BleedingDebuffComp, HealthComp>(/*Reduce=*/true);
+
+  // Line of sight and visibility
+  tickBuffs<BlindedDebuffComp>();
+  tickBuffs<InvisibilityBuffComp>();
+  tickBuffs<MindVisionBuffComp>();
+
+  // Stats, the buff per hit is kept and only loses its stacks on expiry
+  tickBuffs<StatsTimedBuffComp>();
+  tickBuffs<StatsBuffPerHitComp>(/*EraseExpired=*/false);
+}
+
+} // namespace rogue
@@ -0,0 +1,103 @@
+#include <algorithm>
+#include <rogue/TimerWheel.h>
+
+namespace rogue {
+
+namespace {
+
+constexpr TimerWheel::TickType SlotMask = TimerWheel::NumSlots - 1;
+
+constexpr unsigned getShift(std::size_t Wheel) {
+  return static_cast<unsigned>(Wheel) * TimerWheel::SlotBits;
+}
+
+} // namespace
+
+void TimerWheel::schedule(entt::entity Entity, TickType Delay) {
+  const Timer T{Entity, Now + std::max<TickType>(Delay, 1)};
+  Deadlines[Entity] = T.Deadline;
+  insert(T);
+}
+
+void TimerWheel::cancel(entt::entity Entity) { Deadlines.erase(Entity); }
+
+bool TimerWheel::isScheduled(entt::entity Entity) const {
+  return Deadlines.count(Entity) != 0;
+}
+
+TimerWheel::TickType TimerWheel::getTicksLeft(entt::entity Entity) const {
+  if (auto It = Deadlines.find(Entity); It != Deadlines.end()) {
+    return It->second - Now;
+  }
+  return 0;
+}
+
+void TimerWheel::clear() {
+  for (auto &Wheel : Wheels) {
+    for (auto &Slot : Wheel) {
+      Slot.clear();
+    }
+  }
+  Overflow.clear();
+  Deadlines.clear();
+  Fired.clear();
+}
+
+const std::vector<entt::entity> &TimerWheel::advance() {
+  Fired.clear();
+  ++Now;
+
+  // Once a wheel completed a rotation move the timers of the next slot of the
+  // outer wheel inwards, starting with the outermost so that moved timers
+  // are cascaded further within the same tick
+  if ((Now & ((TickType(1) << getShift(NumWheels)) - 1)) == 0) {
+    reinsert(Overflow);
+  }
+  for (std::size_t Wheel = NumWheels - 1; Wheel > 0; --Wheel) {
+    const auto Shift = getShift(Wheel);
+    if ((Now & ((TickType(1) << Shift) - 1)) != 0) {
+      continue;
+    }
+    reinsert(Wheels[Wheel][(Now >> Shift) & SlotMask]);
+  }
+
+  auto &Slot = Wheels[0][Now & SlotMask];
+  for (const auto &T : Slot) {
+    if (isPending(T)) {
+      Deadlines.erase(T.Entity);
+      Fired.push_back(T.Entity);
+    }
+  }
+  Slot.clear();
+  return Fired;
+}
+
+bool TimerWheel::isPending(const Timer &T) const {
+  auto It = Deadlines.find(T.Entity);
+  return It != Deadlines.end() && It->second == T.Deadline;
+}
+
+void TimerWheel::insert(const Timer &T) {
+  // Use the innermost wheel whose current rotation contains the deadline
+  for (std::size_t Wheel = 0; Wheel < NumWheels; ++Wheel) {
+    const auto Shift = getShift(Wheel + 1);
+    if ((T.Deadline >> Shift) == (Now >> Shift)) {
+      Wheels[Wheel][(T.Deadline >> getShift(Wheel)) & SlotMask].push_back(T);
+      return;
+    }
+  }
+  Overflow.push_back(T);
+}
+
+void TimerWheel::reinsert(std::vector<Timer> &Timers) {
+  auto Moved = std::move(Timers);
+  Timers.clear();
+  for (const auto &T : Moved) {
+    // Drop cancelled timers instead of moving them
+    if (isPending(T)) {
+      insert(T);
+    }
+  }
+}
+
+} // namespace rogue
@@ -6,6 +6,7 @@
 #include <rogue/ItemDatabase.h>
 #include <rogue/Level.h>
 #include <rogue/LevelGenerator.h>
+#include <rogue/Profiler.h>
 #include <rogue/UI/CommandLine.h>
 #include <rogue/UI/Controller.h>
 #include <rogue/UI/Controls.h>
@@ -134,6 +135,23 @@ bool CommandLineController::handleCommandLine(const std::string &Cmd) {
     Ctrl.DelayTicks = !Ctrl.DelayTicks;
     publish(DebugMessageEvent()
             << "Delaying ticks: " + std::to_string(Ctrl.DelayTicks));
+  } else if (Cmd == "profile") {
+    auto &Prof = Profiler::get();
+    Prof.setEnabled(!Prof.isEnabled());
+    publish(DebugMessageEvent()
+            << "Profiling: " + std::to_string(Prof.isEnabled()));
+  } else if (Cmd == "profile_dump") {
+    try {
+      Profiler::get().dump(Profiler::DefaultCSVFile,
+                           Profiler::DefaultTraceFile);
+      publish(DebugMessageEvent()
+              << "Profile written to: " +
+                     std::string(Profiler::DefaultCSVFile) + ", " +
+                     std::string(Profiler::DefaultTraceFile));
+    } catch (const std::exception &E) {
+      publish(DebugMessageEvent()
+              << "Failed to write profile: " + std::string(E.what()));
+    }
   } else if (startswith(Cmd, "give_item ")) {
     auto ItemName = Cmd.substr(10);
     publish(DebugMessageEvent() << "Giving item: " + ItemName);
@@ -18,6 +18,7 @@
 // FIXME get rid of dep
 #include <rogue/Components/Items.h>
 #include <rogue/Level.h>
+#include <rogue/Profiler.h>
 
 namespace rogue::ui {
 
@@ -34,6 +35,8 @@ Controller::Controller(cxxg::Screen &Scr)
 
 void Controller::draw(int LevelIdx, const PlayerInfo &PI,
                       const std::optional<TargetInfo> &TI) {
+  Profiler::ScopedTimer Timer("ui::Controller::draw");
+
   // Define colors
   const auto NoColor = cxxg::types::Color::NONE;
   const auto NoInterColor = cxxg::types::Color::GREY;
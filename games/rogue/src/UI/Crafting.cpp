@@ -1,3 +1,5 @@
+#include <algorithm>
+#include <rogue/Components/Items.h>
 #include <rogue/Components/Player.h>
 #include <rogue/CraftingDatabase.h>
 #include <rogue/CraftingHandler.h>
@@ -47,6 +49,10 @@ void CraftingController::draw(cxxg::Screen &Scr) const {
   BaseRectDecorator::draw(Scr);
 }
 
+bool CraftingController::isDirty() const {
+  return BaseRectDecorator::isDirty() || !(getModelState() == ShownState);
+}
+
 std::string CraftingController::getInteractMsg() const {
   std::vector<KeyOption> Options = {Controls::Navigate, Controls::Info,
                                     Controls::Craft};
@@ -86,7 +92,19 @@ void CraftingController::handleCraft() {
   }
 }
 
+CraftingController::ModelState CraftingController::getModelState() const {
+  ModelState State;
+  if (const auto *PC = Reg.try_get<PlayerComp>(Entity)) {
+    State.NumKnownRecipes = PC->KnownRecipes.size();
+  }
+  if (const auto *IC = Reg.try_get<InventoryComp>(Entity)) {
+    State.InventoryRevision = IC->Inv.getRevision();
+  }
+  return State;
+}
+
 void CraftingController::updateElements() const {
+  ShownState = getModelState();
   const auto &Recipes = CraftingDb.getRecipes();
 
   auto *PC = Reg.try_get<PlayerComp>(Entity);
@@ -99,10 +117,11 @@ void CraftingController::updateElements() const {
   std::vector<ListSelect::Element> Elements;
   Elements.reserve(PC->KnownRecipes.size());
   InventoryHandler InvHandler(Entity, Reg, Crafter);
+  const auto Craftable = InvHandler.getCraftableRecipes();
   for (const auto &RecipeId : PC->KnownRecipes) {
     const auto &Recipe = Recipes.at(RecipeId);
     auto Color = cxxg::types::RgbColor{200, 80, 55};
-    if (InvHandler.canCraft(Recipe)) {
+    if (std::binary_search(Craftable.begin(), Craftable.end(), RecipeId)) {
       Color = cxxg::types::RgbColor{40, 130, 40};
     }
     Elements.push_back({Recipe.getName(), Color});
@@ -15,6 +15,7 @@ void Decorator::setPos(cxxg::types::Position P) {
 
 void Decorator::setComp(std::shared_ptr<Widget> Comp) {
   this->Comp = std::move(Comp);
+  markDirty();
 }
 
 bool Decorator::handleInput(int Char) { return Comp->handleInput(Char); }
@@ -23,6 +24,17 @@ std::string Decorator::getInteractMsg() const { return Comp->getInteractMsg(); }
 
 void Decorator::draw(cxxg::Screen &Scr) const { Comp->draw(Scr); }
 
+bool Decorator::isDirty() const {
+  return Dirty || (Comp && Comp->isDirty());
+}
+
+void Decorator::clearDirty() {
+  Dirty = false;
+  if (Comp) {
+    Comp->clearDirty();
+  }
+}
+
 BaseRectDecorator::BaseRectDecorator(cxxg::types::Position Pos,
                                      cxxg::types::Size Size,
                                      std::shared_ptr<Widget> Comp)
@@ -75,4 +87,6 @@ void MoveDecorator::draw(cxxg::Screen &Scr) const {
   Scr[Pos.Y][Pos.X] << IconColor << "X";
 }
 
+bool MoveDecorator::isCacheable() const { return Comp->isCacheable(); }
+
 } // namespace rogue::ui
\ No newline at end of file
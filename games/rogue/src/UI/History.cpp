@@ -11,16 +11,16 @@ HistoryController::HistoryController(cxxg::types::Position Pos,
                                      const History &Hist,
                                      unsigned NumHistoryRows)
     : Widget(Pos), Hist(Hist), NumHistoryRows(NumHistoryRows) {
-  auto NumMsgs = Hist.getMessages().size();
+  auto NumMsgs = Hist.getNumMessages();
   if (NumMsgs > NumHistoryRows) {
-    Offset = Hist.getMessages().size() - NumHistoryRows;
+    Offset = NumMsgs - NumHistoryRows;
   }
 }
 
 bool HistoryController::handleInput(int Char) {
   switch (Char) {
   case Controls::MoveDown.Char:
-    if (!Hist.getMessages().empty() && Offset < Hist.getMessages().size() - 2) {
+    if (Hist.getNumMessages() > 0 && Offset < Hist.getNumMessages() - 2) {
       Offset++;
     }
     break;
@@ -50,12 +50,12 @@ void HistoryController::draw(cxxg::Screen &Scr) const {
   Frame::drawFrameHeader(Scr, {Pos.X, Pos.Y}, Header, Scr.getSize().X,
                          cxxg::types::Color::NONE, cxxg::types::Color::NONE);
 
-  const auto &Msgs = Hist.getMessages();
+  const auto NumMsgs = Hist.getNumMessages();
   for (unsigned int Idx = 0; Idx < NumHistoryRows; Idx++) {
     const int LinePos = Pos.Y + Idx + 1;
     const unsigned MsgPos = Idx + Offset;
 
-    if (MsgPos >= Msgs.size()) {
+    if (MsgPos >= NumMsgs) {
       Scr[LinePos][Pos.X] << std::string(Scr.getSize().X, ' ');
       continue;
     }
@@ -66,25 +66,26 @@ void HistoryController::draw(cxxg::Screen &Scr) const {
       continue;
     }
 
-    if (Idx == NumHistoryRows - 1 && MsgPos < Msgs.size() - 1) {
+    if (Idx == NumHistoryRows - 1 && MsgPos < NumMsgs - 1) {
       Scr[LinePos][Pos.X] << std::string(Scr.getSize().X, ' ');
       Scr[LinePos][Pos.X + Scr.getSize().X / 2] = 'v';
       continue;
     }
 
-    const auto &Msg = Msgs.at(MsgPos);
+    // Only visible messages are materialized into rows
+    const auto &Msg = Hist.getMessage(MsgPos);
     if (Msg.Count > 1) {
-      Scr[LinePos][Pos.X] << Msg.Count << "x " << Msgs.at(MsgPos).Row;
+      Scr[LinePos][Pos.X] << Msg.Count << "x " << Msg.getRow(Scr.getSize().X);
     } else {
-      Scr[LinePos][Pos.X] << Msgs.at(MsgPos).Row;
+      Scr[LinePos][Pos.X] << Msg.getRow(Scr.getSize().X);
     }
   }
 
   // Draw footer
   const unsigned Start =
-      std::min(Msgs.size(), static_cast<std::size_t>(Offset + 1));
+      std::min(NumMsgs, static_cast<std::size_t>(Offset + 1));
   const unsigned End =
-      std::min(Msgs.size(), static_cast<std::size_t>(Offset + NumHistoryRows));
+      std::min(NumMsgs, static_cast<std::size_t>(Offset + NumHistoryRows));
   std::string Footer = std::to_string(Start) + "-" + std::to_string(End);
 
   Frame::drawFrameHeader(Scr, {Pos.X, Pos.Y + NumHistoryRows + 1}, Footer,
@@ -64,11 +64,17 @@ void InventoryControllerBase::draw(cxxg::Screen &Scr) const {
   BaseRectDecorator::draw(Scr);
 }
 
+bool InventoryControllerBase::isDirty() const {
+  // Items may also be moved by other windows or the game
+  return BaseRectDecorator::isDirty() || Inv.getRevision() != ShownRevision;
+}
+
 Inventory &InventoryControllerBase::getInventory() { return Inv; }
 
 const Inventory &InventoryControllerBase::getInventory() const { return Inv; }
 
 void InventoryControllerBase::updateElements() const {
+  ShownRevision = Inv.getRevision();
   std::vector<ListSelect::Element> Elements;
   Elements.reserve(Inv.getItems().size());
   for (const auto &Item : Inv.getItems()) {
@@ -58,7 +58,7 @@ getColorForItemEffects(const std::vector<EffectInfo> &Effects,
 } // namespace
 
 cxxg::types::TermColor getColorForItem(const Item &It) {
-  const auto AllEffects = It.getAllEffects();
+  const auto &AllEffects = It.getAllEffects();
   if (It.getType() & ItemType::EquipmentMask && AllEffects.size() > 1) {
     return getColorForItemEffects(AllEffects, CapabilityFlags::Equipment |
                                                   CapabilityFlags::Skill);
@@ -125,7 +125,7 @@ std::string getCapabilityDescription(const ItemType &ItType,
 
 std::string getItemEffectDescription(const Item &It) {
   std::stringstream SS;
-  const auto AllEffects = It.getAllEffects();
+  const auto &AllEffects = It.getAllEffects();
 
   SS << getCapabilityDescription(
             It.getType(), AllEffects,
@@ -12,6 +12,7 @@ ListSelect::ListSelect(cxxg::types::Position Pos, cxxg::types::Size Size,
 void ListSelect::setElements(const std::vector<Element> &Elements) {
   this->Elements = Elements;
   SelectedElemIdx = 0;
+  markDirty();
 }
 
 const std::vector<ListSelect::Element> &ListSelect::getElements() const {
@@ -19,9 +20,12 @@ const std::vector<ListSelect::Element> &ListSelect::getElements() const {
 }
 
 void ListSelect::selectElement(std::size_t ElemIdx) {
-  SelectedElemIdx = ElemIdx;
-  if (SelectedElemIdx >= Elements.size()) {
-    SelectedElemIdx = 0;
+  if (ElemIdx >= Elements.size()) {
+    ElemIdx = 0;
+  }
+  if (SelectedElemIdx != ElemIdx) {
+    SelectedElemIdx = ElemIdx;
+    markDirty();
   }
 }
 
@@ -137,23 +137,33 @@ std::shared_ptr<Widget> makeHelpCraftingWindow() {
 }
 
 std::shared_ptr<Widget> makeSlotsWindow(
-    const std::string &Title, bool StoreAsJSON,
+    const std::string &Title, bool StoreAsJSON, bool WithAutoSave,
     const std::function<void(const SaveGameInfo &SGI)> &SlotSelectCb) {
+  static constexpr unsigned NumSlots = 5;
   cxxg::types::Position Pos = {2, 2};
   static constexpr auto SlotWdwPos = cxxg::types::Position{2, 2};
-  static constexpr auto SlotWdwSize = cxxg::types::Size{30, 12};
+  const auto SlotWdwSize =
+      cxxg::types::Size{30, 2 + 2 * (NumSlots + (WithAutoSave ? 1 : 0))};
 
   std::shared_ptr<ItemSelect> SlotSelect = std::make_shared<ItemSelect>(Pos);
 
   std::string SlotStr = "Slot 0";
 
-  std::map<std::string, SaveGameInfo> SgMap;
-  for (unsigned SlotIdx = 0; SlotIdx < 5; SlotIdx++) {
+  std::vector<SaveGameInfo> SGIs;
+  for (unsigned SlotIdx = 0; SlotIdx < NumSlots; SlotIdx++) {
     SlotStr[5] = '1' + SlotIdx;
-
     auto SGI = SaveGameInfo::fromSlot(SlotIdx, StoreAsJSON);
     SGI.Name = SlotStr;
-    SgMap[SlotStr] = SGI;
+    SGIs.push_back(SGI);
+  }
+  if (WithAutoSave) {
+    SGIs.push_back(SaveGameInfo::getAutoSave());
+  }
+
+  std::map<std::string, SaveGameInfo> SgMap;
+  for (unsigned SlotIdx = 0; SlotIdx < SGIs.size(); SlotIdx++) {
+    const auto &SGI = SGIs.at(SlotIdx);
+    SgMap[SGI.Name] = SGI;
 
     std::string Label = "Empty";
     cxxg::types::TermColor LabelColor = cxxg::types::Color::GREY;
@@ -165,7 +175,7 @@ std::shared_ptr<Widget> makeSlotsWindow(
     auto SlotPos = Pos;
     SlotPos.Y += SlotIdx * 2;
     SlotSelect->addSelect<LabeledSelect>(
-        SlotStr, Label, SlotPos, static_cast<unsigned>(SlotWdwSize.X - 2),
+        SGI.Name, Label, SlotPos, static_cast<unsigned>(SlotWdwSize.X - 2),
         LabelColor, LabelColor);
   }
 
@@ -201,7 +211,8 @@ std::shared_ptr<Widget>
 makeLoadSlotWindow(Controller &Ctrl, MenuController::LoadGameCbTy LoadGameCb,
                    bool StoreAsJSON) {
   return makeSlotsWindow(
-      "Load Game", StoreAsJSON, [LoadGameCb, &Ctrl](const auto SGI) mutable {
+      "Load Game", StoreAsJSON, /*WithAutoSave=*/true,
+      [LoadGameCb, &Ctrl](const auto SGI) mutable {
         if (!SGI.exists()) {
           return;
         }
@@ -239,7 +250,8 @@ std::shared_ptr<Widget>
 makeSaveSlotWindow(Controller &Ctrl, MenuController::SaveGameCbTy SaveGameCb,
                    bool StoreAsJSON) {
   return makeSlotsWindow(
-      "Save Game", StoreAsJSON, [SaveGameCb, &Ctrl](const auto SGI) mutable {
+      "Save Game", StoreAsJSON, /*WithAutoSave=*/false,
+      [SaveGameCb, &Ctrl](const auto SGI) mutable {
         std::stringstream SS;
         SS << "Save game to " << SGI.Name << "?";
         if (SGI.exists()) {
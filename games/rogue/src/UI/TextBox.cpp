@@ -11,6 +11,13 @@ TextBox::TextBox(cxxg::types::Position Pos, cxxg::types::Size Size,
 
 void TextBox::setText(const std::string &Text) {
   Wrap = WordWrap(Text, Size.X - Padding.X * 2);
+  markDirty();
+}
+
+void TextBox::setSize(cxxg::types::Size Size) {
+  BaseRect::setSize(Size);
+  Wrap.setLineWidth(Size.X - Padding.X * 2);
+  markDirty();
 }
 
 bool TextBox::handleInput(int Char) {
@@ -21,11 +28,13 @@ bool TextBox::handleInput(int Char) {
     const auto NumRows = Size.Y - Padding.Y * 2;
     if (Wrap.getNumLines() >= NumRows && ScrollIdx < Wrap.getNumLines() - 1) {
       ScrollIdx++;
+      markDirty();
     }
   } break;
   case Controls::MoveUp.Char:
     if (ScrollIdx > 0) {
       ScrollIdx--;
+      markDirty();
     }
     break;
   default:
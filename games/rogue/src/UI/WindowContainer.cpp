@@ -1,5 +1,6 @@
 #include <algorithm>
 #include <cxxg/Screen.h>
+#include <iterator>
 #include <optional>
 #include <rogue/UI/Controls.h>
 #include <rogue/UI/Frame.h>
@@ -76,14 +77,23 @@ std::string WindowContainer::getInteractMsg() const {
 }
 
 void WindowContainer::draw(cxxg::Screen &Scr) const {
+  // Drop caches of windows that were closed or replaced, e.g. by the move
+  // decorator
+  for (auto It = Caches.begin(); It != Caches.end();) {
+    const auto IsOpen = std::any_of(
+        Windows.begin(), Windows.end(),
+        [Wdw = It->first](const auto &Window) { return Window.get() == Wdw; });
+    It = IsOpen ? std::next(It) : Caches.erase(It);
+  }
+
   for (const auto &Window : Windows) {
     if (Window.get() != &getActiveWindow()) {
-      Window->draw(Scr);
+      drawWindow(Scr, *Window);
     }
   }
   if (hasActiveWindow()) {
     const auto &Wdw = getActiveWindow();
-    Wdw.draw(Scr);
+    drawWindow(Scr, *Windows.at(FocusIdx));
 
     //    ,_
     //    |+--------+
@@ -99,6 +109,46 @@ void WindowContainer::draw(cxxg::Screen &Scr) const {
   }
 }
 
+void WindowContainer::drawWindow(cxxg::Screen &Scr, Widget &Wdw) const {
+  // Only windows that paint their whole known rectangle and track changes of
+  // their model can be cached, everything else is drawn every time
+  if (!Wdw.isCacheable()) {
+    Wdw.draw(Scr);
+    return;
+  }
+  auto WI = WindowInfo::getWindowInfo(&Wdw);
+  if (!WI || WI->Area == 0) {
+    Wdw.draw(Scr);
+    return;
+  }
+
+  auto &Cache = Caches[&Wdw];
+  if (!Wdw.isDirty() && Cache.Pos == WI->Pos && Cache.Size.X == WI->Size.X &&
+      Cache.Size.Y == WI->Size.Y && !Cache.Rows.empty()) {
+    for (std::size_t Y = 0; Y < Cache.Rows.size(); ++Y) {
+      Scr[WI->Pos.Y + static_cast<int>(Y)].blit(WI->Pos.X, Cache.Rows[Y]);
+    }
+    return;
+  }
+
+  Wdw.draw(Scr);
+
+  Cache.Pos = WI->Pos;
+  Cache.Size = WI->Size;
+  Cache.Rows.clear();
+  Cache.Rows.reserve(WI->Size.Y);
+  for (int Y = 0; Y < static_cast<int>(WI->Size.Y); ++Y) {
+    Cache.Rows.push_back(Scr[WI->Pos.Y + Y].slice(WI->Pos.X, WI->Size.X));
+  }
+  Wdw.clearDirty();
+}
+
+void WindowContainer::invalidate() {
+  for (auto &Wdw : Windows) {
+    Wdw->markDirty();
+  }
+}
+
 bool WindowContainer::hasActiveWindow() const { return !Windows.empty(); }
 
 Widget &WindowContainer::getActiveWindow() { return *Windows.at(FocusIdx); }
@@ -168,6 +218,7 @@ void changeWindowHighlight(Widget &W, bool Highlight) {
 void WindowContainer::selectWindow(std::size_t Idx) {
   if (FocusIdx < Windows.size()) {
     changeWindowHighlight(*Windows.at(FocusIdx), false);
+    Windows.at(FocusIdx)->markDirty();
   }
 
   PrevFocusIdx = FocusIdx;
@@ -178,6 +229,7 @@ void WindowContainer::selectWindow(std::size_t Idx) {
 
   if (!Windows.empty()) {
     changeWindowHighlight(*Windows.at(FocusIdx), true);
+    Windows.at(FocusIdx)->markDirty();
   }
 }
 
@@ -217,12 +269,43 @@ bool isOverlapping(const WindowContainer::WindowInfo &WdwInfo,
   return false;
 }
 
+/// Returns the sorted candidate coordinates along one axis, a window placed
+/// first-fit always either starts at the start position or directly next to
+/// an already placed window (including spacing)
+std::vector<unsigned long>
+getCandidateCoords(unsigned long Start,
+                   const std::vector<WindowContainer::WindowInfo> &WdwInfos,
+                   bool IsX) {
+  std::vector<unsigned long> Coords;
+  Coords.reserve(WdwInfos.size() * 3 + 1);
+  Coords.push_back(Start);
+  for (const auto &Other : WdwInfos) {
+    if (Other.Pos.X == -1 && Other.Pos.Y == -1) {
+      continue;
+    }
+    const auto End =
+        IsX ? Other.Pos.X + Other.Size.X : Other.Pos.Y + Other.Size.Y;
+    for (unsigned long Offset = 0; Offset < 3; ++Offset) {
+      if (End + Offset > Start) {
+        Coords.push_back(End + Offset);
+      }
+    }
+  }
+  std::sort(Coords.begin(), Coords.end());
+  Coords.erase(std::unique(Coords.begin(), Coords.end()), Coords.end());
+  return Coords;
+}
+
 std::optional<cxxg::types::Position> findPositionForWindow(
     cxxg::types::Position StartPos, cxxg::types::Size Size,
     WindowContainer::WindowInfo &WdwInfo,
     const std::vector<WindowContainer::WindowInfo> &WdwInfos) {
-  for (unsigned long Y = StartPos.Y; Y < StartPos.Y + Size.Y; ++Y) {
-    for (unsigned long X = StartPos.X; X < StartPos.X + Size.X; ++X) {
+  // Instead of testing every cell only test positions adjacent to placed
+  // windows, yields the same position as a full row-major scan
+  const auto Xs = getCandidateCoords(StartPos.X, WdwInfos, /*IsX=*/true);
+  const auto Ys = getCandidateCoords(StartPos.Y, WdwInfos, /*IsX=*/false);
+  for (const auto Y : Ys) {
+    for (const auto X : Xs) {
       if (X + WdwInfo.Size.X > StartPos.X + Size.X ||
           Y + WdwInfo.Size.Y > StartPos.Y + Size.Y) {
         continue;
@@ -291,6 +374,7 @@ bool WindowContainer::exitMoveActiveWindow() {
     return false;
   }
   getActiveWindowPtr() = MoveDeco->getComp();
+  Caches.erase(MoveDeco.get());
   MoveDeco.reset();
   return true;
 }
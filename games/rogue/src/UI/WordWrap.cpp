@@ -1,24 +1,54 @@
+#include <functional>
+#include <list>
+#include <map>
 #include <rogue/UI/WordWrap.h>
+#include <unordered_map>
 
 namespace rogue::ui {
 
-WordWrap::WordWrap(const std::string &Text, std::size_t LineWidth)
-    : LineWidth(LineWidth), StrBuffer(Text) {
+namespace {
 
-  // reserve least amount of lines needed
-  LineIntvs.reserve(Text.size() / LineWidth + 1);
+std::shared_ptr<const WordWrap::TextLayout>
+createTextLayout(const std::string &Text) {
+  auto Layout = std::make_shared<WordWrap::TextLayout>();
+  Layout->Text = Text;
+  Layout->StrBuffer = Text;
+
+  std::size_t Start = 0;
+  for (std::size_t Pos = 0; Pos < Text.size(); ++Pos) {
+    if (Text[Pos] == '\n') {
+      Layout->Paragraphs.push_back({Start, Pos - Start});
+      Layout->StrBuffer[Pos] = ' ';
+      Start = Pos + 1;
+    }
+  }
+  Layout->Paragraphs.push_back({Start, Text.size() - Start});
+
+  // Trailing whitespace so the last line is never an empty string
+  Layout->StrBuffer.push_back(' ');
+  return Layout;
+}
+
+void wrapParagraph(const std::string &Text, WordWrap::Interval Paragraph,
+                   bool IsLast, std::size_t LineWidth,
+                   WordWrap::LineIntervals &LineIntvs) {
+  // Fast path, paragraph fits into a single line
+  if (Paragraph.End <= LineWidth && (Paragraph.End != 0 || !IsLast)) {
+    LineIntvs.push_back(Paragraph);
+    return;
+  }
 
-  std::size_t CurrentReadPos = 0;
+  std::size_t CurrentReadPos = Paragraph.Start;
   std::size_t CurrentWordSize = 0;
   std::size_t CurrentLineSize = 0;
-  std::size_t LastLineEnd = 0;
+  std::size_t LastLineEnd = Paragraph.Start;
 
   auto checkAndAddLine = [&]() {
     // current line size with last word 'CurrentWordSize' and
     // whitespace greater than line size?
     if (CurrentLineSize + CurrentWordSize > LineWidth) {
       // add interval
-      LineIntvs.push_back(Interval{LastLineEnd, CurrentLineSize});
+      LineIntvs.push_back(WordWrap::Interval{LastLineEnd, CurrentLineSize});
 
       // set end of last line and reset current line size
       LastLineEnd += CurrentLineSize;
@@ -35,7 +65,7 @@ WordWrap::WordWrap(const std::string &Text, std::size_t LineWidth)
       // add as much as possible to current line
       auto LineLeft = static_cast<int>(LineWidth - CurrentLineSize);
       if (LineLeft > 0) {
-        LineIntvs.push_back(Interval{LastLineEnd, LineWidth});
+        LineIntvs.push_back(WordWrap::Interval{LastLineEnd, LineWidth});
         LastLineEnd += LineWidth;
         CurrentLineSize = 0;
         CurrentWordSize -= LineLeft;
@@ -43,16 +73,17 @@ WordWrap::WordWrap(const std::string &Text, std::size_t LineWidth)
 
       // add as many lines as needed
       while (CurrentWordSize > LineWidth) {
-        LineIntvs.push_back(Interval{LastLineEnd, LineWidth});
+        LineIntvs.push_back(WordWrap::Interval{LastLineEnd, LineWidth});
         LastLineEnd += LineWidth;
         CurrentWordSize -= LineWidth;
       }
     }
   };
 
-  while (CurrentReadPos < Text.size()) {
+  const auto ParagraphEnd = Paragraph.Start + Paragraph.End;
+  while (CurrentReadPos < ParagraphEnd) {
     // not a whitespace character?
-    if (Text[CurrentReadPos] != ' ' && Text[CurrentReadPos] != '\n') {
+    if (Text[CurrentReadPos] != ' ') {
       // yes, increase current word size
       CurrentWordSize += 1;
     } else {
@@ -65,14 +96,6 @@ WordWrap::WordWrap(const std::string &Text, std::size_t LineWidth)
       // add started word to current line
       CurrentLineSize += CurrentWordSize + 1;
       CurrentWordSize = 0;
-
-      if (Text[CurrentReadPos] == '\n') {
-        // got new line character -> forced new line
-        LineIntvs.push_back(Interval{LastLineEnd, CurrentLineSize - 1});
-        StrBuffer[LastLineEnd + CurrentLineSize - 1] = ' ';
-        LastLineEnd += CurrentLineSize;
-        CurrentLineSize = 0;
-      }
     }
     // increase reading pos
     CurrentReadPos++;
@@ -84,14 +107,119 @@ WordWrap::WordWrap(const std::string &Text, std::size_t LineWidth)
   // handle adding a new line to wrap the word if needed
   checkAndAddLine();
 
-  // Create an interval for the last line, if the last line is empty, add a
-  // whitespace so we do not have an empty string
+  // Create an interval for the last line of the paragraph, if the last line
+  // of the text is empty use the trailing whitespace so we do not have an
+  // empty string
   CurrentLineSize += CurrentWordSize;
-  if (CurrentLineSize == 0) {
-    StrBuffer.push_back(' ');
+  if (CurrentLineSize == 0 && IsLast) {
     CurrentLineSize++;
   }
-  LineIntvs.push_back(Interval{LastLineEnd, CurrentLineSize});
+  LineIntvs.push_back(WordWrap::Interval{LastLineEnd, CurrentLineSize});
+}
+
+std::shared_ptr<const WordWrap::LineIntervals>
+wrapText(const WordWrap::TextLayout &Layout, std::size_t LineWidth) {
+  auto LineIntvs = std::make_shared<WordWrap::LineIntervals>();
+
+  // reserve least amount of lines needed
+  LineIntvs->reserve(Layout.Text.size() / LineWidth +
+                     Layout.Paragraphs.size());
+
+  for (std::size_t Idx = 0; Idx < Layout.Paragraphs.size(); ++Idx) {
+    wrapParagraph(Layout.StrBuffer, Layout.Paragraphs[Idx],
+                  Idx + 1 == Layout.Paragraphs.size(), LineWidth, *LineIntvs);
+  }
+  return LineIntvs;
+}
+
+/// Least recently used cache of text layouts and their wrapped lines per
+/// line width
+class WrapCache {
+public:
+  struct Entry {
+    std::shared_ptr<const WordWrap::TextLayout> Layout;
+    std::map<std::size_t, std::shared_ptr<const WordWrap::LineIntervals>>
+        Wraps;
+    std::list<std::size_t>::iterator LRUIt;
+  };
+
+public:
+  static WrapCache &get() {
+    static WrapCache Cache;
+    return Cache;
+  }
+
+  Entry &getEntry(const std::string &Text) {
+    const auto Hash = std::hash<std::string>{}(Text);
+    auto It = Entries.find(Hash);
+    if (It != Entries.end() && It->second.Layout->Text == Text) {
+      LRU.splice(LRU.begin(), LRU, It->second.LRUIt);
+      return It->second;
+    }
+
+    // Either not cached yet or a hash collision, replace the entry
+    if (It != Entries.end()) {
+      LRU.erase(It->second.LRUIt);
+      Entries.erase(It);
+    }
+    while (Entries.size() >= WordWrap::MaxCachedTexts) {
+      Entries.erase(LRU.back());
+      LRU.pop_back();
+    }
+
+    LRU.push_front(Hash);
+    auto &E = Entries[Hash];
+    E.Layout = createTextLayout(Text);
+    E.LRUIt = LRU.begin();
+    return E;
+  }
+
+  std::shared_ptr<const WordWrap::LineIntervals>
+  getLines(Entry &E, std::size_t LineWidth) {
+    auto &Lines = E.Wraps[LineWidth];
+    if (!Lines) {
+      Lines = wrapText(*E.Layout, LineWidth);
+    }
+    return Lines;
+  }
+
+  void clear() {
+    Entries.clear();
+    LRU.clear();
+  }
+
+  std::size_t size() const { return Entries.size(); }
+
+private:
+  std::unordered_map<std::size_t, Entry> Entries;
+  std::list<std::size_t> LRU;
+};
+
+} // namespace
+
+WordWrap::WordWrap(const std::string &Text, std::size_t LineWidth)
+    : LineWidth(LineWidth) {
+  auto &Cache = WrapCache::get();
+  auto &E = Cache.getEntry(Text);
+  Layout = E.Layout;
+  LineIntvs = Cache.getLines(E, LineWidth);
 }
 
-} // namespace rogue::ui
\ No newline at end of file
+void WordWrap::setLineWidth(std::size_t LineWidth) {
+  if (this->LineWidth == LineWidth) {
+    return;
+  }
+  this->LineWidth = LineWidth;
+
+  // Look up the text again as it may have been evicted in the meantime
+  auto &Cache = WrapCache::get();
+  auto &E = Cache.getEntry(Layout->Text);
+  Layout = E.Layout;
+  LineIntvs = Cache.getLines(E, LineWidth);
+}
+
+void WordWrap::clearCache() { WrapCache::get().clear(); }
+
+std::size_t WordWrap::getNumCachedTexts() { return WrapCache::get().size(); }
+
+} // namespace rogue::ui
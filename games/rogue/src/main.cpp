@@ -1,7 +1,9 @@
 #include <cxxg/Screen.h>
 #include <cxxg/Utils.h>
+#include <rogue/DataBundle.h>
 #include <rogue/Game.h>
 #include <rogue/GameConfig.h>
+#include <rogue/Profiler.h>
 #include <stdexcept>
 #include <string_view>
 
@@ -40,6 +42,17 @@ int run_game(cxxg::Screen &Scr, const rogue::GameConfig &Cfg) {
   return 0;
 }
 
+void dump_profile() {
+  try {
+    if (rogue::Profiler::get().isEnabled()) {
+      rogue::Profiler::get().dump(rogue::Profiler::DefaultCSVFile,
+                                  rogue::Profiler::DefaultTraceFile);
+    }
+  } catch (std::exception const &E) {
+    std::cerr << "ERROR: Dumping profile: " << E.what() << std::endl;
+  }
+}
+
 int wrapped_main(int Argc, char *Argv[]) {
   if (Argc == 2 && (std::string_view(Argv[1]) == "--help" ||
                     std::string_view(Argv[1]) == "-h")) {
@@ -54,6 +67,20 @@ int wrapped_main(int Argc, char *Argv[]) {
     CfgFile = std::filesystem::path(Argv[0]).parent_path() / ".." / "shared" /
               "data" / "game_config.json";
   }
+
+  // Use the precompiled game data if available, a broken bundle falls back
+  // to loading the JSON files
+  const auto BundleFile =
+      CfgFile.parent_path() / rogue::DataBundle::DefaultFileName;
+  if (std::filesystem::exists(BundleFile)) {
+    try {
+      rogue::DataBundle::setActive(std::make_shared<rogue::DataBundle>(
+          rogue::DataBundle::read(BundleFile)));
+    } catch (std::exception const &E) {
+      std::cerr << "WARNING: Ignoring data bundle: " << E.what() << std::endl;
+    }
+  }
+
   auto Cfg = rogue::GameConfig::load(CfgFile);
   if (Argc == 4) {
     assert(std::string(Argv[2]) == "--seed");
@@ -65,6 +92,10 @@ int wrapped_main(int Argc, char *Argv[]) {
   // Dump the game configuration and clear the screen
   std::cout << Cfg << "\033[2J";
 
+  // Make sure the profiler outlives the exit handler dumping it
+  rogue::Profiler::get();
+  std::atexit(dump_profile);
+
   cxxg::Screen Scr(cxxg::Screen::getTerminalSize());
   cxxg::utils::registerSigintHandler([]() { exit(0); });
 
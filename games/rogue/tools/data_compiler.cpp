@@ -0,0 +1,113 @@
+#include <filesystem>
+#include <iostream>
+#include <rapidjson/stringbuffer.h>
+#include <rapidjson/writer.h>
+#include <rogue/CraftingDatabase.h>
+#include <rogue/DataBundle.h>
+#include <rogue/EntityDatabase.h>
+#include <rogue/GameConfig.h>
+#include <rogue/ItemDatabase.h>
+#include <rogue/JSON.h>
+#include <rogue/LevelDatabase.h>
+#include <rogue/LevelGenerator.h>
+#include <set>
+#include <string>
+#include <type_traits>
+
+void usage(const char *Argv0) {
+  std::cerr << "usage: " << Argv0 << " <game_config> (<output_bundle>)\n"
+            << "  Validates all game data reachable from the game config and\n"
+            << "  compiles it into a data bundle, by default '"
+            << rogue::DataBundle::DefaultFileName
+            << "' next to the game config." << std::endl;
+}
+
+/// Returns the JSON document without any whitespace
+std::string compactJSON(std::string_view Data) {
+  rogue::JSONDocument Doc;
+  Doc.Parse(Data.data(), Data.size());
+  rapidjson::StringBuffer SB;
+  rapidjson::Writer<rapidjson::StringBuffer> Writer(SB);
+  Doc.Accept(Writer);
+  return std::string(SB.GetString(), SB.GetSize());
+}
+
+/// Loads the level configuration and all configurations it references
+void loadLevelConfig(const std::filesystem::path &CfgFile,
+                     const std::filesystem::path &DataDir,
+                     std::set<std::filesystem::path> &Seen) {
+  if (!Seen.insert(CfgFile.lexically_normal()).second) {
+    return;
+  }
+  auto Cfg = rogue::LevelGeneratorLoader::loadCfg(0, CfgFile, DataDir);
+  std::visit(
+      [&DataDir, &Seen](const auto &C) {
+        using T = std::decay_t<decltype(C)>;
+        if constexpr (std::is_same_v<
+                          T, rogue::CompositeMultiLevelGenerator::Config>) {
+          for (const auto &Lvl : C.Levels) {
+            loadLevelConfig(Lvl.Config, DataDir, Seen);
+          }
+        } else if constexpr (std::is_same_v<
+                                 T, rogue::TiledMapLevelGenerator::Config>) {
+          rogue::loadJSON(C.TiledMapFile, nullptr);
+          rogue::loadJSON(C.TiledIdMapFile, nullptr);
+        }
+      },
+      Cfg);
+}
+
+void loadLevelTable(const rogue::LevelTable &LT,
+                    const std::filesystem::path &DataDir,
+                    std::set<std::filesystem::path> &Seen) {
+  for (const auto &Slot : LT.getSlots()) {
+    // Referenced tables are loaded through the level database itself
+    if (std::dynamic_pointer_cast<rogue::LevelTable>(Slot.LC)) {
+      continue;
+    }
+    loadLevelConfig(Slot.LC->getLevelInfo().LevelConfig, DataDir, Seen);
+  }
+}
+
+int main(int Argc, char *Argv[]) {
+  if (Argc != 2 && Argc != 3) {
+    usage(Argv[0]);
+    return 1;
+  }
+  const std::filesystem::path CfgFile = Argv[1];
+  const std::filesystem::path BundleFile =
+      Argc == 3 ? std::filesystem::path(Argv[2])
+                : CfgFile.parent_path() / rogue::DataBundle::DefaultFileName;
+
+  // Record every file that is loaded and validated by the loaders
+  rogue::DataBundle Bundle(BundleFile.parent_path());
+  rogue::setJSONLoadObserver(
+      [&Bundle](const std::filesystem::path &File, std::string_view Data,
+                const std::filesystem::path *SchemaPath) {
+        Bundle.add(File, compactJSON(Data), SchemaPath);
+      });
+
+  try {
+    const auto Cfg = rogue::GameConfig::load(CfgFile);
+    auto ItemDb = rogue::ItemDatabase::load(Cfg.ItemDbConfig);
+    rogue::EntityDatabase::load(ItemDb, Cfg.EntityDbConfig);
+    rogue::CraftingDatabase::load(ItemDb, Cfg.CraftingDbConfig);
+    const auto LevelDb = rogue::LevelDatabase::load(Cfg.LevelDbConfig);
+
+    const auto DataDir = Cfg.LevelDbConfig.parent_path();
+    std::set<std::filesystem::path> Seen;
+    loadLevelConfig(Cfg.InitialLevelConfig, DataDir, Seen);
+    for (const auto &[Name, LT] : LevelDb.getLevelTables()) {
+      loadLevelTable(*LT, DataDir, Seen);
+    }
+
+    Bundle.write(BundleFile);
+  } catch (const std::exception &E) {
+    std::cerr << "ERROR: " << E.what() << std::endl;
+    return 1;
+  }
+
+  std::cout << "Compiled " << Bundle.size() << " files into " << BundleFile
+            << std::endl;
+  return 0;
+}
@@ -4,6 +4,7 @@
 #include <map>
 #include <rogue/ItemDatabase.h>
 #include <rogue/ItemEffect.h>
+#include <rogue/LootSimulator.h>
 #include <rogue/UI/Item.h>
 #include <string>
 
@@ -13,36 +14,16 @@ std::ostream &subUsage(std::ostream &Out, const char *PrgName) {
 }
 
 void dumpLootTableRewards(const rogue::ItemDatabase &ItemDb,
-                          const std::string &LootTableName, unsigned Rolls) {
+                          const std::string &LootTableName,
+                          std::uint64_t Rolls, unsigned Seed) {
   const auto &LootTable = ItemDb.getLootTable(LootTableName);
 
-  unsigned Total = 0;
-  std::map<int, unsigned> ItemIdCounts;
-  std::map<int, unsigned> ItemIdOccurrences;
-  for (std::size_t I = 0; I < Rolls; I++) {
-    auto LootRewards = LootTable->generateLoot();
-
-    // Count occurrences over all loot rewards, rewards may be duplicates
-    std::set<int> SeenIds;
-    for (auto &LootReward : LootRewards) {
-      ItemIdCounts[LootReward.ItId] += LootReward.Count;
-      if (SeenIds.insert(LootReward.ItId).second) {
-        ItemIdOccurrences[LootReward.ItId]++;
-      }
-      Total += LootReward.Count;
-    }
-  }
-
-  std::vector<std::pair<unsigned, rogue::ItemProtoId>> SortedCounts;
-  for (auto &Pair : ItemIdCounts) {
-    SortedCounts.emplace_back(Pair.second, Pair.first);
-  }
-  std::sort(SortedCounts.begin(), SortedCounts.end(), std::greater<>());
+  rogue::LootSimulator Sim(*LootTable);
+  const auto Result = Sim.run(Rolls, Seed);
 
   std::cout << "{\n'item_rewards': [" << std::endl;
   const char *Pred = "  ", *Suf = "";
-  for (auto &[Count, ItId] : SortedCounts) {
-    auto Occurrences = ItemIdOccurrences.at(ItId);
+  for (const auto &[ItId, Count, Occurrences] : Result.Items) {
     auto PercentagePerDrop = static_cast<double>(Occurrences) / Rolls * 100.0;
     auto CountPerDrop = static_cast<double>(Count) / Occurrences;
     auto AverageCountPerDrop = static_cast<double>(Count) / Rolls;
@@ -61,27 +42,71 @@ void dumpLootTableRewards(const rogue::ItemDatabase &ItemDb,
   std::cout << Suf << "],"
             << "\n";
 
-  std::cout << "'total': " << Total << ", "
+  std::cout << "'total': " << Result.Total << ", "
             << "\n"
             << "'rolls': " << Rolls << "\n"
             << "}" << std::endl;
 }
 
 int handleLootTable(const rogue::ItemDatabase &ItemDb, int Argc, char *Argv[]) {
-  if (Argc != 5 && Argc != 6) {
+  if (Argc < 5 || Argc > 7) {
     subUsage(std::cerr, Argv[0])
-        << "--loot-table <loot_table_name> *<rolls>" << std::endl;
+        << "--loot-table <loot_table_name> *<rolls> *<seed>" << std::endl;
     return 2;
   }
 
   std::string LootTableName = Argv[4];
 
-  unsigned Rolls = 100;
-  if (Argc == 6) {
-    Rolls = std::stoi(Argv[5]);
+  std::uint64_t Rolls = 100;
+  if (Argc >= 6) {
+    Rolls = std::stoull(Argv[5]);
+  }
+
+  unsigned Seed = std::time(nullptr);
+  if (Argc == 7) {
+    Seed = std::stoul(Argv[6]);
+  }
+
+  dumpLootTableRewards(ItemDb, LootTableName, Rolls, Seed);
+
+  return 0;
+}
+
+void dumpLootTableDropRates(const rogue::ItemDatabase &ItemDb,
+                            const std::string &LootTableName) {
+  const auto &Rates = ItemDb.getLootDropRates(LootTableName);
+
+  std::vector<std::pair<rogue::ItemProtoId, rogue::LootDrop>> SortedRates(
+      Rates.begin(), Rates.end());
+  std::stable_sort(SortedRates.begin(), SortedRates.end(),
+                   [](const auto &A, const auto &B) {
+                     return A.second.ExpectedCount > B.second.ExpectedCount;
+                   });
+
+  std::cout << "{\n'item_rewards': [" << std::endl;
+  const char *Pred = "  ", *Suf = "";
+  for (const auto &[ItId, Drop] : SortedRates) {
+    std::cout << std::left << std::fixed << Pred
+              << "{ 'name':" << std::setw(40)
+              << ("'" + ItemDb.getItemProto(ItId).Name + "'")
+              << ", 'pp_drop': " << std::setw(8) << std::setprecision(4)
+              << Drop.Probability * 100.0 << ", 'ac_drop':" << std::setw(8)
+              << std::setprecision(4) << Drop.ExpectedCount << "\n";
+    Pred = "},";
+    Suf = "}";
+  }
+  std::cout << Suf << "]\n"
+            << "}" << std::endl;
+}
+
+int handleExactLootTable(const rogue::ItemDatabase &ItemDb, int Argc,
+                         char *Argv[]) {
+  if (Argc != 5) {
+    subUsage(std::cerr, Argv[0]) << "--exact <loot_table_name>" << std::endl;
+    return 6;
   }
 
-  dumpLootTableRewards(ItemDb, LootTableName, Rolls);
+  dumpLootTableDropRates(ItemDb, Argv[4]);
 
   return 0;
 }
@@ -188,9 +213,13 @@ void dumpUsage(const char *PrgName) {
       << "options:" << std::endl
       << "  --dump-tables                           (Dumps all loot tables)"
       << std::endl
-      << "  --loot-table <loot_table_name> *<rolls> (Generates items for loot "
+      << "  --loot-table <loot_table_name> *<rolls> *<seed>" << std::endl
+      << "                                          (Generates items for loot "
          "table and dumps statistics)"
       << std::endl
+      << "  --exact <loot_table_name>               (Computes the exact drop "
+         "rates for loot table)"
+      << std::endl
       << "  --dump-item <item> *<rolls>             (Creates the specified "
          "items for the given number of rolls and dumps it)"
       << std::endl
@@ -248,6 +277,10 @@ int wrapped_main(int Argc, char *Argv[]) {
     return handleLootTable(ItemDb, Argc, Argv);
   }
 
+  if (Option == "--exact") {
+    return handleExactLootTable(ItemDb, Argc, Argv);
+  }
+
   if (Option == "--dump-item") {
     return handleDumpItem(ItemDb, Argc, Argv);
   }
@@ -156,6 +156,18 @@ public:
   /// @param[in] Cl     - The color to set
   void setColor(int StartX, int EndX, types::TermColor Cl);
 
+  /// Returns a copy of the interval [StartX, StartX + Width), parts outside
+  /// of the row are left blank
+  /// @param[in] StartX - Start of interval (included)
+  /// @param[in] Width  - Width of the interval
+  Row slice(int StartX, std::size_t Width) const;
+
+  /// Copies characters and colors of the given row into this row starting
+  /// at X, parts outside of this row are clipped
+  /// @param[in] X   - The offset to copy the row to
+  /// @param[in] Src - The row to copy
+  void blit(int X, Row const &Src);
+
   /// Dumps the row to given stream
   /// @param[in/out] Out - The output stream to dump the row to
   /// @returns The modified output stream
@@ -160,6 +160,25 @@ void Row::setColor(int StartX, int EndX, types::TermColor Cl) {
   }
 }
 
+Row Row::slice(int StartX, std::size_t Width) const {
+  Row Slice(Width);
+  Slice.blit(-StartX, *this);
+  return Slice;
+}
+
+void Row::blit(int X, Row const &Src) {
+  int Start = ::std::max(X, 0);
+  int End = ::std::min(X + static_cast<int>(Src.Buffer.size()),
+                       static_cast<int>(Buffer.size()));
+  if (End <= Start) {
+    return;
+  }
+  ::std::copy(Src.Buffer.begin() + (Start - X), Src.Buffer.begin() + (End - X),
+              Buffer.begin() + Start);
+  ::std::copy(Src.ColorInfo.begin() + (Start - X),
+              Src.ColorInfo.begin() + (End - X), ColorInfo.begin() + Start);
+}
+
 ::std::ostream &Row::dump(::std::ostream &Out) const {
   types::TermColor LastColor = types::Color::NONE;
 
@@ -84,4 +84,25 @@ TEST(cxxg, Accesses) {
   EXPECT_EQ(SS.str(), Ref.str()) << "RowOutOfRange";
 }
 
+TEST(cxxg, RowSliceAndBlit) {
+  ::cxxg::Row Row(10);
+  Row[2] << ::cxxg::types::Color::RED << "test";
+
+  auto Slice = Row.slice(1, 4);
+  EXPECT_EQ(Slice.getBuffer(), " tes");
+  EXPECT_EQ(Slice.getColorInfo().at(0), ::cxxg::types::Color::NONE);
+  EXPECT_EQ(Slice.getColorInfo().at(1), ::cxxg::types::Color::RED);
+
+  // slicing outside of the row yields blanks
+  EXPECT_EQ(Row.slice(-2, 4).getBuffer(), "    ");
+  EXPECT_EQ(Row.slice(8, 4).getBuffer(), "    ");
+
+  ::cxxg::Row Other(6);
+  Other.blit(3, Slice);
+  EXPECT_EQ(Other.getBuffer(), "    te");
+  EXPECT_EQ(Other.getColorInfo().at(4), ::cxxg::types::Color::RED);
+  Other.blit(-3, Slice);
+  EXPECT_EQ(Other.getBuffer(), "s   te");
+}
+
 } // namespace
@@ -0,0 +1,88 @@
+#include <filesystem>
+#include <fstream>
+#include <gtest/gtest.h>
+#include <rogue/AutoSaver.h>
+#include <sstream>
+
+namespace {
+
+std::string readFile(const std::filesystem::path &Path) {
+  std::ifstream In(Path);
+  std::stringstream SS;
+  SS << In.rdbuf();
+  return SS.str();
+}
+
+rogue::AutoSaver::WriteFn writeText(std::string Text) {
+  return [Text](const rogue::SaveGameInfo &SGI) {
+    std::ofstream Out(SGI.Path);
+    Out << Text;
+  };
+}
+
+class AutoSaverTest : public ::testing::Test {
+public:
+  void SetUp() override {
+    const auto *Info = ::testing::UnitTest::GetInstance()->current_test_info();
+    Dir = std::filesystem::temp_directory_path() /
+          (std::string("rogue_auto_saver_") + Info->name());
+    std::filesystem::remove_all(Dir);
+    std::filesystem::create_directories(Dir);
+  }
+
+  void TearDown() override { std::filesystem::remove_all(Dir); }
+
+  std::filesystem::path Dir;
+};
+
+TEST_F(AutoSaverTest, Cadence) {
+  const auto SGI = rogue::SaveGameInfo::fromPath(Dir / "autosave.bin", false);
+  rogue::AutoSaver AS(SGI, {/*TickInterval=*/3, /*OnLevelChange=*/false});
+  AS.tick();
+  AS.tick();
+  AS.levelChanged();
+  EXPECT_FALSE(AS.isDue());
+  AS.tick();
+  EXPECT_TRUE(AS.isDue());
+
+  AS.submit(writeText("save"));
+  EXPECT_FALSE(AS.isDue());
+  AS.tick();
+  EXPECT_FALSE(AS.isDue());
+}
+
+TEST_F(AutoSaverTest, WriteInBackground) {
+  const auto SGI = rogue::SaveGameInfo::fromPath(Dir / "autosave.bin", false);
+  rogue::AutoSaver AS(SGI, {/*TickInterval=*/0, /*OnLevelChange=*/true});
+  AS.levelChanged();
+  EXPECT_TRUE(AS.isDue());
+
+  AS.submit(writeText("first"));
+  AS.wait();
+  EXPECT_EQ(readFile(SGI.Path), "first");
+  EXPECT_FALSE(AS.takeError());
+
+  // A failing save keeps the previous save game
+  AS.submit([](const rogue::SaveGameInfo &SGI) {
+    std::ofstream Out(SGI.Path);
+    Out << "partial";
+    Out.close();
+    throw std::runtime_error("write failed");
+  });
+  AS.wait();
+  EXPECT_EQ(AS.takeError(), "write failed");
+  EXPECT_FALSE(AS.takeError());
+  EXPECT_EQ(readFile(SGI.Path), "first");
+  EXPECT_FALSE(std::filesystem::exists(SGI.Path.string() + ".tmp"));
+}
+
+TEST_F(AutoSaverTest, FinishPendingOnDestruction) {
+  const auto SGI = rogue::SaveGameInfo::fromPath(Dir / "autosave.bin", false);
+  {
+    rogue::AutoSaver AS(SGI, {});
+    AS.submit(writeText("pending"));
+  }
+  EXPECT_EQ(readFile(SGI.Path), "pending");
+}
+
+} // namespace
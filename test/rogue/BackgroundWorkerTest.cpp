@@ -0,0 +1,48 @@
+#include <gtest/gtest.h>
+#include <rogue/BackgroundWorker.h>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+namespace {
+
+struct ThreadRecorder {
+  std::thread::id *DestroyedOn = nullptr;
+  ~ThreadRecorder() {
+    if (DestroyedOn) {
+      *DestroyedOn = std::this_thread::get_id();
+    }
+  }
+};
+
+TEST(BackgroundWorkerTest, SubmitRunsInOrder) {
+  rogue::BackgroundWorker Worker;
+  std::vector<int> Order;
+  Worker.post([&Order]() { Order.push_back(1); });
+  auto Result = Worker.submit<int>([&Order]() {
+    Order.push_back(2);
+    return 42;
+  });
+  EXPECT_EQ(Result.get(), 42);
+  EXPECT_EQ(Order, std::vector<int>({1, 2}));
+
+  auto Error = Worker.submit<int>([]() -> int {
+    throw std::runtime_error("job failed");
+  });
+  EXPECT_THROW(Error.get(), std::runtime_error);
+}
+
+TEST(BackgroundWorkerTest, DisposeOnWorker) {
+  rogue::BackgroundWorker Worker;
+  std::thread::id DestroyedOn;
+  auto Obj = std::make_unique<ThreadRecorder>();
+  Obj->DestroyedOn = &DestroyedOn;
+  Worker.dispose(std::move(Obj));
+
+  // Jobs run in order, the object is gone once the next job is done
+  Worker.submit<int>([]() { return 0; }).get();
+  EXPECT_NE(DestroyedOn, std::thread::id());
+  EXPECT_NE(DestroyedOn, std::this_thread::get_id());
+}
+
+} // namespace
@@ -0,0 +1,98 @@
+#include <gtest/gtest.h>
+#include <rogue/ChunkedLevel.h>
+#include <rogue/Context.h>
+#include <rogue/CraftingHandler.h>
+#include <rogue/EntityDatabase.h>
+#include <rogue/ItemDatabase.h>
+#include <rogue/Level.h>
+#include <rogue/LevelDatabase.h>
+
+namespace {
+
+class ChunkedLevelTest : public ::testing::Test {
+public:
+  rogue::EventHub EvHub;
+  rogue::ItemDatabase ItemDb;
+  rogue::EntityDatabase EntityDb;
+  rogue::LevelDatabase LevelDb;
+  rogue::CraftingDatabase CraftingDb;
+  rogue::CraftingHandler Crafter{ItemDb};
+  rogue::GameContext Ctx{EvHub, ItemDb, EntityDb, LevelDb, CraftingDb, Crafter};
+  rogue::NoiseChunkGenerator Gen{Ctx, {}};
+};
+
+TEST_F(ChunkedLevelTest, ChunkCoordinates) {
+  rogue::ChunkedLevel CL(Gen, {{8, 4}, 1, 1, 1});
+  EXPECT_EQ(CL.getChunkCoord({0, 0}), ymir::Point2d<int>(0, 0));
+  EXPECT_EQ(CL.getChunkCoord({7, 3}), ymir::Point2d<int>(0, 0));
+  EXPECT_EQ(CL.getChunkCoord({8, 4}), ymir::Point2d<int>(1, 1));
+  EXPECT_EQ(CL.getChunkCoord({-1, -5}), ymir::Point2d<int>(-1, -2));
+  EXPECT_EQ(CL.getChunkRect({-1, -2}).Pos, ymir::Point2d<int>(-8, -8));
+
+  EXPECT_THROW(rogue::ChunkedLevel(Gen, {{8, 4}, 2, 1, 1}), std::out_of_range);
+}
+
+TEST_F(ChunkedLevelTest, LoadAndEvictChunks) {
+  rogue::ChunkedLevel CL(Gen, {{8, 8}, 1, 1, 9});
+  EXPECT_TRUE(CL.update({0, 0}));
+  EXPECT_EQ(CL.getMemoryStats().NumResident, 9);
+  ASSERT_NE(CL.getChunk({1, 1}), nullptr);
+  CL.getChunk({1, 1})->getPlayerSeenMap().getTile({2, 2}) = true;
+
+  // Only the changed chunk is kept as a snapshot
+  EXPECT_TRUE(CL.update({100, 0}));
+  auto Stats = CL.getMemoryStats();
+  EXPECT_EQ(Stats.NumResident, 9);
+  EXPECT_EQ(Stats.NumEvicted, 1);
+  EXPECT_EQ(CL.getChunk({1, 1}), nullptr);
+
+  EXPECT_TRUE(CL.update({0, 0}));
+  ASSERT_NE(CL.getChunk({1, 1}), nullptr);
+  EXPECT_TRUE(CL.getChunk({1, 1})->getPlayerSeenMap().getTile({2, 2}));
+  EXPECT_EQ(CL.getMemoryStats().NumEvicted, 0);
+}
+
+TEST_F(ChunkedLevelTest, BoundedEvictedChunks) {
+  rogue::ChunkedLevel CL(Gen, {{8, 8}, 0, 0, 1, /*MaxEvictedChunks=*/1});
+  CL.update({0, 0});
+  CL.getChunk({0, 0})->getPlayerSeenMap().getTile({2, 2}) = true;
+  CL.update({8, 0});
+  CL.getChunk({1, 0})->getPlayerSeenMap().getTile({2, 2}) = true;
+  EXPECT_EQ(CL.getMemoryStats().NumEvicted, 1);
+
+  // Changes of the chunk farthest from the focus are dropped
+  CL.update({40, 0});
+  EXPECT_EQ(CL.getMemoryStats().NumEvicted, 1);
+  CL.update({8, 0});
+  EXPECT_TRUE(CL.getChunk({1, 0})->getPlayerSeenMap().getTile({2, 2}));
+  CL.update({0, 0});
+  EXPECT_FALSE(CL.getChunk({0, 0})->getPlayerSeenMap().getTile({2, 2}));
+}
+
+TEST_F(ChunkedLevelTest, BoundedWorkPerUpdate) {
+  rogue::ChunkedLevel CL(Gen, {{8, 8}, 1, 2, 3});
+  EXPECT_FALSE(CL.update({0, 0}));
+  EXPECT_EQ(CL.getMemoryStats().NumResident, 4);
+  EXPECT_FALSE(CL.update({0, 0}));
+  EXPECT_TRUE(CL.update({0, 0}));
+  EXPECT_EQ(CL.getMemoryStats().NumResident, 9);
+}
+
+TEST_F(ChunkedLevelTest, MovePlayerBetweenChunks) {
+  rogue::ChunkedLevel CL(Gen, {{8, 8}, 0, 0, 1});
+  CL.createPlayer({1, 1});
+  CL.movePlayer({2, 1});
+  EXPECT_EQ(CL.getPlayerPos(), ymir::Point2d<int>(2, 1));
+
+  CL.movePlayer({-3, 9});
+  EXPECT_EQ(CL.getPlayerPos(), ymir::Point2d<int>(-3, 9));
+  EXPECT_FALSE(CL.getChunk({0, 0})->hasPlayer());
+  EXPECT_TRUE(CL.getChunk({-1, 1})->hasPlayer());
+
+  // The chunk of the player is kept when focusing elsewhere
+  CL.update({100, 100});
+  EXPECT_NE(CL.getChunk({-1, 1}), nullptr);
+  EXPECT_EQ(CL.getChunk({0, 0}), nullptr);
+}
+
+} // namespace
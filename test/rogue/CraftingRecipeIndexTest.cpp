@@ -0,0 +1,56 @@
+#include <gtest/gtest.h>
+#include <rogue/CraftingDatabase.h>
+#include <rogue/CraftingRecipeIndex.h>
+
+namespace {
+
+using CId = rogue::CraftingRecipeId;
+using PId = rogue::ItemProtoId;
+
+class CraftingRecipeIndexTest : public ::testing::Test {
+public:
+  void SetUp() override {
+    Index.addRecipe(CId(0), {"ab", {PId(1), PId(2)}, {PId(10)}});
+    Index.addRecipe(CId(1), {"aab", {PId(1), PId(1), PId(2)}, {PId(11)}});
+    Index.addRecipe(CId(2), {"ba", {PId(2), PId(1)}, {PId(12)}});
+    Index.addRecipe(CId(3), {"cab", {PId(3), PId(1), PId(2)}, {PId(13)}});
+  }
+
+  rogue::CraftingRecipeIndex Index;
+};
+
+TEST_F(CraftingRecipeIndexTest, FindRecipe) {
+  EXPECT_EQ(Index.size(), 4);
+
+  const auto *Result = Index.findRecipe({PId(2), PId(1)});
+  ASSERT_NE(Result, nullptr);
+  EXPECT_EQ(Result->RecipeId, 2);
+  EXPECT_EQ(Result->Items, std::vector<PId>{PId(12)});
+  EXPECT_EQ(Index.findRecipe({PId(1), PId(2), PId(1)}), nullptr);
+  EXPECT_EQ(Index.findRecipe({PId(1)}), nullptr);
+  EXPECT_EQ(Index.findRecipe({}), nullptr);
+
+  EXPECT_EQ(Index.findRecipesAnyOrder({PId(2), PId(1)}),
+            (std::vector<CId>{CId(0), CId(2)}));
+  EXPECT_EQ(Index.findRecipesAnyOrder({PId(1), PId(2), PId(1)}),
+            std::vector<CId>{CId(1)});
+  EXPECT_TRUE(Index.findRecipesAnyOrder({PId(1), PId(3)}).empty());
+
+  EXPECT_THROW(Index.addRecipe(CId(4), {"dup", {PId(1), PId(2)}, {PId(1)}}),
+               std::runtime_error);
+  EXPECT_THROW(Index.addRecipe(CId(4), {"empty", {PId(1), PId(2)}, {}}),
+               std::runtime_error);
+}
+
+TEST_F(CraftingRecipeIndexTest, GetCraftableRecipes) {
+  EXPECT_TRUE(Index.getCraftableRecipes({}).empty());
+  EXPECT_TRUE(Index.getCraftableRecipes({{1, 5}}).empty());
+  EXPECT_EQ(Index.getCraftableRecipes({{1, 1}, {2, 1}, {3, 1}}),
+            (std::vector<CId>{CId(0), CId(2), CId(3)}));
+  EXPECT_EQ(Index.getCraftableRecipes({{1, 2}, {2, 1}, {4, 7}}),
+            (std::vector<CId>{CId(0), CId(1), CId(2)}));
+  EXPECT_EQ(Index.getCraftableRecipes({{1, 2}, {2, 1}, {3, 1}}),
+            (std::vector<CId>{CId(0), CId(1), CId(2), CId(3)}));
+}
+
+} // namespace
@@ -0,0 +1,83 @@
+#include <fstream>
+#include <gtest/gtest.h>
+#include <rogue/DataBundle.h>
+#include <rogue/JSON.h>
+
+namespace {
+
+class DataBundleTest : public ::testing::Test {
+public:
+  void SetUp() override {
+    const auto *Info = ::testing::UnitTest::GetInstance()->current_test_info();
+    Dir = std::filesystem::temp_directory_path() /
+          (std::string("rogue_data_bundle_") + Info->name());
+    std::filesystem::remove_all(Dir);
+    std::filesystem::create_directories(Dir / "levels");
+  }
+
+  void TearDown() override {
+    rogue::DataBundle::setActive(nullptr);
+    std::filesystem::remove_all(Dir);
+  }
+
+  void writeFile(const std::filesystem::path &File, const std::string &Data) {
+    std::ofstream Out(File, std::ios::binary);
+    Out << Data;
+  }
+
+  std::filesystem::path Dir;
+};
+
+TEST_F(DataBundleTest, WriteAndRead) {
+  writeFile(Dir / "a.json", "{ \"a\": 1 }");
+  writeFile(Dir / "b.json", "[ 1, 2 ]");
+
+  rogue::DataBundle Bundle(Dir);
+  Bundle.add(Dir / "a.json", "{\"a\":1}");
+  Bundle.add(Dir / "levels/../b.json", "stale");
+  Bundle.add(Dir / "b.json", "[1,2]");
+  EXPECT_EQ(Bundle.size(), 2);
+  EXPECT_EQ(Bundle.getOrNull(Dir / "b.json"), "[1,2]");
+  EXPECT_FALSE(Bundle.getOrNull(Dir / "c.json"));
+  EXPECT_THROW(Bundle.add(Dir / "c.json", "{}"), std::runtime_error);
+
+  Bundle.write(Dir / "test.bundle");
+
+  auto Read = rogue::DataBundle::read(Dir / "test.bundle");
+  EXPECT_EQ(Read.size(), 2);
+  EXPECT_EQ(Read.getOrNull(Dir / "a.json"), "{\"a\":1}");
+  EXPECT_EQ(Read.getIfCurrent(Dir / "./b.json", nullptr), "[1,2]");
+  EXPECT_FALSE(Read.getOrNull("a.json"));
+
+  EXPECT_THROW(rogue::DataBundle::read(Dir / "a.json"), std::runtime_error);
+}
+
+TEST_F(DataBundleTest, LoadJSONFromActiveBundle) {
+  const auto File = Dir / "value.json";
+  const auto Schema = Dir / "schema.json";
+  const auto OtherSchema = Dir / "other_schema.json";
+  writeFile(File, "{\"value\": 1}");
+  writeFile(Schema, "{\"type\": \"object\"}");
+  writeFile(OtherSchema, "{\"type\": \"object\"}");
+
+  // Bundled data differs from the file to tell where it was loaded from
+  auto Bundle = std::make_shared<rogue::DataBundle>(Dir);
+  Bundle->add(File, "{\"value\":42}", &Schema);
+  rogue::DataBundle::setActive(Bundle);
+
+  auto [Buf1, Doc1] = rogue::loadJSON(File, &Schema);
+  EXPECT_EQ(Doc1["value"].GetInt(), 42);
+  auto [Buf2, Doc2] = rogue::loadJSON(File, nullptr);
+  EXPECT_EQ(Doc2["value"].GetInt(), 42);
+
+  // Data validated against a different schema is loaded from disk
+  auto [Buf3, Doc3] = rogue::loadJSON(File, &OtherSchema);
+  EXPECT_EQ(Doc3["value"].GetInt(), 1);
+
+  // Changed files are loaded from disk
+  writeFile(File, "{\"value\": 123}");
+  auto [Buf4, Doc4] = rogue::loadJSON(File, &Schema);
+  EXPECT_EQ(Doc4["value"].GetInt(), 123);
+}
+
+} // namespace
\ No newline at end of file
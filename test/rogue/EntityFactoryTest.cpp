@@ -1,6 +1,7 @@
 #include <fstream>
 #include <gtest/gtest.h>
 #include <rogue/Components/Transform.h>
+#include <rogue/Components/Visual.h>
 #include <rogue/EntityDatabase.h>
 #include <rogue/ItemDatabase.h>
 
@@ -61,4 +62,40 @@ TEST_F(EntityFactoryTest, CreateEntity) {
   EXPECT_TRUE(Reg.any_of<rogue::CollisionComp>(Entity));
 }
 
-} // namespace
\ No newline at end of file
+TEST_F(EntityFactoryTest, CreateEntities) {
+  loadDbJson(R"(
+    {
+      "entity_templates": [
+        {
+          "name": "foo",
+          "display_name": "disp_foo",
+          "description": "desc_foo",
+          "assemblers": {
+            "collision": true,
+            "position": true
+          }
+        }
+      ]
+    }
+  )");
+
+  rogue::EntityFactory Factory(Reg, Db);
+  const auto Id = Db.getEntityTemplateId("foo");
+  EXPECT_TRUE(Factory.createEntities(Id, 0).empty());
+
+  const std::vector<ymir::Point2d<int>> Positions = {{1, 2}, {3, 4}, {5, 6}};
+  auto Entities = Factory.createEntities(Id, Positions);
+  ASSERT_EQ(Entities.size(), Positions.size());
+  for (std::size_t Idx = 0; Idx < Entities.size(); ++Idx) {
+    EXPECT_TRUE(Reg.valid(Entities[Idx]));
+    EXPECT_TRUE(Reg.any_of<rogue::CollisionComp>(Entities[Idx]));
+    EXPECT_EQ(Reg.get<rogue::PositionComp>(Entities[Idx]).Pos,
+              Positions[Idx]);
+    EXPECT_EQ(Reg.get<rogue::NameComp>(Entities[Idx]).Name, "disp_foo");
+  }
+
+  EXPECT_THROW(Factory.createEntities(rogue::EntityTemplateId(1), 2),
+               std::out_of_range);
+}
+
+} // namespace
@@ -33,6 +33,13 @@ public:
   std::string Msg;
 };
 
+class DummyImmediateEvent : public rogue::BaseEvent {
+public:
+  static constexpr bool Immediate = true;
+  explicit DummyImmediateEvent(int Value) : Value(Value) {}
+  int Value = 0;
+};
+
 class EventListener {
 public:
   virtual void onDummyEventA(const DummyEventA &) = 0;
@@ -45,6 +52,26 @@ public:
   MOCK_METHOD(void, onDummyEventB, (const DummyEventB &B), (final));
 };
 
+class EventRecorder {
+public:
+  void onDummyEventA(const DummyEventA &A) {
+    Log.push_back("A" + std::to_string(A.Value));
+  }
+  void onDummyEventB(const DummyEventB &B) { Log.push_back("B" + B.Msg); }
+  void onDummyImmediateEvent(const DummyImmediateEvent &I) {
+    Log.push_back("I" + std::to_string(I.Value));
+  }
+  void onDummyEventABatch(const rogue::EventBatch<DummyEventA> &Batch) {
+    BatchSizes.push_back(Batch.size());
+    for (const auto &A : Batch) {
+      Log.push_back("A" + std::to_string(A.Value));
+    }
+  }
+
+  std::vector<std::string> Log;
+  std::vector<std::size_t> BatchSizes;
+};
+
 class DummyEntity : public rogue::EventHubConnector {
 public:
   void setEventHub(rogue::EventHub *Hub) {
@@ -129,4 +156,93 @@ TEST(EventHub, EventHubConnectorUnsubscribe) {
   DE.doSth("asdf");
 }
 
+TEST(EventHub, QueueScopeWithoutQueueEnabledDispatchesImmediately) {
+  rogue::EventHub EH;
+  EventRecorder Rec;
+  EH.subscribe(Rec, &EventRecorder::onDummyEventA);
+
+  rogue::EventHub::QueueScope Scope(&EH);
+  EH.publish(DummyEventA(1));
+  EXPECT_EQ(Rec.Log, std::vector<std::string>({"A1"}));
+}
+
+TEST(EventHub, QueuedEventsDispatchedAtEndOfScope) {
+  rogue::EventHub EH;
+  EH.setQueueEnabled(true);
+  EventRecorder Rec;
+  EH.subscribe(Rec, &EventRecorder::onDummyEventA);
+  EH.subscribe(Rec, &EventRecorder::onDummyEventB);
+  EH.subscribe(Rec, &EventRecorder::onDummyImmediateEvent);
+
+  {
+    rogue::EventHub::QueueScope Scope(&EH);
+    EH.publish(DummyEventB("x"));
+    EH.publish(DummyEventA(1));
+    EH.publish(DummyImmediateEvent(2));
+    EH.publish(DummyEventB("y"));
+    {
+      // Nested scopes only flush with the outermost one
+      rogue::EventHub::QueueScope Nested(&EH);
+      EH.publish(DummyEventA(3));
+    }
+    EXPECT_EQ(Rec.Log, std::vector<std::string>({"I2"}));
+  }
+
+  // Grouped by type in order of first publication
+  EXPECT_EQ(Rec.Log,
+            std::vector<std::string>({"I2", "Bx", "By", "A1", "A3"}));
+}
+
+TEST(EventHub, BatchSubscriber) {
+  rogue::EventHub EH;
+  EventRecorder Rec;
+  EH.subscribeBatch(Rec, &EventRecorder::onDummyEventABatch);
+
+  // Synchronous mode delivers batches of single events
+  EH.publish(DummyEventA(1));
+  EXPECT_EQ(Rec.BatchSizes, std::vector<std::size_t>({1}));
+
+  EH.setQueueEnabled(true);
+  {
+    rogue::EventHub::QueueScope Scope(&EH);
+    EH.publish(DummyEventA(2));
+    EH.publish(DummyEventA(3));
+    EH.publish(DummyEventA(4));
+  }
+  EXPECT_EQ(Rec.BatchSizes, std::vector<std::size_t>({1, 3}));
+  EXPECT_EQ(Rec.Log, std::vector<std::string>({"A1", "A2", "A3", "A4"}));
+}
+
+TEST(EventHub, PublishFromQueuedHandler) {
+  rogue::EventHub EH;
+  EH.setQueueEnabled(true);
+
+  DummyEntity DE;
+  DE.setEventHub(&EH);
+
+  EventListenerMock Listener;
+  EH.subscribe(Listener, &EventListenerMock::onDummyEventB);
+  EXPECT_CALL(Listener, onDummyEventB(DummyEventB("4"))).Times(1);
+  EXPECT_CALL(Listener, onDummyEventB(DummyEventB("9"))).Times(1);
+
+  rogue::EventHub::QueueScope Scope(&EH);
+  DE.publish(DummyEventA(2));
+  DE.publish(DummyEventA(3));
+}
+
+TEST(EventHub, DisableQueueFlushes) {
+  rogue::EventHub EH;
+  EH.setQueueEnabled(true);
+  EventRecorder Rec;
+  EH.subscribe(Rec, &EventRecorder::onDummyEventA);
+
+  rogue::EventHub::QueueScope Scope(&EH);
+  EH.publish(DummyEventA(1));
+  EXPECT_TRUE(Rec.Log.empty());
+  EH.setQueueEnabled(false);
+  EXPECT_EQ(Rec.Log, std::vector<std::string>({"A1"}));
+  EH.publish(DummyEventA(2));
+  EXPECT_EQ(Rec.Log, std::vector<std::string>({"A1", "A2"}));
+}
+
 } // namespace
@@ -1,4 +1,8 @@
+#include <filesystem>
 #include <gtest/gtest.h>
+#include <rogue/Components/Entity.h>
+#include <rogue/Components/Items.h>
+#include <rogue/Components/Transform.h>
 #include <rogue/Context.h>
 #include <rogue/CraftingHandler.h>
 #include <rogue/EntityDatabase.h>
@@ -7,6 +11,7 @@
 #include <rogue/Level.h>
 #include <rogue/LevelDatabase.h>
 #include <rogue/LevelGenerator.h>
+#include <rogue/SaveGame.h>
 
 namespace {
 
@@ -19,8 +24,17 @@ public:
     LevelDb = rogue::LevelDatabase();
     CraftingDb = rogue::CraftingDatabase();
     Crafter = rogue::CraftingHandler(ItemDb);
+
+    const auto *Info = ::testing::UnitTest::GetInstance()->current_test_info();
+    Dir = std::filesystem::temp_directory_path() /
+          (std::string("rogue_game_world_") + Info->name());
+    std::filesystem::remove_all(Dir);
+    std::filesystem::create_directories(Dir);
   }
 
+  void TearDown() override { std::filesystem::remove_all(Dir); }
+
+  std::filesystem::path Dir;
   rogue::EventHub EvHub;
   rogue::ItemDatabase ItemDb;
   rogue::EntityDatabase EntityDb;
@@ -64,4 +78,151 @@ TEST_F(GameWorldTest, MultiLevelDungeonSwitchLevel) {
   EXPECT_EQ(MLD.getCurrentLevelIdx(), 1);
 }
 
-} // namespace
\ No newline at end of file
+TEST_F(GameWorldTest, MultiLevelDungeonPrefetchLevel) {
+  rogue::EmptyLevelGenerator LvlGen(Ctx, "", {{1, 1}});
+  rogue::MultiLevelDungeon MLD(LvlGen);
+
+  // Prefetching before the first switch prepares the first level
+  MLD.prefetch(0);
+  MLD.switchLevel(0, true);
+  EXPECT_EQ(MLD.getCurrentLevelOrFail().getLevelId(), 0);
+
+  MLD.prefetch(0);
+  MLD.switchLevel(1, true);
+  EXPECT_EQ(MLD.getCurrentLevelOrFail().getLevelId(), 1);
+}
+
+TEST_F(GameWorldTest, MultiLevelDungeonHibernateLevels) {
+  rogue::EmptyLevelGenerator LvlGen(Ctx, "", {{4, 4}});
+  rogue::MultiLevelDungeon MLD(LvlGen);
+  MLD.setHibernationConfig(
+      {/*Enabled=*/true, /*KeepDistance=*/1, /*MaxResidentBytes=*/0});
+
+  MLD.switchLevel(0, true);
+  MLD.getCurrentLevelOrFail().revealMap();
+  MLD.switchLevel(1, true);
+  MLD.switchLevel(2, true);
+
+  auto Stats = MLD.getMemoryStats();
+  EXPECT_EQ(Stats.NumResident, 2);
+  EXPECT_EQ(Stats.NumHibernated, 1);
+  EXPECT_GT(Stats.HibernatedBytes, 0);
+
+  // Returning restores the level from its snapshot
+  MLD.switchLevel(0, true);
+  const auto &Lvl = MLD.getCurrentLevelOrFail();
+  EXPECT_EQ(Lvl.getLevelId(), 0);
+  EXPECT_TRUE(Lvl.getPlayerSeenMap().getTile({3, 3}));
+  Stats = MLD.getMemoryStats();
+  EXPECT_EQ(Stats.NumResident, 2);
+  EXPECT_EQ(Stats.NumHibernated, 1);
+}
+
+TEST_F(GameWorldTest, MultiLevelDungeonHibernationDisabledByDefault) {
+  rogue::EmptyLevelGenerator LvlGen(Ctx, "", {{4, 4}});
+  rogue::MultiLevelDungeon MLD(LvlGen);
+  EXPECT_FALSE(MLD.getHibernationConfig().Enabled);
+
+  MLD.switchLevel(0, true);
+  MLD.switchLevel(1, true);
+  MLD.switchLevel(2, true);
+  MLD.switchLevel(3, true);
+  const auto Stats = MLD.getMemoryStats();
+  EXPECT_EQ(Stats.NumResident, 4);
+  EXPECT_EQ(Stats.NumHibernated, 0);
+}
+
+TEST_F(GameWorldTest, MultiLevelDungeonHibernateDroppedItems) {
+  const auto ItemId = ItemDb.getNewItemId();
+  ItemDb.addItemProto(rogue::ItemPrototype(ItemId, "coin", "desc",
+                                           rogue::ItemType::Crafting, 100, {}));
+
+  rogue::EmptyLevelGenerator LvlGen(Ctx, "", {{4, 4}});
+  rogue::MultiLevelDungeon MLD(LvlGen);
+  MLD.setHibernationConfig(
+      {/*Enabled=*/true, /*KeepDistance=*/1, /*MaxResidentBytes=*/0});
+
+  MLD.switchLevel(0, true);
+  rogue::Inventory Inv;
+  Inv.addItem(rogue::Item(ItemDb.getItemProto(ItemId), 3));
+  rogue::createDropEntity(MLD.getCurrentLevelOrFail().Reg, {2, 1}, Inv);
+  MLD.switchLevel(1, true);
+  MLD.switchLevel(2, true);
+  EXPECT_EQ(MLD.getMemoryStats().NumHibernated, 1);
+
+  // The drop is recreated when waking the level
+  auto &Lvl = MLD.switchLevel(0, true);
+  std::vector<entt::entity> Drops;
+  Lvl.Reg.view<const rogue::PositionComp, const rogue::InventoryComp>().each(
+      [&Lvl, &Drops](auto Et, const auto &, const auto &) {
+        if (Lvl.Reg.all_of<rogue::DropComp>(Et)) {
+          Drops.push_back(Et);
+        }
+      });
+  ASSERT_EQ(Drops.size(), 1);
+  EXPECT_EQ(Lvl.Reg.get<rogue::PositionComp>(Drops.at(0)).Pos,
+            ymir::Point2d<int>(2, 1));
+  const auto &Items = Lvl.Reg.get<rogue::InventoryComp>(Drops.at(0)).Inv;
+  ASSERT_EQ(Items.size(), 1);
+  EXPECT_EQ(Items.getItems().at(0).getId(), ItemId);
+  EXPECT_EQ(Items.getItems().at(0).StackSize, 3);
+
+  // Entities other than drops created after generation are not part of the
+  // snapshot, the level is kept resident
+  const auto Et = Lvl.Reg.create();
+  Lvl.Reg.emplace<rogue::PositionComp>(Et, ymir::Point2d<int>(1, 1));
+  MLD.switchLevel(1, true);
+  MLD.switchLevel(2, true);
+  const auto Stats = MLD.getMemoryStats();
+  EXPECT_EQ(Stats.NumResident, 3);
+  EXPECT_EQ(Stats.NumHibernated, 0);
+  EXPECT_TRUE(MLD.switchLevel(0, true).Reg.valid(Et));
+}
+
+TEST_F(GameWorldTest, MultiLevelDungeonSaveGame) {
+  rogue::EmptyLevelGenerator LvlGen(Ctx, "", {{4, 4}});
+  rogue::MultiLevelDungeon MLD(LvlGen);
+  MLD.switchLevel(0, true);
+  MLD.getCurrentLevelOrFail().revealMap();
+  MLD.switchLevel(1, true);
+  MLD.getCurrentLevelOrFail().createPlayer({2, 3});
+
+  const auto SGI = rogue::SaveGameInfo::fromPath(Dir / "mld.bin", false);
+  MLD.storeSaveGame(SGI);
+
+  // Levels are regenerated from the seed of the save game
+  rogue::MultiLevelDungeon Other(LvlGen, 42);
+  EXPECT_EQ(Other.readSaveGameSeed(SGI), 0u);
+  EXPECT_THROW(Other.loadSaveGame(SGI), std::runtime_error);
+
+  rogue::MultiLevelDungeon Loaded(LvlGen);
+  Loaded.loadSaveGame(SGI);
+  EXPECT_EQ(Loaded.getCurrentLevelIdx(), 1);
+  auto &Lvl = Loaded.getCurrentLevelOrFail();
+  ASSERT_TRUE(Lvl.hasPlayer());
+  EXPECT_EQ(Lvl.Reg.get<rogue::PositionComp>(Lvl.getPlayer()).Pos,
+            ymir::Point2d<int>(2, 3));
+
+  // Other levels are restored once visited
+  Lvl.removePlayer();
+  auto Stats = Loaded.getMemoryStats();
+  EXPECT_EQ(Stats.NumResident, 1);
+  EXPECT_EQ(Stats.NumHibernated, 1);
+  EXPECT_TRUE(Loaded.switchLevel(0, true).getPlayerSeenMap().getTile({3, 3}));
+
+  // Levels that were not visited since loading are carried over when saving
+  // to the file the game was loaded from
+  rogue::MultiLevelDungeon Resaved(LvlGen);
+  Resaved.loadSaveGame(SGI);
+  Resaved.storeSaveGame(SGI);
+  rogue::MultiLevelDungeon Reloaded(LvlGen);
+  Reloaded.loadSaveGame(SGI);
+  Reloaded.getCurrentLevelOrFail().removePlayer();
+  EXPECT_TRUE(
+      Reloaded.switchLevel(0, true).getPlayerSeenMap().getTile({3, 3}));
+
+  const auto JsonSGI = rogue::SaveGameInfo::fromPath(Dir / "mld.json", true);
+  EXPECT_THROW(Loaded.storeSaveGame(JsonSGI), std::runtime_error);
+}
+
+} // namespace
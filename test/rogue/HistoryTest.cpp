@@ -0,0 +1,107 @@
+#include <cxxg/Game.h>
+#include <gtest/gtest.h>
+#include <rogue/History.h>
+#include <sstream>
+
+namespace {
+
+class DummyGame : public cxxg::Game {
+public:
+  using cxxg::Game::Game;
+  bool handleInput(int) final { return false; }
+};
+
+class HistoryTest : public ::testing::Test {
+public:
+  std::string getText(const rogue::History &Hist, std::size_t Idx) {
+    return Hist.getMessage(Idx).Text;
+  }
+
+  std::stringstream SS;
+  cxxg::Screen Scr{cxxg::types::Size{40, 5}, SS, false};
+  DummyGame G{Scr};
+};
+
+TEST(HistoryMessage, CreateAndGetRow) {
+  cxxg::Row Rw(40);
+  Rw[0] << cxxg::types::Color::RED << "hello" << cxxg::types::Color::NONE
+        << " world " << cxxg::types::RgbColor{1, 2, 3} << "x";
+
+  auto Msg = rogue::History::Message::create(Rw);
+  EXPECT_EQ(Msg.Text, "hello world x");
+  EXPECT_EQ(Msg.Colors.size(), 3);
+  EXPECT_EQ(Msg.getRow(40), Rw);
+}
+
+TEST(HistoryMessage, IsSameAs) {
+  cxxg::Row RwA(40);
+  RwA[0] << cxxg::types::Color::RED << "hello";
+  cxxg::Row RwB(20);
+  RwB[0] << cxxg::types::Color::RED << "hello";
+  cxxg::Row RwC(40);
+  RwC[0] << cxxg::types::Color::GREEN << "hello";
+
+  auto MsgA = rogue::History::Message::create(RwA);
+  auto MsgB = rogue::History::Message::create(RwB);
+  auto MsgC = rogue::History::Message::create(RwC);
+  EXPECT_TRUE(MsgA.isSameAs(MsgB));
+  EXPECT_FALSE(MsgA.isSameAs(MsgC));
+}
+
+TEST_F(HistoryTest, EvictOldestMessages) {
+  rogue::History Hist(G, /*MaxMessages=*/3);
+  EXPECT_EQ(Hist.getNumMessages(), 0);
+  EXPECT_THROW(Hist.getMessage(0), std::out_of_range);
+
+  Hist.info() << "a";
+  Hist.info() << "b";
+  Hist.info() << "c";
+  ASSERT_EQ(Hist.getNumMessages(), 3);
+  EXPECT_EQ(getText(Hist, 0), "a");
+  EXPECT_EQ(getText(Hist, 2), "c");
+
+  Hist.info() << "d";
+  ASSERT_EQ(Hist.getNumMessages(), 3);
+  EXPECT_EQ(getText(Hist, 0), "b");
+  EXPECT_EQ(getText(Hist, 1), "c");
+  EXPECT_EQ(getText(Hist, 2), "d");
+  EXPECT_THROW(Hist.getMessage(3), std::out_of_range);
+}
+
+TEST_F(HistoryTest, DedupeRepeatedMessages) {
+  rogue::History Hist(G, /*MaxMessages=*/3);
+  Hist.info() << "a";
+  Hist.info() << "a";
+  Hist.info() << "a";
+  ASSERT_EQ(Hist.getNumMessages(), 1);
+  EXPECT_EQ(Hist.getMessage(0).Count, 3);
+
+  // Only the last message is deduplicated
+  Hist.info() << "b";
+  Hist.info() << "a";
+  ASSERT_EQ(Hist.getNumMessages(), 3);
+  EXPECT_EQ(Hist.getMessage(0).Count, 3);
+  EXPECT_EQ(Hist.getMessage(1).Count, 1);
+  EXPECT_EQ(Hist.getMessage(2).Count, 1);
+}
+
+TEST_F(HistoryTest, OrderAfterWrapAround) {
+  rogue::History Hist(G, /*MaxMessages=*/3);
+  for (int Idx = 0; Idx < 8; ++Idx) {
+    Hist.info() << std::to_string(Idx);
+  }
+
+  // Repeating the newest message after wrapping around still deduplicates
+  Hist.info() << "7";
+  ASSERT_EQ(Hist.getNumMessages(), 3);
+  EXPECT_EQ(getText(Hist, 0), "5");
+  EXPECT_EQ(getText(Hist, 1), "6");
+  EXPECT_EQ(getText(Hist, 2), "7");
+  EXPECT_EQ(Hist.getMessage(2).Count, 2);
+
+  Hist.info() << "8";
+  EXPECT_EQ(getText(Hist, 0), "6");
+  EXPECT_EQ(getText(Hist, 2), "8");
+}
+
+} // namespace
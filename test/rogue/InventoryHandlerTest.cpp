@@ -459,6 +459,7 @@ TEST_F(InventoryHandlerTest, CanCraft) {
   auto Recipe = rogue::CraftingRecipe(
       "dummy", {DummyItems.CraftingA.ItemId, DummyItems.CraftingB.ItemId},
       {DummyItems.CraftingC.ItemId});
+  Crafter.addRecipe(CId(0), Recipe);
 
   EXPECT_FALSE(InvHandler.canCraft(Recipe))
       << "Expect not to be able to craft if there is no inventory";
@@ -473,10 +474,14 @@ TEST_F(InventoryHandlerTest, CanCraft) {
       << "Expect not to be able to craft if the inventory is missing required "
          "items";
 
+  EXPECT_TRUE(InvHandler.getCraftableRecipes().empty());
+
   Inv.addItem(rogue::Item(DummyItems.CraftingB));
 
   EXPECT_TRUE(InvHandler.canCraft(Recipe))
       << "Expect to be able to craft if the inventory has all required items";
+  EXPECT_EQ(InvHandler.getCraftableRecipes(),
+            std::vector<rogue::CraftingRecipeId>{CId(0)});
 }
 
 TEST_F(InventoryHandlerTest, TryCraft) {
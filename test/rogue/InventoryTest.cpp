@@ -122,6 +122,79 @@ TEST(InventoryTest, HasItem) {
   EXPECT_TRUE(Inv.hasItem(1, 10));
 }
 
+TEST(InventoryTest, ItemCountAndSlotHandles) {
+  const rogue::ItemPrototype Other(PId(2), "other", "desc",
+                                   rogue::ItemType::Consumable, 5, {});
+  rogue::Inventory Inv;
+  Inv.addItem(rogue::Item(DummyConsumable, 7));
+  Inv.addItem(rogue::Item(Other, 1));
+  ASSERT_EQ(Inv.size(), 3) << Inv;
+  EXPECT_EQ(Inv.getItemCount(1), 7);
+  EXPECT_EQ(Inv.getItemCount(2), 1);
+  EXPECT_EQ(Inv.getItemCount(3), 0);
+
+  const auto OtherHandle = Inv.getSlotHandle(2);
+  EXPECT_EQ(Inv.takeItem(0).StackSize, 5);
+  EXPECT_EQ(Inv.getItemCount(1), 2);
+  EXPECT_EQ(Inv.getItemIndex(OtherHandle), 1);
+  EXPECT_EQ(Inv.getItemIndexForId(2), 1);
+
+  Inv.takeItem(1);
+  EXPECT_EQ(Inv.getItemIndex(OtherHandle), std::nullopt);
+  EXPECT_EQ(Inv.getItemIndexForId(2), std::nullopt);
+  EXPECT_FALSE(Inv.hasItem(2));
+}
+
+TEST(InventoryTest, TakeItemsById) {
+  const rogue::ItemPrototype Other(PId(2), "other", "desc",
+                                   rogue::ItemType::Consumable, 5, {});
+  rogue::Inventory Inv;
+  Inv.addItems({rogue::Item(DummyConsumable, 6), rogue::Item(Other, 1)});
+  ASSERT_EQ(Inv.size(), 3) << Inv;
+
+  EXPECT_FALSE(Inv.takeItemsById({PId(2), PId(2)}));
+  EXPECT_EQ(Inv.size(), 3);
+
+  auto Taken = Inv.takeItemsById({PId(1), PId(2), PId(1)});
+  ASSERT_TRUE(Taken);
+  ASSERT_EQ(Taken->size(), 3);
+  EXPECT_EQ(Taken->at(1).getId(), 2);
+  EXPECT_EQ(Taken->at(2).StackSize, 1);
+
+  // The emptied stack of the other item is removed
+  ASSERT_EQ(Inv.size(), 2) << Inv;
+  EXPECT_EQ(Inv.getItem(0).StackSize, 3);
+  EXPECT_EQ(Inv.getItem(1).StackSize, 1);
+  EXPECT_EQ(Inv.getItemCount(1), 4);
+  EXPECT_EQ(Inv.getItemCount(2), 0);
+}
+
+TEST(InventoryTest, RevisionChangesWithItems) {
+  rogue::Inventory Inv;
+  auto Revision = Inv.getRevision();
+  const auto ExpectChanged = [&Inv, &Revision]() {
+    EXPECT_NE(Inv.getRevision(), Revision);
+    Revision = Inv.getRevision();
+  };
+
+  Inv.addItem(rogue::Item(DummyConsumable, 3));
+  ExpectChanged();
+  Inv.takeItem(0, 1);
+  ExpectChanged();
+  EXPECT_FALSE(Inv.takeItemsById({PId(2)}));
+  EXPECT_EQ(Inv.getRevision(), Revision);
+  EXPECT_TRUE(Inv.takeItemsById({PId(1)}));
+  ExpectChanged();
+  Inv.takeItem(0);
+  ExpectChanged();
+  Inv.clear();
+  ExpectChanged();
+
+  // Reading the inventory does not change it
+  EXPECT_FALSE(Inv.hasItem(1));
+  EXPECT_EQ(Inv.getRevision(), Revision);
+}
+
 TEST(InventoryTest, ApplyItemToUseConsumable) {
   rogue::Item It(DummyConsumable);
   entt::registry Reg;
@@ -21,4 +21,23 @@ TEST(ItemDatabaseTest, AddLootTable) {
   EXPECT_THROW(Db.addLootTable("foo"), std::out_of_range);
 }
 
-} // namespace
\ No newline at end of file
+TEST(ItemDatabaseTest, LootDropRatesAreMemoized) {
+  rogue::ItemDatabase Db;
+  Db.addLootTable("foo").reset(
+      1, {{std::make_shared<rogue::LootItem>(PId(1), 2, 4), 1}});
+  EXPECT_THROW(Db.getLootDropRates("bar"), std::out_of_range);
+
+  const auto &Rates = Db.getLootDropRates("foo");
+  ASSERT_EQ(Rates.size(), 1);
+  EXPECT_DOUBLE_EQ(Rates.at(PId(1)).Probability, 1.0);
+  EXPECT_DOUBLE_EQ(Rates.at(PId(1)).ExpectedCount, 3.0);
+  EXPECT_EQ(&Db.getLootDropRates("foo"), &Rates);
+
+  // Adding a table drops the memoized rates
+  Db.addLootTable("bar").reset(
+      1, {{std::make_shared<rogue::LootItem>(PId(2), 1, 1), 1}});
+  EXPECT_EQ(Db.getLootDropRates("foo").size(), 1);
+  EXPECT_EQ(Db.getLootDropRates("bar").size(), 1);
+}
+
+} // namespace
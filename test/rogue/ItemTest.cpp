@@ -42,6 +42,10 @@ TEST_F(ItemTest, Properties) {
   EXPECT_EQ(Item.getAllEffects().size(), 0);
   EXPECT_EQ(Item.getCapabilityFlags(), rogue::CapabilityFlags::None);
   EXPECT_FALSE(Item.hasEffect(rogue::CapabilityFlags::UseOn, true));
+
+  // Qualifier names are interned
+  EXPECT_EQ(Item.getQualifierName(), "Test Item");
+  EXPECT_EQ(&rogue::Item(Proto).getQualifierName(), &Item.getQualifierName());
 }
 
 TEST_F(ItemTest, HasEffect) {
@@ -94,12 +98,39 @@ TEST_F(ItemTest, Specialization) {
   EXPECT_EQ(Item.getType(), rogue::ItemType::Ring);
   EXPECT_EQ(Item.getMaxStackSize(), 1);
   EXPECT_EQ(Item.getAllEffects().size(), 2);
+  EXPECT_EQ(&rogue::Item(Item).getAllEffects(), &Item.getAllEffects());
   EXPECT_EQ(Item.getCapabilityFlags(),
             rogue::CapabilityFlags::Equipment | rogue::CapabilityFlags::UseOn);
   EXPECT_TRUE(Item.hasEffect(rogue::CapabilityFlags::Equipment, true));
   EXPECT_TRUE(Item.hasEffect(rogue::CapabilityFlags::UseOn, true));
 }
 
+TEST_F(ItemTest, EffectIndex) {
+  using CF = rogue::CapabilityFlags;
+  rogue::ItemPrototype Proto(
+      PId(1), "Test Item", "Test Description", rogue::ItemType::Ring, 1,
+      {{{CF::Equipment}, rogue::test::DummyItems::NullEffect},
+       {{CF::UseOn | CF::Ranged}, rogue::test::DummyItems::HealEffect},
+       {{CF::UseOn | CF::Self}, rogue::test::DummyItems::DamageEffect}});
+  rogue::Item Item(Proto);
+
+  EXPECT_EQ(Item.getCapabilityFlags(),
+            CF::Equipment | CF::UseOn | CF::Ranged | CF::Self);
+  EXPECT_FALSE(Item.hasEffect(CF::Equipment));
+  EXPECT_TRUE(Item.hasEffect(CF::Equipment, /*AllowNull=*/true));
+  EXPECT_TRUE(Item.hasEffect(CF::UseOn | CF::Ranged));
+  EXPECT_FALSE(Item.hasEffect(CF::Ranged | CF::Self));
+  EXPECT_FALSE(Item.hasEffect(CF::Skill, true, true));
+
+  std::vector<const rogue::ItemEffect *> Effects;
+  Item.forEachEffect(CF::UseOn, [&Effects](const auto &Info) {
+    Effects.push_back(Info.Effect.get());
+  });
+  ASSERT_EQ(Effects.size(), 2);
+  EXPECT_EQ(Effects.at(0), rogue::test::DummyItems::HealEffect.get());
+  EXPECT_EQ(Effects.at(1), rogue::test::DummyItems::DamageEffect.get());
+}
+
 TEST_F(ItemTest, SpecializationOverrides) {
   rogue::ItemPrototype Proto(
       PId(1), "Test Item", "Test Description", rogue::ItemType::Ring, 1,
@@ -0,0 +1,93 @@
+#include <fstream>
+#include <gtest/gtest.h>
+#include <rogue/JSON.h>
+
+namespace {
+
+class JSONTest : public ::testing::Test {
+public:
+  void SetUp() override {
+    const auto *Info = ::testing::UnitTest::GetInstance()->current_test_info();
+    Dir = std::filesystem::temp_directory_path() /
+          (std::string("rogue_json_") + Info->name());
+    std::filesystem::remove_all(Dir);
+    std::filesystem::create_directories(Dir);
+  }
+
+  void TearDown() override {
+    rogue::setJSONValidationMode(rogue::JSONValidationMode::SkipValidated);
+    rogue::clearJSONSchemaCache();
+    std::filesystem::remove_all(Dir);
+  }
+
+  void writeFile(const std::filesystem::path &File,
+                 const std::string &Content) {
+    std::ofstream Out(File, std::ios::binary);
+    if (!Out.is_open()) {
+      throw std::runtime_error("Failed to open file " + File.string());
+    }
+    Out << Content;
+  }
+
+  std::filesystem::path Dir;
+};
+
+TEST_F(JSONTest, LoadInsitu) {
+  writeFile(Dir / "doc.json", R"({"name": "foo", "values": [1, 2]})");
+  auto [Buffer, Doc] = rogue::loadJSON(Dir / "doc.json", nullptr);
+  EXPECT_EQ(std::string(Doc["name"].GetString()), "foo");
+  EXPECT_EQ(Doc["values"].GetArray().Size(), 2);
+  EXPECT_THROW(rogue::loadJSON(Dir / "missing.json", nullptr),
+               std::runtime_error);
+}
+
+TEST_F(JSONTest, CachedSchemaValidation) {
+  const auto Schema = Dir / "schema.json";
+  writeFile(Schema, R"({"type": "object", "required": ["a"]})");
+  writeFile(Dir / "valid.json", R"({"a": 1})");
+  writeFile(Dir / "invalid.json", R"({"b": 1})");
+
+  EXPECT_NO_THROW(rogue::loadJSON(Dir / "valid.json", &Schema));
+  EXPECT_THROW(rogue::loadJSON(Dir / "invalid.json", &Schema),
+               std::runtime_error);
+  EXPECT_NO_THROW(rogue::loadJSON(Dir / "valid.json", &Schema));
+
+  // Changing the schema invalidates the compiled schema and the record of
+  // validated contents
+  writeFile(Schema, R"({"type": "object", "required": ["a", "c"]})");
+  EXPECT_THROW(rogue::loadJSON(Dir / "valid.json", &Schema),
+               std::runtime_error);
+}
+
+TEST_F(JSONTest, SkipValidatedContents) {
+  const auto Schema = Dir / "schema.json";
+  writeFile(Schema, R"({"type": "object", "required": ["a"]})");
+  writeFile(Dir / "valid.json", R"({"a": 1})");
+  writeFile(Dir / "copy.json", R"({"a": 1})");
+  writeFile(Dir / "other.json", R"({"a": 2})");
+
+  const auto Count = rogue::getJSONValidationCount();
+  rogue::loadJSON(Dir / "valid.json", &Schema);
+  EXPECT_EQ(rogue::getJSONValidationCount(), Count + 1);
+
+  // Contents are identified by their hash, not by their path
+  rogue::loadJSON(Dir / "valid.json", &Schema);
+  rogue::loadJSON(Dir / "copy.json", &Schema);
+  EXPECT_EQ(rogue::getJSONValidationCount(), Count + 1);
+  rogue::loadJSON(Dir / "other.json", &Schema);
+  EXPECT_EQ(rogue::getJSONValidationCount(), Count + 2);
+
+  // Invalid contents are never recorded
+  writeFile(Dir / "invalid.json", R"({"b": 1})");
+  EXPECT_THROW(rogue::loadJSON(Dir / "invalid.json", &Schema),
+               std::runtime_error);
+  EXPECT_THROW(rogue::loadJSON(Dir / "invalid.json", &Schema),
+               std::runtime_error);
+  EXPECT_EQ(rogue::getJSONValidationCount(), Count + 4);
+
+  rogue::setJSONValidationMode(rogue::JSONValidationMode::Always);
+  rogue::loadJSON(Dir / "valid.json", &Schema);
+  EXPECT_EQ(rogue::getJSONValidationCount(), Count + 5);
+}
+
+} // namespace
@@ -4,6 +4,7 @@
 #include <rogue/Components/Transform.h>
 #include <rogue/Context.h>
 #include <rogue/CraftingHandler.h>
+#include <rogue/EntityAssemblers.h>
 #include <rogue/EntityDatabase.h>
 #include <rogue/ItemDatabase.h>
 #include <rogue/LevelDatabase.h>
@@ -184,6 +185,81 @@ TEST_F(LevelGeneratorTest, CompositeMultiLevelGeneratorGenLevels) {
   EXPECT_THROW(CMG.generateLevel(4), std::out_of_range);
 }
 
+TEST_F(LevelGeneratorTest, CompositeMultiLevelGeneratorGenAll) {
+  writeFile("test_gen_all.map", "#####\n"
+                                "#CCC#\n"
+                                "#CCC#\n"
+                                "#####\n");
+
+  // Chests roll their inventory from the random engine of the level
+  const auto ItemId = ItemDb.getNewItemId();
+  ItemDb.addItemProto(rogue::ItemPrototype(ItemId, "coin", "desc",
+                                           rogue::ItemType::Crafting, 100, {}));
+  ItemDb.addLootTable("loot_tb").reset(
+      2, {{std::make_shared<rogue::LootItem>(ItemId, 1, 100), 10},
+          {std::make_shared<rogue::LootItem>(ItemId, 1, 5), 10},
+          {nullptr, 10}});
+  rogue::EntityTemplateInfo ETI;
+  ETI.Name = "chest";
+  ETI.Assemblers["position"] = std::make_shared<
+      rogue::DefaultConstructEntityAssembler<rogue::PositionComp>>();
+  ETI.Assemblers["inventory"] =
+      std::make_shared<rogue::InventoryCompAssembler>(ItemDb, "loot_tb", 100);
+  EntityDb.addEntityTemplate(ETI);
+
+  rogue::DesignedMapLevelGenerator::Config Cfg;
+  Cfg.MapFile = "test_gen_all.map";
+  Cfg.DefaultChar.T = rogue::Tile{{' '}};
+  Cfg.DefaultChar.Layer = "ground";
+  Cfg.CharInfoMap['#'].T = rogue::Tile{{'#'}};
+  Cfg.CharInfoMap['#'].Layer = "walls";
+  Cfg.CharInfoMap['C'].T = rogue::Tile{{'C'}};
+  Cfg.CharInfoMap['C'].Layer = "entities";
+  Cfg.EntityConfig = {/*Entities =*/{{'C', "chest"}}};
+
+  rogue::CompositeMultiLevelGenerator CMG(Ctx, "");
+  CMG.addGenerator(std::make_shared<rogue::DesignedMapLevelGenerator>(
+                       Ctx, "", Cfg, /*Seed=*/7),
+                   3);
+  CMG.addGenerator(std::make_shared<rogue::EmptyLevelGenerator>(
+                       Ctx, "", rogue::EmptyLevelGenerator::Config{{2, 2}}),
+                   5);
+
+  using Inventories =
+      std::map<std::pair<int, int>, std::vector<std::pair<int, int>>>;
+  auto getInventories = [](const rogue::Level &Lvl) {
+    Inventories Invs;
+    Lvl.Reg.view<const rogue::PositionComp, const rogue::InventoryComp>().each(
+        [&Invs](const auto &PC, const auto &IC) {
+          auto &Items = Invs[{PC.Pos.X, PC.Pos.Y}];
+          for (const auto &It : IC.Inv.getItems()) {
+            Items.emplace_back(It.getId(), It.StackSize);
+          }
+        });
+    return Invs;
+  };
+
+  const auto Levels = CMG.generateAll(/*NumThreads=*/3);
+  ASSERT_EQ(Levels.size(), 6);
+  for (std::size_t Idx = 0; Idx < Levels.size(); ++Idx) {
+    const auto Expected = CMG.generateLevel(Idx);
+    const auto &Lvl = *Levels.at(Idx);
+    EXPECT_EQ(Lvl.getLevelId(), static_cast<int>(Idx));
+    EXPECT_EQ(Lvl.Map.getSize(), Expected->Map.getSize());
+    EXPECT_EQ(getWallTileKind(Lvl, {0, 0}), getWallTileKind(*Expected, {0, 0}));
+    EXPECT_EQ(getInventories(Lvl), getInventories(*Expected));
+    if (Idx <= 3) {
+      EXPECT_EQ(getInventories(Lvl).size(), 6);
+    }
+  }
+
+  const auto Range = CMG.generateRange(2, 4);
+  ASSERT_EQ(Range.size(), 2);
+  EXPECT_EQ(Range.at(0)->getLevelId(), 2);
+  EXPECT_EQ(getInventories(*Range.at(0)), getInventories(*Levels.at(2)));
+  EXPECT_THROW(CMG.generateRange(4, 7), std::out_of_range);
+}
+
 // TEST(LevelGeneratorTest, ConfigLevelGenerator) {
 //   rogue::ConfigLevelGenerator CLG;
 // }
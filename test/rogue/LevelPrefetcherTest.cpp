@@ -0,0 +1,38 @@
+#include <atomic>
+#include <gtest/gtest.h>
+#include <rogue/LevelPrefetcher.h>
+#include <stdexcept>
+
+namespace {
+
+TEST(LevelPrefetcherTest, TakeScheduledLevel) {
+  std::atomic<int> Calls = 0;
+  rogue::LevelPrefetcher Prefetcher;
+  EXPECT_EQ(Prefetcher.take(0), nullptr);
+
+  auto Generate = [&Calls]() {
+    Calls++;
+    return std::shared_ptr<rogue::Level>();
+  };
+  Prefetcher.prefetch(1, Generate);
+  Prefetcher.prefetch(1, Generate);
+  EXPECT_TRUE(Prefetcher.isScheduled(1));
+
+  Prefetcher.take(1);
+  EXPECT_EQ(Calls, 1);
+  EXPECT_FALSE(Prefetcher.isScheduled(1));
+}
+
+TEST(LevelPrefetcherTest, CancelAndErrors) {
+  rogue::LevelPrefetcher Prefetcher;
+  Prefetcher.prefetch(0, []() -> std::shared_ptr<rogue::Level> {
+    throw std::runtime_error("generation failed");
+  });
+  EXPECT_THROW(Prefetcher.take(0), std::runtime_error);
+
+  Prefetcher.prefetch(1, []() { return std::shared_ptr<rogue::Level>(); });
+  Prefetcher.cancel();
+  EXPECT_FALSE(Prefetcher.isScheduled(1));
+}
+
+} // namespace
@@ -0,0 +1,80 @@
+#include <gtest/gtest.h>
+#include <rogue/LootDropCalculator.h>
+#include <rogue/LootSimulator.h>
+
+namespace {
+
+using PId = rogue::ItemProtoId;
+
+TEST(LootDropCalculatorTest, PickAndReturn) {
+  rogue::LootTable LTB(
+      2,
+      {
+          {std::make_shared<rogue::LootItem>(PId(1), 1, 3), 1},
+          {std::make_shared<rogue::LootItem>(PId(2), 1, 1), 3},
+      },
+      /*PickAndReturn=*/true);
+
+  rogue::LootDropCalculator Calc;
+  const auto &Rates = Calc.getDropRates(LTB);
+  ASSERT_EQ(Rates.size(), 2);
+  EXPECT_DOUBLE_EQ(Rates.at(PId(1)).Probability, 1.0 - 0.75 * 0.75);
+  EXPECT_DOUBLE_EQ(Rates.at(PId(1)).ExpectedCount, 1.0);
+  EXPECT_DOUBLE_EQ(Rates.at(PId(2)).Probability, 1.0 - 0.25 * 0.25);
+  EXPECT_DOUBLE_EQ(Rates.at(PId(2)).ExpectedCount, 1.5);
+}
+
+TEST(LootDropCalculatorTest, NoReturnsAndGuaranteed) {
+  auto Shared = std::make_shared<rogue::LootItem>(PId(3), 2, 2);
+  rogue::LootTable LTB(2, {
+                              {std::make_shared<rogue::LootItem>(PId(1), 1, 1), 1},
+                              {nullptr, 1},
+                              {Shared, 2},
+                              {Shared, -1},
+                          });
+
+  rogue::LootDropCalculator Calc;
+  const auto &Rates = Calc.getDropRates(LTB);
+  ASSERT_EQ(Rates.size(), 2);
+  // First pick 1/4, or second pick after the null slot or the shared item
+  EXPECT_DOUBLE_EQ(Rates.at(PId(1)).Probability, 7.0 / 12.0);
+  EXPECT_DOUBLE_EQ(Rates.at(PId(3)).Probability, 1.0);
+  EXPECT_DOUBLE_EQ(Rates.at(PId(3)).ExpectedCount,
+                   2.0 + 2.0 * (1.0 - 1.0 / 6.0));
+
+  // Matches the sampled rates
+  const auto Res = rogue::LootSimulator(LTB).run(200000, /*Seed=*/0);
+  for (const auto &Stats : Res.Items) {
+    const auto &Drop = Rates.at(Stats.ItId);
+    EXPECT_NEAR(double(Stats.Occurrences) / Res.Rolls, Drop.Probability, 0.01);
+    EXPECT_NEAR(double(Stats.Count) / Res.Rolls, Drop.ExpectedCount, 0.02);
+  }
+}
+
+TEST(LootDropCalculatorTest, FailedTablesCanBeRetried) {
+  // Too many slots to pick without returns, fails below the outer table
+  std::vector<rogue::LootTable::LootSlot> Slots;
+  for (int Idx = 0; Idx < 65; ++Idx) {
+    Slots.push_back({std::make_shared<rogue::LootItem>(PId(Idx), 1, 1), 1});
+  }
+  auto Big = std::make_shared<rogue::LootTable>(2, Slots);
+  rogue::LootTable Outer(1, {{Big, 1}});
+
+  rogue::LootDropCalculator Calc;
+  for (int Try = 0; Try < 2; ++Try) {
+    try {
+      Calc.getDropRates(Outer);
+      FAIL() << "Expected the table to fail";
+    } catch (const std::runtime_error &E) {
+      EXPECT_STREQ(E.what(), "LootDropCalculator: Too many slots for picking "
+                             "without returns");
+    }
+  }
+
+  // Failed tables do not count as being evaluated for the recursion guard
+  rogue::LootTable Small(1, {{std::make_shared<rogue::LootItem>(PId(1), 1, 1),
+                              1}});
+  EXPECT_DOUBLE_EQ(Calc.getDropRates(Small).at(PId(1)).Probability, 1.0);
+}
+
+} // namespace
@@ -0,0 +1,79 @@
+#include <gtest/gtest.h>
+#include <rogue/LootSimulator.h>
+
+namespace {
+
+using PId = rogue::ItemProtoId;
+
+TEST(LootSimulatorTest, AliasTable) {
+  std::mt19937 Rng(0);
+  rogue::AliasTable Single({0, 7, 0});
+  for (int Cnt = 0; Cnt < 100; ++Cnt) {
+    EXPECT_EQ(Single.sample(Rng), 1);
+  }
+
+  rogue::AliasTable Uneven({1, 3});
+  int Hits = 0;
+  for (int Cnt = 0; Cnt < 10000; ++Cnt) {
+    Hits += Uneven.sample(Rng) == 1;
+  }
+  EXPECT_NEAR(Hits, 7500, 300);
+
+  EXPECT_TRUE(rogue::AliasTable({0, 0}).empty());
+  EXPECT_THROW(rogue::AliasTable({1, -1}), std::out_of_range);
+}
+
+TEST(LootSimulatorTest, GuaranteedAndNoReturns) {
+  auto CoinsLTB = std::make_shared<rogue::LootTable>(
+      2, std::vector<rogue::LootTable::LootSlot>{
+             {std::make_shared<rogue::LootItem>(PId(4), 10, 10), 1},
+             {std::make_shared<rogue::LootItem>(PId(5), 1, 1), 3},
+         });
+  rogue::LootTable LTB(1, {
+                              {std::make_shared<rogue::LootItem>(PId(1), 1, 1), 5},
+                              {nullptr, 5},
+                              {CoinsLTB, -1},
+                          });
+
+  rogue::LootSimulator Sim(LTB);
+  std::mt19937 Rng(0);
+  std::vector<rogue::LootContainer::LootReward> Loot;
+  Sim.fillLoot(Loot, Rng);
+  EXPECT_GE(Loot.size(), 2);
+
+  // Both coin slots are picked on every roll as picked slots are removed
+  const auto Res = Sim.run(1000, /*Seed=*/0, /*NumThreads=*/1);
+  EXPECT_EQ(Res.Rolls, 1000);
+  ASSERT_EQ(Res.Items.size(), 3);
+  EXPECT_EQ(Res.Items.at(0).ItId, 4);
+  EXPECT_EQ(Res.Items.at(0).Count, 10000);
+  EXPECT_EQ(Res.Items.at(0).Occurrences, 1000);
+  EXPECT_EQ(Res.Items.at(1).ItId, 5);
+  EXPECT_EQ(Res.Items.at(1).Occurrences, 1000);
+  EXPECT_NEAR(Res.Items.at(2).Occurrences, 500, 100);
+}
+
+TEST(LootSimulatorTest, ResultIndependentOfThreads) {
+  rogue::LootTable LTB(
+      3,
+      {
+          {std::make_shared<rogue::LootItem>(PId(1), 1, 3), 5},
+          {std::make_shared<rogue::LootItem>(PId(2), 1, 1), 10},
+          {std::make_shared<rogue::LootItem>(PId(3), 2, 2), 20},
+      },
+      /*PickAndReturn=*/true);
+
+  rogue::LootSimulator Sim(LTB);
+  const auto Rolls = rogue::LootSimulator::BatchSize * 3 + 17;
+  const auto Single = Sim.run(Rolls, /*Seed=*/42, /*NumThreads=*/1);
+  const auto Multi = Sim.run(Rolls, /*Seed=*/42, /*NumThreads=*/4);
+  EXPECT_EQ(Single.Total, Multi.Total);
+  ASSERT_EQ(Single.Items.size(), Multi.Items.size());
+  for (std::size_t Idx = 0; Idx < Single.Items.size(); ++Idx) {
+    EXPECT_EQ(Single.Items[Idx].ItId, Multi.Items[Idx].ItId);
+    EXPECT_EQ(Single.Items[Idx].Count, Multi.Items[Idx].Count);
+    EXPECT_EQ(Single.Items[Idx].Occurrences, Multi.Items[Idx].Occurrences);
+  }
+}
+
+} // namespace
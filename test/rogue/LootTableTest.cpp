@@ -51,7 +51,8 @@ TEST(LootTableTest, GuaranteedRewards) {
          });
   std::vector<rogue::LootContainer::LootReward> LootRef = {{PId(4), 1}};
   std::vector<rogue::LootContainer::LootReward> Loot;
-  LTB.fillGuaranteedLoot(Loot);
+  rogue::RandomEngine Rng;
+  LTB.fillGuaranteedLoot(Loot, Rng);
   EXPECT_EQ(Loot, LootRef);
 
   Loot = LTB.generateLoot();
@@ -0,0 +1,89 @@
+#include <gtest/gtest.h>
+#include <rogue/Profiler.h>
+#include <sstream>
+
+namespace {
+
+using Clock = rogue::Profiler::Clock;
+
+void recordUs(rogue::Profiler &Prof, std::string_view Name, Clock::time_point T,
+              unsigned Us) {
+  Prof.record(Name, T, T + std::chrono::microseconds(Us));
+}
+
+TEST(ProfilerTest, DisabledTimerDoesNotRecord) {
+  rogue::Profiler Prof;
+  { rogue::Profiler::ScopedTimer Timer("stage", Prof); }
+  EXPECT_TRUE(Prof.getAllStats().empty());
+  EXPECT_THROW(Prof.getStats("stage"), std::out_of_range);
+
+  Prof.setEnabled(true);
+  { rogue::Profiler::ScopedTimer Timer("stage", Prof); }
+  EXPECT_EQ(Prof.getStats("stage").TotalCount, 1);
+}
+
+TEST(ProfilerTest, Percentiles) {
+  rogue::Profiler Prof;
+  const auto T = Clock::now();
+  for (unsigned Us = 1; Us <= 100; ++Us) {
+    recordUs(Prof, "stage", T, Us);
+  }
+  auto St = Prof.getStats("stage");
+  EXPECT_EQ(St.NumSamples, 100);
+  EXPECT_EQ(St.Last, 100);
+  EXPECT_EQ(St.Min, 1);
+  EXPECT_EQ(St.Max, 100);
+  EXPECT_DOUBLE_EQ(St.Mean, 50.5);
+  EXPECT_EQ(St.P50, 51);
+  EXPECT_EQ(St.P95, 95);
+  EXPECT_EQ(St.P99, 99);
+}
+
+TEST(ProfilerTest, RingBufferKeepsMostRecentSamples) {
+  rogue::Profiler Prof;
+  const auto T = Clock::now();
+  for (unsigned Idx = 0; Idx < rogue::Profiler::MaxSamples; ++Idx) {
+    recordUs(Prof, "stage", T, 1000);
+  }
+  for (unsigned Idx = 0; Idx < rogue::Profiler::MaxSamples; ++Idx) {
+    recordUs(Prof, "stage", T, 10);
+  }
+  auto St = Prof.getStats("stage");
+  EXPECT_EQ(St.NumSamples, rogue::Profiler::MaxSamples);
+  EXPECT_EQ(St.TotalCount, 2 * rogue::Profiler::MaxSamples);
+  EXPECT_EQ(St.Max, 10);
+}
+
+TEST(ProfilerTest, Dump) {
+  rogue::Profiler Prof;
+  const auto T = Clock::now();
+  recordUs(Prof, "a", T, 5);
+  recordUs(Prof, "b", T, 7);
+
+  std::stringstream CSV;
+  Prof.dumpCSV(CSV);
+  std::string Line;
+  std::getline(CSV, Line);
+  EXPECT_EQ(Line.substr(0, 12), "stage,count,");
+  std::getline(CSV, Line);
+  EXPECT_EQ(Line, "a,1,1,5,5,5,5,5,5,5");
+  std::getline(CSV, Line);
+  EXPECT_EQ(Line, "b,1,1,7,7,7,7,7,7,7");
+
+  std::stringstream Trace;
+  Prof.dumpChromeTrace(Trace);
+  EXPECT_NE(Trace.str().find("\"name\":\"a\",\"ph\":\"X\""), std::string::npos);
+  EXPECT_NE(Trace.str().find("\"dur\":7"), std::string::npos);
+}
+
+TEST(ProfilerTest, DumpChromeTraceEscapesNames) {
+  rogue::Profiler Prof;
+  recordUs(Prof, "say \"hi\"\\\n", Clock::now(), 1);
+
+  std::stringstream Trace;
+  Prof.dumpChromeTrace(Trace);
+  EXPECT_NE(Trace.str().find("\"name\":\"say \\\"hi\\\"\\\\\\n\","),
+            std::string::npos);
+}
+
+} // namespace
@@ -0,0 +1,56 @@
+#include <filesystem>
+#include <gtest/gtest.h>
+#include <rogue/SaveGameFile.h>
+
+namespace {
+
+class SaveGameFileTest : public ::testing::Test {
+public:
+  void SetUp() override {
+    const auto *Info = ::testing::UnitTest::GetInstance()->current_test_info();
+    Dir = std::filesystem::temp_directory_path() /
+          (std::string("rogue_save_game_file_") + Info->name());
+    std::filesystem::remove_all(Dir);
+    std::filesystem::create_directories(Dir);
+  }
+
+  void TearDown() override { std::filesystem::remove_all(Dir); }
+
+  std::filesystem::path Dir;
+};
+
+TEST_F(SaveGameFileTest, WriteAndRead) {
+  const auto Path = Dir / "save_game.bin";
+  {
+    rogue::SaveGameWriter Writer(Path);
+    Writer.addChunk(rogue::SaveGameChunk::World, 0, "world");
+    Writer.addChunk(rogue::SaveGameChunk::Level, 2, "level_2");
+    Writer.addChunk(rogue::SaveGameChunk::Level, 0, "");
+    Writer.finish();
+    EXPECT_THROW(Writer.addChunk(rogue::SaveGameChunk::Level, 1, "level_1"),
+                 std::runtime_error);
+  }
+
+  rogue::SaveGameReader Reader(Path);
+  EXPECT_TRUE(Reader.hasChunk(rogue::SaveGameChunk::World, 0));
+  EXPECT_FALSE(Reader.hasChunk(rogue::SaveGameChunk::Level, 1));
+  EXPECT_EQ(Reader.getChunkIndices(rogue::SaveGameChunk::Level),
+            (std::vector<std::uint32_t>{0, 2}));
+  EXPECT_EQ(Reader.readChunk(rogue::SaveGameChunk::Level, 2), "level_2");
+  EXPECT_EQ(Reader.readChunk(rogue::SaveGameChunk::World, 0), "world");
+  EXPECT_EQ(Reader.readChunk(rogue::SaveGameChunk::Level, 0), "");
+  EXPECT_THROW(Reader.readChunk(rogue::SaveGameChunk::Level, 1),
+               std::out_of_range);
+}
+
+TEST_F(SaveGameFileTest, RejectUnfinished) {
+  const auto Path = Dir / "unfinished.bin";
+  {
+    rogue::SaveGameWriter Writer(Path);
+    Writer.addChunk(rogue::SaveGameChunk::World, 0, "world");
+  }
+  EXPECT_THROW(rogue::SaveGameReader{Path}, std::runtime_error);
+  EXPECT_THROW(rogue::SaveGameReader(Dir / "missing.bin"), std::runtime_error);
+}
+
+} // namespace
@@ -0,0 +1,113 @@
+#include <gtest/gtest.h>
+#include <rogue/Components/Items.h>
+#include <rogue/Components/Stats.h>
+#include <rogue/Components/Transform.h>
+#include <rogue/Context.h>
+#include <rogue/CraftingHandler.h>
+#include <rogue/EntityDatabase.h>
+#include <rogue/ItemDatabase.h>
+#include <rogue/Level.h>
+#include <rogue/LevelDatabase.h>
+#include <rogue/LevelGenerator.h>
+#include <rogue/Serialization.h>
+
+namespace {
+
+class SerializationTest : public ::testing::Test {
+public:
+  std::shared_ptr<rogue::Level> generateLevel(ymir::Size2d<int> Size) {
+    rogue::EmptyLevelGenerator LvlGen(Ctx, "", {Size});
+    auto Lvl = LvlGen.generateLevel(0);
+    for (int Idx = 0; Idx < 3; ++Idx) {
+      auto Et = Lvl->Reg.create();
+      Lvl->Reg.emplace<rogue::PositionComp>(Et, ymir::Point2d<int>{Idx, 0});
+      Lvl->Reg.emplace<rogue::HealthComp>(Et);
+      Lvl->Reg.emplace<rogue::InventoryComp>(Et);
+    }
+    return Lvl;
+  }
+
+  rogue::EventHub EvHub;
+  rogue::ItemDatabase ItemDb;
+  rogue::EntityDatabase EntityDb;
+  rogue::LevelDatabase LevelDb;
+  rogue::CraftingDatabase CraftingDb;
+  rogue::CraftingHandler Crafter{ItemDb};
+  rogue::GameContext Ctx{EvHub, ItemDb, EntityDb, LevelDb, CraftingDb, Crafter};
+};
+
+TEST_F(SerializationTest, LevelSnapshotDelta) {
+  auto Lvl = generateLevel({8, 8});
+  const auto Baseline = rogue::serialize::LevelBaseline::create(*Lvl);
+
+  std::vector<entt::entity> Entities;
+  Lvl->Reg.view<rogue::PositionComp>().each(
+      [&Entities](auto Et, const auto &) { Entities.push_back(Et); });
+  ASSERT_EQ(Entities.size(), 3);
+  Lvl->Reg.destroy(Entities.at(0));
+  Lvl->Reg.get<rogue::PositionComp>(Entities.at(1)).Pos = {5, 5};
+  Lvl->Reg.get<rogue::HealthComp>(Entities.at(2)).Value = 42;
+  Lvl->getPlayerSeenMap().getTile({0, 1}) = true;
+  Lvl->getPlayerSeenMap().getTile({7, 7}) = true;
+
+  const auto Bytes =
+      rogue::serialize::LevelSnapshot::create(*Lvl, Baseline).toBytes();
+
+  auto Regenerated = generateLevel({8, 8});
+  rogue::serialize::LevelSnapshot::fromBytes(Bytes).apply(*Regenerated);
+  auto &Reg = Regenerated->Reg;
+  EXPECT_FALSE(Reg.valid(Entities.at(0)));
+  EXPECT_EQ(Reg.get<rogue::PositionComp>(Entities.at(1)).Pos,
+            ymir::Point2d<int>(5, 5));
+  EXPECT_EQ(Reg.get<rogue::HealthComp>(Entities.at(2)).Value, 42);
+  EXPECT_TRUE(Regenerated->getPlayerSeenMap().getTile({0, 1}));
+  EXPECT_TRUE(Regenerated->getPlayerSeenMap().getTile({7, 7}));
+  EXPECT_FALSE(Regenerated->getPlayerSeenMap().getTile({1, 1}));
+}
+
+TEST_F(SerializationTest, LevelSnapshotChecksumMismatch) {
+  auto Lvl = generateLevel({8, 8});
+  const auto Baseline = rogue::serialize::LevelBaseline::create(*Lvl);
+  const auto Snapshot = rogue::serialize::LevelSnapshot::create(*Lvl, Baseline);
+
+  auto Other = generateLevel({8, 9});
+  EXPECT_NE(rogue::serialize::LevelBaseline::computeChecksum(*Other),
+            Baseline.getChecksum());
+  EXPECT_THROW(Snapshot.apply(*Other), std::runtime_error);
+}
+
+TEST_F(SerializationTest, LevelSnapshotUnchangedInventories) {
+  const auto ItemId = ItemDb.getNewItemId();
+  ItemDb.addItemProto(rogue::ItemPrototype(ItemId, "coin", "desc",
+                                           rogue::ItemType::Crafting, 100, {}));
+  const auto Generate = [this, ItemId]() {
+    auto Lvl = generateLevel({8, 8});
+    Lvl->Reg.view<rogue::InventoryComp>().each([this, ItemId](auto &IC) {
+      IC.Inv.addItem(rogue::Item(ItemDb.getItemProto(ItemId), 2));
+    });
+    return Lvl;
+  };
+
+  auto Lvl = Generate();
+  const auto Baseline = rogue::serialize::LevelBaseline::create(*Lvl);
+  EXPECT_TRUE(rogue::serialize::LevelSnapshot::create(*Lvl, Baseline).empty());
+
+  // Only the changed inventory is stored
+  std::vector<entt::entity> Entities;
+  Lvl->Reg.view<rogue::InventoryComp>().each(
+      [&Entities](auto Et, const auto &) { Entities.push_back(Et); });
+  ASSERT_EQ(Entities.size(), 3);
+  Lvl->Reg.get<rogue::InventoryComp>(Entities.at(1)).Inv.clear();
+  const auto Snapshot = rogue::serialize::LevelSnapshot::create(*Lvl, Baseline);
+  EXPECT_FALSE(Snapshot.empty());
+
+  auto Regenerated = Generate();
+  rogue::serialize::LevelSnapshot::fromBytes(Snapshot.toBytes())
+      .apply(*Regenerated);
+  const auto &Reg = Regenerated->Reg;
+  EXPECT_EQ(Reg.get<rogue::InventoryComp>(Entities.at(0)).Inv.size(), 1);
+  EXPECT_TRUE(Reg.get<rogue::InventoryComp>(Entities.at(1)).Inv.empty());
+  EXPECT_EQ(Reg.get<rogue::InventoryComp>(Entities.at(2)).Inv.size(), 1);
+}
+
+} // namespace
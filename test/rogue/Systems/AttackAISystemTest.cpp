@@ -0,0 +1,97 @@
+#include <gtest/gtest.h>
+#include <rogue/Components/AI.h>
+#include <rogue/ItemEffect.h>
+#include <rogue/Level.h>
+#include <rogue/Systems/AttackAISystem.h>
+
+namespace {
+
+class CountingEffect : public rogue::ItemEffect {
+public:
+  explicit CountingEffect(unsigned &Count) : Count(Count) {}
+
+  std::shared_ptr<rogue::ItemEffect> clone() const override {
+    return std::make_shared<CountingEffect>(*this);
+  }
+  std::string getName() const override { return "Counting"; }
+  std::string getDescription() const override { return "Counts"; }
+
+  void applyTo(const entt::entity &, const entt::entity &,
+               entt::registry &) const override {
+    ++Count;
+  }
+
+private:
+  unsigned &Count;
+};
+
+class AttackAISystemTest : public ::testing::Test {
+public:
+  void SetUp() override { Et = L.Reg.create(); }
+
+  void tick(unsigned Count = 1) {
+    for (unsigned Idx = 0; Idx < Count; ++Idx) {
+      Sys.update(rogue::System::UpdateType::Tick);
+    }
+  }
+
+  rogue::EffectExecutorComp &addExecutor(unsigned FirstDelay,
+                                          unsigned Delay) {
+    rogue::EffectExecutorComp EEC;
+    EEC.Effects.push_back({std::make_shared<CountingEffect>(Count),
+                           std::uniform_int_distribution<unsigned>(Delay,
+                                                                   Delay)});
+    EEC.FirstDelay = FirstDelay;
+    return L.Reg.emplace<rogue::EffectExecutorComp>(Et, EEC);
+  }
+
+  rogue::Level L{0, {4, 4}};
+  rogue::AttackAISystem Sys{L};
+  entt::entity Et = entt::null;
+  unsigned Count = 0;
+};
+
+TEST_F(AttackAISystemTest, ExecutesAfterDelays) {
+  addExecutor(/*FirstDelay=*/2, /*Delay=*/1);
+
+  Sys.update(rogue::System::UpdateType::NoTick);
+  tick(2);
+  EXPECT_EQ(Count, 0);
+  tick();
+  EXPECT_EQ(Count, 1);
+
+  // Each effect is followed by its own delay
+  tick();
+  EXPECT_EQ(Count, 1);
+  tick();
+  EXPECT_EQ(Count, 2);
+  tick(4);
+  EXPECT_EQ(Count, 4);
+}
+
+TEST_F(AttackAISystemTest, ExecutesEveryTickWithoutDelay) {
+  addExecutor(/*FirstDelay=*/0, /*Delay=*/0);
+  tick(3);
+  EXPECT_EQ(Count, 3);
+}
+
+TEST_F(AttackAISystemTest, RemovedWhilePending) {
+  addExecutor(/*FirstDelay=*/1, /*Delay=*/0);
+  tick();
+  L.Reg.remove<rogue::EffectExecutorComp>(Et);
+  tick(3);
+  EXPECT_EQ(Count, 0);
+
+  // Re-adding starts over with the first delay of the new executor
+  addExecutor(/*FirstDelay=*/1, /*Delay=*/0);
+  tick();
+  EXPECT_EQ(Count, 0);
+  tick();
+  EXPECT_EQ(Count, 1);
+
+  L.Reg.destroy(Et);
+  tick(3);
+  EXPECT_EQ(Count, 1);
+}
+
+} // namespace
@@ -95,8 +95,9 @@ TEST_F(LOSSystemTest, InvisibilityBuff) {
   Sys->update(rogue::System::UpdateType::NoTick);
   EXPECT_FALSE(Reg.get<rogue::VisibleComp>(Et).IsVisible);
 
+  Reg.erase<rogue::InvisibilityBuffComp>(Et);
   Sys->update(rogue::System::UpdateType::Tick);
-  EXPECT_FALSE(Reg.any_of<rogue::InvisibilityBuffComp>(Et));
+  EXPECT_TRUE(Reg.get<rogue::VisibleComp>(Et).IsVisible);
 }
 
 } // namespace
\ No newline at end of file
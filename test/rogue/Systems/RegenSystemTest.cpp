@@ -1,30 +1,92 @@
+#include <gtest/gtest.h>
+#include <rogue/Components/Stats.h>
+#include <rogue/Systems/RegenSystem.h>
 
-TEST(StatsSystemTest, StatsSystemRegenEffects) {
-  const rogue::StatPoints StatPoints = {1, 2, 3, 4};
+namespace {
+
+class RegenSystemTest : public ::testing::Test {
+public:
+  void SetUp() override {
+    Reg = entt::registry();
+    Sys = std::make_shared<rogue::RegenSystem>(Reg);
+    Et = Reg.create();
+  }
+
+  void tick(unsigned Count = 1) {
+    for (unsigned Idx = 0; Idx < Count; ++Idx) {
+      Sys->update(rogue::System::UpdateType::Tick);
+    }
+  }
+
+  rogue::HealthComp &addHealth(unsigned TickPeriod) {
+    auto &HC = Reg.emplace<rogue::HealthComp>(Et);
+    HC.MaxValue = 100;
+    HC.Value = 50;
+    HC.RegenAmount = 1;
+    HC.TickPeriod = TickPeriod;
+    return HC;
+  }
 
   entt::registry Reg;
-  rogue::StatsSystem StatsSystem(Reg);
+  std::shared_ptr<rogue::RegenSystem> Sys = nullptr;
+  entt::entity Et = entt::null;
+};
+
+TEST_F(RegenSystemTest, RegenEveryTickPeriod) {
+  auto &HC = addHealth(/*TickPeriod=*/3);
+  auto &MC = Reg.emplace<rogue::ManaComp>(Et);
+  MC.MaxValue = 100;
+  MC.Value = 10;
+  MC.RegenAmount = 2;
+  MC.TickPeriod = 1;
+
+  Sys->update(rogue::System::UpdateType::NoTick);
+  EXPECT_EQ(HC.Value, 50);
 
-  auto Entity = Reg.create();
-  Reg.emplace<rogue::StatsComp>(Entity, /*Base=*/StatPoints,
-                                /*Bonus=*/StatPoints);
+  // The first regeneration happens after the first tick delay
+  tick();
+  EXPECT_EQ(HC.Value, 51);
+  EXPECT_EQ(MC.Value, 12);
+  tick(2);
+  EXPECT_EQ(HC.Value, 51);
+  EXPECT_EQ(MC.Value, 16);
+  tick();
+  EXPECT_EQ(HC.Value, 52);
+  tick(3);
+  EXPECT_EQ(HC.Value, 53);
+}
 
-  auto &Health = Reg.emplace<rogue::HealthComp>(Entity);
-  Health.MaxValue = 100;
-  Health.Value = 50;
+TEST_F(RegenSystemTest, TickPeriodZeroRegensOnce) {
+  auto &HC = addHealth(/*TickPeriod=*/0);
+  tick();
+  EXPECT_EQ(HC.Value, 51);
+  tick(10);
+  EXPECT_EQ(HC.Value, 51);
+}
 
-  auto &Mana = Reg.emplace<rogue::ManaComp>(Entity);
-  Mana.MaxValue = 100;
-  Mana.Value = 50;
+TEST_F(RegenSystemTest, RemovedWhilePending) {
+  addHealth(/*TickPeriod=*/2);
+  tick();
+  EXPECT_EQ(Reg.get<rogue::HealthComp>(Et).Value, 51);
 
-  auto &Agility = Reg.emplace<rogue::AgilityComp>(Entity);
-  Agility.Agility = 50;
+  // Replacing the component cancels the pending regeneration and schedules
+  // the first one of the new component
+  Reg.remove<rogue::HealthComp>(Et);
+  auto &HC = addHealth(/*TickPeriod=*/2);
+  tick();
+  EXPECT_EQ(HC.Value, 51);
+  tick();
+  EXPECT_EQ(HC.Value, 51);
+  tick();
+  EXPECT_EQ(HC.Value, 52);
 
-  StatsSystem.update();
-  EXPECT_EQ(Health.Value, 50);
-  EXPECT_EQ(Mana.Value, 50);
-  EXPECT_EQ(Agility.Agility, 50);
+  // Removed components and destroyed entities are not woken up
+  Reg.remove<rogue::HealthComp>(Et);
+  tick(4);
+  addHealth(/*TickPeriod=*/2);
+  Reg.destroy(Et);
+  tick(4);
+  EXPECT_TRUE(Reg.view<rogue::HealthComp>().empty());
+}
 
-  Reg.emplace<rogue::StatsBuffComp>(Entity, /*Bonus=*/StatPoints);
-  StatsSystem.update();
-}
\ No newline at end of file
+} // namespace
@@ -3,9 +3,17 @@
 #include <rogue/Components/Buffs.h>
 #include <rogue/Components/Stats.h>
 #include <rogue/Systems/StatsSystem.h>
+#include <rogue/Systems/TimedBuffSystem.h>
 
 namespace {
 
+/// Buffs are ticked by the timed buff system before stats are updated
+void tick(rogue::TimedBuffSystem &BuffSystem,
+          rogue::StatsSystem &StatsSystem) {
+  BuffSystem.update(rogue::System::UpdateType::Tick);
+  StatsSystem.update(rogue::System::UpdateType::Tick);
+}
+
 TEST(StatsSystemTest, StatsSystemUpdateStatsBuff) {
   const rogue::StatPoints StatPoints = {1, 2, 3, 4};
 
@@ -59,11 +67,47 @@ TEST(StatsSystemTest, StatsSystemRegenEffects) {
   EXPECT_EQ(int(Agility.Agility), 18);
 }
 
+TEST(StatsSystemTest, StatsSystemOnlyUpdatesChangedEntities) {
+  const rogue::StatPoints StatPoints = {1, 2, 3, 4};
+
+  entt::registry Reg;
+  rogue::StatsSystem StatsSystem(Reg);
+
+  auto Entity = Reg.create();
+  auto &Stats = Reg.emplace<rogue::StatsComp>(Entity);
+  Stats.Base = StatPoints;
+  auto &Agility = Reg.emplace<rogue::AgilityComp>(Entity);
+  auto &StatsBuff = Reg.emplace<rogue::StatsBuffComp>(Entity);
+  StatsBuff.Bonus = StatPoints;
+  StatsSystem.update(rogue::System::UpdateType::Tick);
+  EXPECT_EQ(Stats.Bonus, StatPoints);
+  EXPECT_EQ(int(Agility.Agility), 25);
+
+  // Changes that are not patched are not picked up
+  StatsBuff.Bonus = StatPoints + StatPoints;
+  StatsSystem.update(rogue::System::UpdateType::Tick);
+  EXPECT_EQ(Stats.Bonus, StatPoints);
+
+  Reg.patch<rogue::StatsBuffComp>(Entity);
+  StatsSystem.update(rogue::System::UpdateType::Tick);
+  EXPECT_EQ(Stats.Bonus, StatPoints + StatPoints);
+
+  // Agility beyond the tabulated dex values is computed
+  Reg.patch<rogue::StatsComp>(Entity, [](auto &S) { S.Base.Dex = 1000; });
+  StatsSystem.update(rogue::System::UpdateType::Tick);
+  EXPECT_EQ(int(Agility.Agility), 87);
+
+  Reg.erase<rogue::StatsBuffComp>(Entity);
+  StatsSystem.update(rogue::System::UpdateType::Tick);
+  EXPECT_EQ(Stats.Bonus, rogue::StatPoints());
+}
+
 TEST(TimedStatsSystem, TimedStatSystemStatsTimedBuff) {
   const rogue::StatPoints StatPoints = {1, 2, 3, 4};
 
   entt::registry Reg;
   rogue::StatsSystem StatsSystem(Reg);
+  rogue::TimedBuffSystem BuffSystem(Reg);
 
   auto Entity = Reg.create();
 
@@ -78,21 +122,21 @@ TEST(TimedStatsSystem, TimedStatSystemStatsTimedBuff) {
   STBC.TickPeriodsLeft = 2;
   STBC.Bonus = StatPoints;
 
-  StatsSystem.update(rogue::System::UpdateType::Tick);
+  tick(BuffSystem, StatsSystem);
   EXPECT_EQ(Stats.Base, StatPoints);
   EXPECT_EQ(Stats.Bonus, StatPoints);
   ASSERT_TRUE(Reg.any_of<rogue::StatsTimedBuffComp>(Entity));
   EXPECT_EQ(STBC.TicksLeft, 0);
   EXPECT_EQ(STBC.TickPeriodsLeft, 1);
 
-  StatsSystem.update(rogue::System::UpdateType::Tick);
+  tick(BuffSystem, StatsSystem);
   EXPECT_EQ(Stats.Base, StatPoints);
   EXPECT_EQ(Stats.Bonus, StatPoints);
   ASSERT_TRUE(Reg.any_of<rogue::StatsTimedBuffComp>(Entity));
   EXPECT_EQ(STBC.TicksLeft, 0);
   EXPECT_EQ(STBC.TickPeriodsLeft, 0);
 
-  StatsSystem.update(rogue::System::UpdateType::Tick);
+  tick(BuffSystem, StatsSystem);
   EXPECT_EQ(Stats.Base, StatPoints);
   EXPECT_EQ(Stats.Bonus, rogue::StatPoints());
   EXPECT_FALSE(Reg.any_of<rogue::StatsTimedBuffComp>(Entity));
@@ -103,6 +147,7 @@ TEST(TimedStatsSystem, TimedStatSystemStatsBuffPerHit) {
 
   entt::registry Reg;
   rogue::StatsSystem StatsSystem(Reg);
+  rogue::TimedBuffSystem BuffSystem(Reg);
 
   auto Entity = Reg.create();
 
@@ -118,7 +163,7 @@ TEST(TimedStatsSystem, TimedStatSystemStatsBuffPerHit) {
   SBPHC.TickPeriodsLeft = 0;
   SBPHC.SBC.Bonus = StatPoints;
 
-  StatsSystem.update(rogue::System::UpdateType::Tick);
+  tick(BuffSystem, StatsSystem);
   EXPECT_EQ(Stats.Base, StatPoints);
   EXPECT_EQ(Stats.Bonus, rogue::StatPoints());
   EXPECT_FALSE(Reg.any_of<rogue::StatsBuffComp>(Entity));
@@ -129,7 +174,7 @@ TEST(TimedStatsSystem, TimedStatSystemStatsBuffPerHit) {
   SBPHC.addStack();
   EXPECT_EQ(SBPHC.Stacks, 1);
   EXPECT_EQ(SBPHC.TicksLeft, 5);
-  StatsSystem.update(rogue::System::UpdateType::Tick);
+  tick(BuffSystem, StatsSystem);
   EXPECT_EQ(Stats.Base, StatPoints);
   EXPECT_EQ(Stats.Bonus, StatPoints);
   EXPECT_TRUE(Reg.any_of<rogue::StatsBuffComp>(Entity));
@@ -145,7 +190,7 @@ TEST(TimedStatsSystem, TimedStatSystemStatsBuffPerHit) {
   EXPECT_EQ(SBPHC.getEffectiveBuff(SBPHC.Stacks).Bonus,
             StatPoints + StatPoints);
   EXPECT_EQ(SBPHC.getEffectiveBuff(SBPHC.Stacks).SourceCount, 1);
-  StatsSystem.update(rogue::System::UpdateType::Tick);
+  tick(BuffSystem, StatsSystem);
   EXPECT_EQ(Stats.Bonus, StatPoints + StatPoints);
   ASSERT_TRUE(Reg.any_of<rogue::StatsBuffPerHitComp>(Entity));
   EXPECT_EQ(SBPHC.Stacks, 2);
@@ -153,7 +198,7 @@ TEST(TimedStatsSystem, TimedStatSystemStatsBuffPerHit) {
   EXPECT_EQ(SBPHC.TickPeriodsLeft, 0);
 
   // No hit
-  StatsSystem.update(rogue::System::UpdateType::Tick);
+  tick(BuffSystem, StatsSystem);
   EXPECT_EQ(Stats.Bonus, StatPoints + StatPoints);
   ASSERT_TRUE(Reg.any_of<rogue::StatsBuffPerHitComp>(Entity));
   EXPECT_EQ(SBPHC.Stacks, 2);
@@ -164,7 +209,7 @@ TEST(TimedStatsSystem, TimedStatSystemStatsBuffPerHit) {
   SBPHC.addStack();
   EXPECT_EQ(SBPHC.Stacks, 3);
   EXPECT_EQ(SBPHC.TicksLeft, 5);
-  StatsSystem.update(rogue::System::UpdateType::Tick);
+  tick(BuffSystem, StatsSystem);
   EXPECT_EQ(Stats.Bonus, StatPoints + StatPoints + StatPoints);
   ASSERT_TRUE(Reg.any_of<rogue::StatsBuffPerHitComp>(Entity));
   EXPECT_EQ(SBPHC.Stacks, 3);
@@ -175,17 +220,17 @@ TEST(TimedStatsSystem, TimedStatSystemStatsBuffPerHit) {
   SBPHC.addStack();
   EXPECT_EQ(SBPHC.Stacks, 3);
   EXPECT_EQ(SBPHC.TicksLeft, 5);
-  StatsSystem.update(rogue::System::UpdateType::Tick);
+  tick(BuffSystem, StatsSystem);
   EXPECT_EQ(SBPHC.Stacks, 3);
   EXPECT_EQ(SBPHC.TicksLeft, 4);
   EXPECT_EQ(SBPHC.TickPeriodsLeft, 0);
 
   // Nothing x 5
-  StatsSystem.update(rogue::System::UpdateType::Tick);
-  StatsSystem.update(rogue::System::UpdateType::Tick);
-  StatsSystem.update(rogue::System::UpdateType::Tick);
-  StatsSystem.update(rogue::System::UpdateType::Tick);
-  StatsSystem.update(rogue::System::UpdateType::Tick);
+  tick(BuffSystem, StatsSystem);
+  tick(BuffSystem, StatsSystem);
+  tick(BuffSystem, StatsSystem);
+  tick(BuffSystem, StatsSystem);
+  tick(BuffSystem, StatsSystem);
   EXPECT_EQ(SBPHC.Stacks, 0);
   EXPECT_EQ(SBPHC.TicksLeft, 0);
   EXPECT_EQ(SBPHC.TickPeriodsLeft, 0);
@@ -196,22 +241,22 @@ TEST(TimedStatsSystem, TimedStatSystemStatsBuffPerHit) {
   // Add a stats buff comp
   auto &SBC = Reg.emplace<rogue::StatsBuffComp>(Entity);
   SBC.Bonus = StatPoints;
-  StatsSystem.update(rogue::System::UpdateType::Tick);
+  tick(BuffSystem, StatsSystem);
   EXPECT_EQ(Stats.Bonus, StatPoints);
 
   // Fifth hit
   SBPHC.addStack();
   EXPECT_EQ(SBPHC.Stacks, 1);
   EXPECT_EQ(SBPHC.TicksLeft, 5);
-  StatsSystem.update(rogue::System::UpdateType::Tick);
+  tick(BuffSystem, StatsSystem);
   EXPECT_EQ(Stats.Bonus, StatPoints + StatPoints);
   ASSERT_TRUE(Reg.any_of<rogue::StatsBuffPerHitComp>(Entity));
   EXPECT_EQ(SBPHC.Stacks, 1);
   EXPECT_EQ(SBPHC.TicksLeft, 4);
 
   // Nothing x 2
-  StatsSystem.update(rogue::System::UpdateType::Tick);
-  StatsSystem.update(rogue::System::UpdateType::Tick);
+  tick(BuffSystem, StatsSystem);
+  tick(BuffSystem, StatsSystem);
 
   EXPECT_TRUE(Reg.any_of<rogue::StatsBuffComp>(Entity));
 }
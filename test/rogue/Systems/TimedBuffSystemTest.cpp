@@ -0,0 +1,70 @@
+#include <gtest/gtest.h>
+#include <rogue/Components/Buffs.h>
+#include <rogue/Components/Stats.h>
+#include <rogue/Systems/TimedBuffSystem.h>
+
+namespace {
+
+class TimedBuffSystemTest : public ::testing::Test {
+public:
+  void SetUp() override {
+    Reg = entt::registry();
+    Sys = std::make_shared<rogue::TimedBuffSystem>(Reg);
+    Et = Reg.create();
+  }
+
+  void tick(unsigned Count = 1) {
+    for (unsigned Idx = 0; Idx < Count; ++Idx) {
+      Sys->update(rogue::System::UpdateType::Tick);
+    }
+  }
+
+  entt::registry Reg;
+  std::shared_ptr<rogue::TimedBuffSystem> Sys = nullptr;
+  entt::entity Et = entt::null;
+};
+
+TEST_F(TimedBuffSystemTest, ExpireStaticBuffs) {
+  Reg.emplace<rogue::InvisibilityBuffComp>(Et).TicksLeft = 1;
+  Reg.emplace<rogue::BlindedDebuffComp>(Et).TicksLeft = 2;
+
+  Sys->update(rogue::System::UpdateType::NoTick);
+  EXPECT_EQ(Reg.get<rogue::InvisibilityBuffComp>(Et).TicksLeft, 1);
+
+  tick(2);
+  EXPECT_FALSE(Reg.any_of<rogue::InvisibilityBuffComp>(Et));
+  EXPECT_TRUE(Reg.any_of<rogue::BlindedDebuffComp>(Et));
+
+  tick();
+  EXPECT_FALSE(Reg.any_of<rogue::BlindedDebuffComp>(Et));
+}
+
+TEST_F(TimedBuffSystemTest, ValueGenBuff) {
+  auto &Health = Reg.emplace<rogue::HealthComp>(Et);
+  Health.Value = 10;
+  auto &Poison = Reg.emplace<rogue::PoisonDebuffComp>(Et);
+  Poison.init(/*TickAmount=*/2, /*Duration=*/4, /*TickPeriod=*/2);
+
+  tick();
+  EXPECT_EQ(Health.Value, 8);
+  tick(2);
+  EXPECT_EQ(Health.Value, 6);
+  tick();
+  EXPECT_TRUE(Reg.any_of<rogue::PoisonDebuffComp>(Et));
+  tick();
+  EXPECT_FALSE(Reg.any_of<rogue::PoisonDebuffComp>(Et));
+  EXPECT_EQ(Health.Value, 6);
+}
+
+TEST_F(TimedBuffSystemTest, KeepStatsBuffPerHit) {
+  auto &SBPHC = Reg.emplace<rogue::StatsBuffPerHitComp>(Et);
+  SBPHC.MaxStacks = 3;
+  SBPHC.TickPeriod = 1;
+  SBPHC.addStack();
+
+  tick(2);
+  ASSERT_TRUE(Reg.any_of<rogue::StatsBuffPerHitComp>(Et));
+  EXPECT_EQ(SBPHC.Stacks, 0);
+}
+
+} // namespace
@@ -0,0 +1,61 @@
+#include <gtest/gtest.h>
+#include <rogue/TimerWheel.h>
+
+namespace {
+
+std::vector<entt::entity> advance(rogue::TimerWheel &Timers, unsigned Ticks) {
+  std::vector<entt::entity> Fired;
+  for (unsigned Idx = 0; Idx < Ticks; ++Idx) {
+    const auto &TickFired = Timers.advance();
+    Fired.insert(Fired.end(), TickFired.begin(), TickFired.end());
+  }
+  return Fired;
+}
+
+TEST(TimerWheelTest, ScheduleAndCancel) {
+  const auto EtA = entt::entity(1);
+  const auto EtB = entt::entity(2);
+  rogue::TimerWheel Timers;
+  Timers.schedule(EtA, 0);
+  Timers.schedule(EtB, 3);
+  EXPECT_EQ(Timers.size(), 2);
+  EXPECT_EQ(Timers.getTicksLeft(EtB), 3);
+
+  EXPECT_EQ(advance(Timers, 1), std::vector<entt::entity>{EtA});
+  EXPECT_FALSE(Timers.isScheduled(EtA));
+  EXPECT_TRUE(advance(Timers, 1).empty());
+  EXPECT_EQ(advance(Timers, 1), std::vector<entt::entity>{EtB});
+
+  // Rescheduling replaces the timer, cancelled timers never fire
+  Timers.schedule(EtA, 2);
+  Timers.schedule(EtA, 5);
+  Timers.schedule(EtB, 1);
+  Timers.cancel(EtB);
+  EXPECT_EQ(Timers.size(), 1);
+  EXPECT_TRUE(advance(Timers, 4).empty());
+  EXPECT_EQ(advance(Timers, 1), std::vector<entt::entity>{EtA});
+  EXPECT_EQ(Timers.size(), 0);
+}
+
+TEST(TimerWheelTest, CascadeOuterWheels) {
+  // Delays crossing the rotations of the inner and outer wheels
+  const std::vector<rogue::TimerWheel::TickType> Delays = {
+      63, 64, 65, 4095, 4096, 4097, 300000, 300001};
+  rogue::TimerWheel Timers;
+  advance(Timers, 61);
+  for (std::size_t Idx = 0; Idx < Delays.size(); ++Idx) {
+    Timers.schedule(entt::entity(Idx), Delays[Idx]);
+  }
+
+  rogue::TimerWheel::TickType Elapsed = 0;
+  for (std::size_t Idx = 0; Idx < Delays.size(); ++Idx) {
+    const auto Ticks = static_cast<unsigned>(Delays[Idx] - Elapsed);
+    EXPECT_TRUE(advance(Timers, Ticks - 1).empty()) << "Delay " << Delays[Idx];
+    EXPECT_EQ(advance(Timers, 1), std::vector<entt::entity>{entt::entity(Idx)})
+        << "Delay " << Delays[Idx];
+    Elapsed = Delays[Idx];
+  }
+  EXPECT_EQ(Timers.size(), 0);
+}
+
+} // namespace
@@ -0,0 +1,97 @@
+#include <cxxg/Screen.h>
+#include <gtest/gtest.h>
+#include <rogue/UI/WindowContainer.h>
+#include <sstream>
+
+namespace {
+
+class CountingRect : public rogue::ui::BaseRect {
+public:
+  using BaseRect::BaseRect;
+
+  bool handleInput(int) override { return true; }
+
+  void draw(cxxg::Screen &Scr) const override {
+    BaseRect::draw(Scr);
+    Scr[Pos] << "draw" << NumDraws;
+    NumDraws++;
+  }
+
+  bool isCacheable() const override { return Cacheable; }
+
+  bool Cacheable = true;
+  mutable unsigned NumDraws = 0;
+};
+
+TEST(WindowContainerTest, CachedWindowIsRestored) {
+  std::stringstream SS;
+  cxxg::Screen Scr(cxxg::types::Size{20, 5}, SS, false);
+  rogue::ui::WindowContainer WC({0, 0}, {20, 5});
+  auto Wdw = std::make_shared<CountingRect>(cxxg::types::Position{1, 1},
+                                            cxxg::types::Size{8, 2});
+  WC.addWindow(Wdw);
+
+  WC.draw(Scr);
+  EXPECT_EQ(Wdw->NumDraws, 1);
+  EXPECT_EQ(Scr[1].getBuffer().substr(1, 8), "draw0   ");
+
+  // Not dirty, cells are restored from the cache
+  Scr.clear();
+  WC.draw(Scr);
+  EXPECT_EQ(Wdw->NumDraws, 1);
+  EXPECT_EQ(Scr[1].getBuffer().substr(1, 8), "draw0   ");
+
+  WC.invalidate();
+  WC.draw(Scr);
+  EXPECT_EQ(Wdw->NumDraws, 2);
+  EXPECT_EQ(Scr[1].getBuffer().substr(1, 8), "draw1   ");
+
+  // Moving the window invalidates the cache
+  Wdw->setPos({2, 1});
+  Scr.clear();
+  WC.draw(Scr);
+  EXPECT_EQ(Wdw->NumDraws, 3);
+  EXPECT_EQ(Scr[1].getBuffer().substr(2, 8), "draw2   ");
+}
+
+TEST(WindowContainerTest, OnlyCacheableWindowsAreCached) {
+  std::stringstream SS;
+  cxxg::Screen Scr(cxxg::types::Size{20, 5}, SS, false);
+  rogue::ui::WindowContainer WC({0, 0}, {20, 5});
+  auto Wdw = std::make_shared<CountingRect>(cxxg::types::Position{1, 1},
+                                            cxxg::types::Size{8, 2});
+  Wdw->Cacheable = false;
+  WC.addWindow(Wdw);
+
+  WC.draw(Scr);
+  WC.draw(Scr);
+  EXPECT_EQ(Wdw->NumDraws, 2);
+}
+
+TEST(WindowContainerTest, InputDoesNotInvalidateWindows) {
+  std::stringstream SS;
+  cxxg::Screen Scr(cxxg::types::Size{30, 5}, SS, false);
+  rogue::ui::WindowContainer WC({0, 0}, {30, 5});
+  auto Wdw1 = std::make_shared<CountingRect>(cxxg::types::Position{1, 1},
+                                             cxxg::types::Size{8, 2});
+  auto Wdw2 = std::make_shared<CountingRect>(cxxg::types::Position{12, 1},
+                                             cxxg::types::Size{8, 2});
+  WC.addWindow(Wdw1);
+  WC.addWindow(Wdw2);
+  WC.draw(Scr);
+  EXPECT_EQ(Wdw1->NumDraws, 1);
+  EXPECT_EQ(Wdw2->NumDraws, 1);
+
+  // Windows only redraw once they mark themselves dirty
+  WC.handleInput('x');
+  WC.draw(Scr);
+  EXPECT_EQ(Wdw1->NumDraws, 1);
+  EXPECT_EQ(Wdw2->NumDraws, 1);
+
+  Wdw1->markDirty();
+  WC.draw(Scr);
+  EXPECT_EQ(Wdw1->NumDraws, 2);
+  EXPECT_EQ(Wdw2->NumDraws, 1);
+}
+
+} // namespace
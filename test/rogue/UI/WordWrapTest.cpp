@@ -100,4 +100,39 @@ TEST(WordWrapTest, NewLineBeforeEndOfLine) {
   EXPECT_EQ(getLines(WW), Ref);
 }
 
-} // namespace
\ No newline at end of file
+TEST(WordWrapTest, SetLineWidth) {
+  rogue::ui::WordWrap WW("Hello to this World\nBye", 10);
+  LinesTy Ref = {"Hello to ", "this World", "Bye"};
+  EXPECT_EQ(getLines(WW), Ref);
+
+  WW.setLineWidth(20);
+  EXPECT_EQ(WW.getLineWidth(), 20);
+  Ref = {"Hello to this World", "Bye"};
+  EXPECT_EQ(getLines(WW), Ref);
+
+  WW.setLineWidth(10);
+  Ref = {"Hello to ", "this World", "Bye"};
+  EXPECT_EQ(getLines(WW), Ref);
+}
+
+TEST(WordWrapTest, CacheIsBounded) {
+  rogue::ui::WordWrap::clearCache();
+  rogue::ui::WordWrap WW("Cached text", 10);
+  rogue::ui::WordWrap WW2("Cached text", 10);
+  EXPECT_EQ(rogue::ui::WordWrap::getNumCachedTexts(), 1);
+
+  for (std::size_t Idx = 0; Idx < rogue::ui::WordWrap::MaxCachedTexts; ++Idx) {
+    rogue::ui::WordWrap("Text " + std::to_string(Idx), 10);
+  }
+  EXPECT_EQ(rogue::ui::WordWrap::getNumCachedTexts(),
+            rogue::ui::WordWrap::MaxCachedTexts);
+
+  // Layout of evicted text stays valid
+  LinesTy Ref = {"Cached ", "text"};
+  EXPECT_EQ(getLines(WW), Ref);
+  WW.setLineWidth(20);
+  Ref = {"Cached text"};
+  EXPECT_EQ(getLines(WW), Ref);
+}
+
+} // namespace